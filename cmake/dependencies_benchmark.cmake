@@ -0,0 +1,37 @@
+# (C) Copyright 2020, 2021, 2022, 2023, 2024 IBM. All Rights Reserved.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+
+list(APPEND CMAKE_MODULE_PATH ${PROJECT_SOURCE_DIR}/cmake/Modules)
+
+if(BUILD_BENCHMARK)
+  # the benchmark library passes std::string, so it needs the ABI of the RPU library
+  if(DEFINED OUTPUT_GNU_ABI AND NOT OUTPUT_GNU_ABI STREQUAL "")
+    set(GBenchmark_CXX_FLAGS "-D_GLIBCXX_USE_CXX11_ABI=${OUTPUT_GNU_ABI}")
+  endif()
+
+  include(ExternalProject)
+  ExternalProject_Add(GBenchmark
+    URL               https://github.com/google/benchmark/archive/refs/tags/v1.8.3.tar.gz
+    URL_HASH          SHA256=6bc180a57d23d4d9515519f92b0c83d61b05b5bab188961f36ac7b06b0d9e9ce
+    CMAKE_ARGS        "-DCMAKE_BUILD_TYPE=Release"
+                      "-DBENCHMARK_ENABLE_TESTING=OFF"
+                      "-DBENCHMARK_ENABLE_GTEST_TESTS=OFF"
+                      "-DCMAKE_CXX_FLAGS=${GBenchmark_CXX_FLAGS}"
+    INSTALL_COMMAND   ""
+  )
+
+  ExternalProject_Get_Property(GBenchmark source_dir)
+  ExternalProject_Get_Property(GBenchmark binary_dir)
+  set(GBenchmark_INCLUDE_DIR ${source_dir}/include)
+  set(GBenchmark_LIBRARY_DIR ${binary_dir}/src)
+
+  include_directories(SYSTEM ${GBenchmark_INCLUDE_DIR})
+  link_directories(SYSTEM ${GBenchmark_LIBRARY_DIR})
+endif()
@@ -35,6 +35,24 @@ PYBIND11_MODULE(aihwkit_extension, m) {
            Returns:
                y_output: fake casts tensor of the same size
            )pbdoc");
+  m_ops.def(
+      "float_precision_matmul", &aihwkit::floatPrecisionMatmul, py::arg("x_input"),
+      py::arg("weight"), py::arg("exponent"), py::arg("mantissa"), py::arg("saturate_to_inf"),
+      py::arg("cast_output") = true,
+      R"pbdoc(
+           matrix product x_input @ weight.T with both operands fake-cast to variable mantissa / exponent
+
+           Args:
+               x_input: input tensor [N, in_size]
+               weight: weight tensor [out_size, in_size]
+               exponent: number of bits used for the exponent
+               mantissa: number of bits used for the mantissa
+               saturate_to_inf: whether to set it to infinity if saturated or to perform clipping
+               cast_output: whether to also fake-cast the result
+
+           Returns:
+               y_output: result of size [N, out_size]
+           )pbdoc");
   m_ops.def(
       "thevenin_equiv", &aihwkit::theveninEquiv, py::arg("x_input"), py::arg("gp_values"),
       py::arg("gm_values"), py::arg("r_s"), py::arg("t_max"), py::arg("time_steps"),
@@ -52,4 +70,23 @@ PYBIND11_MODULE(aihwkit_extension, m) {
            Returns:
                y_output: [vth_rd, rht_3d]
            )pbdoc");
+  m_ops.def(
+      "thevenin_equiv_sum", &aihwkit::theveninEquivSum, py::arg("x_input"), py::arg("gp_values"),
+      py::arg("gm_values"), py::arg("r_s"), py::arg("t_max"), py::arg("time_steps"),
+      py::arg("v_read"),
+      R"pbdoc(
+           Fused version of ``thevenin_equiv`` returning the time summed output current
+
+           Args:
+               x_input: input tensor
+               gp_values: Positive conductance values (in muS)
+               gm_values: Negative conductance values (in muS)
+               r_s: Series resistance
+               t_max: max time (in x units)
+               time_steps: number of time steps
+               v_read: read voltage
+
+           Returns:
+               y_output: sum over time of (vth_3d - v_read) / rth_3d
+           )pbdoc");
 }
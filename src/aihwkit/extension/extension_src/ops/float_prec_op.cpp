@@ -12,6 +12,9 @@
 
 #include "float_prec_op.h"
 #include "float_prec_common.h"
+#include "utility_functions.h"
+#include <algorithm>
+#include <cstring>
 
 #define CHECK_CPU(x) TORCH_CHECK(x.device() == torch::kCPU, #x " must be a CPU tensor")
 #define CHECK_CONTIGUOUS(x) TORCH_CHECK(x.is_contiguous(), #x " must be contiguous")
@@ -19,56 +22,71 @@
 namespace aihwkit {
 namespace detail {
 
-template <int ML = 7> inline float precisionCastFloatExp8CPU(float v) {
-  uint32_t x_int = ((union {
-                     float f;
-                     uint32_t i;
-                   }){v})
-                       .i;
-
-  uint32_t highest_not_needed_bit = 1 << (22 - ML);
-  uint32_t needs_up_round = (x_int & highest_not_needed_bit);
-  uint32_t valid_msk = ~((highest_not_needed_bit << 1) - 1);
-  bool overflow_if = ((0x7F800000 & x_int) == 0x7F800000);
-  x_int &= valid_msk;
-  // set infty (with preserved sign) or round
-  x_int = overflow_if ? (x_int & (uint32_t)0xFF800000) : x_int + (needs_up_round << 1);
-
-  return ((union {
-           uint32_t i;
-           float f;
-         }){x_int})
-      .f;
-}
-
-template <int EL, int ML, bool saturate_to_inf, bool rounding = true>
-inline float precisionCastFloatCPU(float x) {
-  FLOATPREC_INIT(EL, ML);
-  FLOATPREC_BODY(x, y, saturate_to_inf, rounding);
-  return y;
+// elements per (cloned) SIMD kernel call and threshold for multithreading
+#define FPC_BLOCK_SIZE 4096
+#define FPC_OMP_THRESHOLD 65536
+// target rows of the casted GEMM operand block (kept in cache)
+#define FPC_GEMM_BLOCK_ELEMENTS 65536
+
+/* Compile the bit-manipulation kernel for AVX-512 and AVX2 (8 or 16
+   integer lanes) next to the default ISA and select at load time. */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define FPC_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define FPC_TARGET_CLONES
+#endif
+
+/* Branch-free version of FLOATPREC_BODY (with rounding) on the raw
+   bits, so that the loop vectorizes over integer lanes. Subnormals
+   are kept for the exp8 variant (which only saturates to inf). */
+FPC_TARGET_CLONES
+void floatPrecisionCastBlock(
+    const int N,
+    float *Y,
+    const float *X,
+    const int EL,
+    const int ML,
+    const bool saturate_to_inf) {
+
+  const uint32_t bias_el = (1 << (EL - 1)) - 1;
+  const int sat_el = (1 << EL) - 1;
+  const uint32_t sat_exp = (uint32_t)((sat_el + 127 - bias_el) << 23);
+  const uint32_t highest_not_needed_bit = 1 << (22 - ML);
+  const uint32_t valid_msk = ~((highest_not_needed_bit << 1) - 1);
+  const bool exp8 = EL == 8 && saturate_to_inf;
+
+  PRAGMA_SIMD
+  for (int i = 0; i < N; i++) {
+    uint32_t x_int;
+    std::memcpy(&x_int, X + i, sizeof(float));
+
+    uint32_t needs_up_round = (x_int & highest_not_needed_bit) << 1;
+    bool overflow_if = ((0x7F800000 & x_int) == 0x7F800000);
+    x_int &= valid_msk;
+    x_int = overflow_if ? (x_int & (uint32_t)0xFF800000) : x_int + needs_up_round;
+
+    if (!exp8) {
+      int f32_exp = (int)((x_int & (uint32_t)0x7F800000) >> 23) - 127 + (int)bias_el;
+      uint32_t x_sat = saturate_to_inf ? ((x_int | (uint32_t)0x7F800000) & (uint32_t)0xFF800000)
+                                       : (sat_exp | (x_int & ~((uint32_t)0x7F800000)));
+      x_int = f32_exp >= sat_el ? x_sat : x_int;
+      x_int = f32_exp <= 0 ? 0 : x_int;
+    }
+    std::memcpy(Y + i, &x_int, sizeof(float));
+  }
 }
 
 template <int EL, int ML>
 void floatPrecisionCastCPU(const int N, float *Y, const float *X, const bool saturate_to_inf) {
   static_assert(sizeof(float) == 4);
 
-  if (EL == 8 && saturate_to_inf) {
-    for (int i = 0; i < N; i++) {
-      float x = X[i];
-      Y[i] = precisionCastFloatExp8CPU<ML>(x);
-    }
-  } else {
-    if (saturate_to_inf) {
-      for (int i = 0; i < N; i++) {
-        float x = X[i];
-        Y[i] = precisionCastFloatCPU<EL, ML, true>(x);
-      }
-    } else {
-      for (int i = 0; i < N; i++) {
-        float x = X[i];
-        Y[i] = precisionCastFloatCPU<EL, ML, false>(x);
-      }
-    }
+  const int n_blocks = (N + FPC_BLOCK_SIZE - 1) / FPC_BLOCK_SIZE;
+
+#pragma omp parallel for schedule(static) if (N >= FPC_OMP_THRESHOLD)
+  for (int i_block = 0; i_block < n_blocks; i_block++) {
+    const int offset = i_block * FPC_BLOCK_SIZE;
+    floatPrecisionCastBlock(
+        std::min(FPC_BLOCK_SIZE, N - offset), Y + offset, X + offset, EL, ML, saturate_to_inf);
   }
 }
 
@@ -108,14 +126,12 @@ void floatPrecisionCastCPU(const int N, float *Y, const float *X, const bool sat
     break;                                                                                         \
   }
 
-} // namespace detail
-
-at::Tensor
-floatPrecisionCast(at::Tensor &x_input, int exponent, int mantissa, bool saturate_to_inf) {
-
-  CHECK_CONTIGUOUS(x_input);
-
-  torch::Tensor y_output = torch::empty_like(x_input);
+void floatPrecisionCastOut(
+    at::Tensor &y_output,
+    const at::Tensor &x_input,
+    int exponent,
+    int mantissa,
+    bool saturate_to_inf) {
 
   switch (mantissa) {
     DISPATCH_FPC(8);
@@ -141,6 +157,76 @@ floatPrecisionCast(at::Tensor &x_input, int exponent, int mantissa, bool saturat
   default:
     TORCH_CHECK(false, "Mantissa setting not possible.");
   }
+}
+
+} // namespace detail
+
+at::Tensor
+floatPrecisionCast(at::Tensor &x_input, int exponent, int mantissa, bool saturate_to_inf) {
+
+  CHECK_CONTIGUOUS(x_input);
+
+  torch::Tensor y_output = torch::empty_like(x_input);
+  detail::floatPrecisionCastOut(y_output, x_input, exponent, mantissa, saturate_to_inf);
+  return y_output;
+};
+
+at::Tensor floatPrecisionMatmul(
+    at::Tensor &x_input,
+    at::Tensor &weight,
+    int exponent,
+    int mantissa,
+    bool saturate_to_inf,
+    bool cast_output) {
+
+  CHECK_CONTIGUOUS(x_input);
+  CHECK_CONTIGUOUS(weight);
+
+  TORCH_CHECK(x_input.dim() == 2, " Input must be a 2D tensor.");
+  TORCH_CHECK(weight.dim() == 2, " Weight must be a 2D tensor.");
+  TORCH_CHECK(x_input.size(1) == weight.size(1), " Input dim and weight input dim should match.");
+  TORCH_CHECK(x_input.dtype() == torch::kFloat32, " Only float32 is supported.");
+  TORCH_CHECK(weight.dtype() == torch::kFloat32, " Only float32 is supported.");
+  TORCH_CHECK(x_input.device() == weight.device(), " Input and weight must be on the same device.");
+
+  int B = x_input.size(0);
+  int K = x_input.size(1);
+  int N = weight.size(0);
+
+  // weight is cast once while packing
+  torch::Tensor w_cast = torch::empty_like(weight);
+  detail::floatPrecisionCastOut(w_cast, weight, exponent, mantissa, saturate_to_inf);
+  torch::Tensor w_t = w_cast.t();
+
+  torch::Tensor y_output = torch::empty(at::IntArrayRef{B, N}, x_input.options());
+
+  if (x_input.device() != torch::kCPU) {
+    torch::Tensor x_cast = torch::empty_like(x_input);
+    detail::floatPrecisionCastOut(x_cast, x_input, exponent, mantissa, saturate_to_inf);
+    at::mm_out(y_output, x_cast, w_t);
+    if (cast_output) {
+      detail::floatPrecisionCastOut(y_output, y_output, exponent, mantissa, saturate_to_inf);
+    }
+    return y_output;
+  }
+
+  // cast the input and output in row blocks that stay in cache
+  // instead of extra passes over the full tensors
+  int block_rows = std::max(1, std::min(B, FPC_GEMM_BLOCK_ELEMENTS / std::max(K, 1)));
+  torch::Tensor x_block = torch::empty(at::IntArrayRef{block_rows, K}, x_input.options());
+
+  for (int b0 = 0; b0 < B; b0 += block_rows) {
+    int n_rows = std::min(block_rows, B - b0);
+    torch::Tensor x_cast = x_block.narrow(0, 0, n_rows);
+    torch::Tensor y_block = y_output.narrow(0, b0, n_rows);
+
+    detail::floatPrecisionCastOut(
+        x_cast, x_input.narrow(0, b0, n_rows), exponent, mantissa, saturate_to_inf);
+    at::mm_out(y_block, x_cast, w_t);
+    if (cast_output) {
+      detail::floatPrecisionCastOut(y_block, y_block, exponent, mantissa, saturate_to_inf);
+    }
+  }
   return y_output;
 };
 
@@ -148,3 +234,7 @@ floatPrecisionCast(at::Tensor &x_input, int exponent, int mantissa, bool saturat
 
 #undef DISPATCH_FPC
 #undef DISPATCH_FPC2
+#undef FPC_TARGET_CLONES
+#undef FPC_GEMM_BLOCK_ELEMENTS
+#undef FPC_OMP_THRESHOLD
+#undef FPC_BLOCK_SIZE
@@ -32,4 +32,14 @@ void floatPrecisionCastCPU(const int N, float *Y, const float *X, const bool sat
 at::Tensor
 floatPrecisionCast(at::Tensor &x_input, int exponent, int mantissa, bool saturate_to_inf);
 
+/* emulates a low precision GEMM x_input @ weight^T, where both
+   operands (and optionally the output) are cast while packing */
+at::Tensor floatPrecisionMatmul(
+    at::Tensor &x_input,
+    at::Tensor &weight,
+    int exponent,
+    int mantissa,
+    bool saturate_to_inf,
+    bool cast_output);
+
 } // namespace aihwkit
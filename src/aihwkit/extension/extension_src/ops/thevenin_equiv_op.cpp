@@ -12,6 +12,9 @@
 
 #include "thevenin_equiv_op.h"
 #include "utility_functions.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #define CHECK_CPU(x) TORCH_CHECK(x.device() == torch::kCPU, #x " must be a CPU tensor")
 #define CHECK_CONTIGUOUS(x) TORCH_CHECK(x.is_contiguous(), #x " must be contiguous")
@@ -19,6 +22,71 @@
 namespace aihwkit {
 namespace detail {
 
+/* Accumulates the Thevenin equivalents of one output row (all N
+   inputs) for all U time steps into vth and rth. For a given input
+   the unit cell is either driven (t < |x|) or at zero (t >= |x|), so
+   the time steps split into two ranges with constant conductances. */
+template <typename T>
+inline void theveninEquivRow(
+    const int N,
+    const int U,
+    T *vth,
+    T *rth,
+    const T *x,
+    const T *gp,
+    const T *gm,
+    const T x_scale,
+    const T rw_segs) {
+
+  const T eps = 1e-12;
+
+  for (int s = 0; s < N; s++) {
+    const T x_s = x[s] * x_scale;
+    const T x_abs = std::abs(x_s);
+    // number of time steps t with |x| > t
+    const int n_driven = x_abs > (T)0.0 ? (int)std::min((T)U, std::ceil(x_abs)) : 0;
+
+    const T sum_g = gp[s] + gm[s];
+    const T gth = sum_g + eps;
+    // 0.6 * g_pp + 0.2 * g_mm for driven and 0.4 * g_zz for zero input
+    const T num_driven = x_s > (T)0.0 ? (T)0.6 * gp[s] + (T)0.2 * gm[s]
+                                      : (T)0.6 * gm[s] + (T)0.2 * gp[s];
+    const T num_zero = (T)0.4 * sum_g;
+
+    if (s == 0) {
+      const T rth_s = (T)1.0 / gth;
+      PRAGMA_SIMD
+      for (int t = 0; t < U; t++) {
+        rth[t] = rth_s;
+        vth[t] = (t < n_driven ? num_driven : num_zero) * rth_s;
+      }
+      continue;
+    }
+
+    // parallel of (rth + rw_segs) and 1 / gth:
+    //   rth' = r_1 / (1 + r_1 * gth),  vth' = (vth + num * r_1) / (1 + r_1 * gth)
+    PRAGMA_SIMD
+    for (int t = 0; t < n_driven; t++) {
+      T r_1 = rth[t] + rw_segs;
+      T inv = (T)1.0 / ((T)1.0 + r_1 * gth);
+      vth[t] = (vth[t] + num_driven * r_1) * inv;
+      rth[t] = r_1 * inv;
+    }
+    PRAGMA_SIMD
+    for (int t = n_driven; t < U; t++) {
+      T r_1 = rth[t] + rw_segs;
+      T inv = (T)1.0 / ((T)1.0 + r_1 * gth);
+      vth[t] = (vth[t] + num_zero * r_1) * inv;
+      rth[t] = r_1 * inv;
+    }
+  }
+
+  PRAGMA_SIMD
+  for (int t = 0; t < U; t++) {
+    rth[t] += (T)0.5 * rw_segs;
+  }
+}
+
 template <typename T>
 void theveninEquivCPU(
     const int B,
@@ -37,48 +105,61 @@ void theveninEquivCPU(
   // G is M x N
   // output is B x M x U
 
-  const T eps = 1e-12;
   const T seg_rows = 1; // fixed to 1
   const T rw_segs = (T)1e-6 * r_s * seg_rows;
+  const T x_scale = (T)(U - 1) / tmax;
 
+  // rows are independent: accumulate each in the output directly
+#pragma omp parallel for collapse(2) schedule(static)
   for (int b = 0; b < B; b++) {
     for (int i = 0; i < M; i++) {
+      const size_t base_idx = ((size_t)b * M + i) * U;
+      theveninEquivRow<T>(
+          N, U, vth_3d + base_idx, rth_3d + base_idx, X + (size_t)b * N, Gp + (size_t)i * N,
+          Gm + (size_t)i * N, x_scale, rw_segs);
+    }
+  }
+}
+
+template <typename T>
+void theveninEquivSumCPU(
+    const int B,
+    const int M,
+    const int N,
+    const int U,
+    T *i_out,
+    const T *X,
+    const T *Gp,
+    const T *Gm,
+    T tmax,
+    T r_s,
+    T v_read) {
+
+  // output is B x M: sum_t (vth - v_read) / rth
 
-      const int base_idx = b * (U * M) + U * i;
+  const T seg_rows = 1; // fixed to 1
+  const T rw_segs = (T)1e-6 * r_s * seg_rows;
+  const T x_scale = (T)(U - 1) / tmax;
 
-      for (int s = 0; s < N; s++) {
-        T gm = Gm[N * i + s];
-        T gp = Gp[N * i + s];
-        T sum_g = gp + gm;
+#pragma omp parallel
+  {
+    // per thread accumulators (kept in L1)
+    std::vector<T> vth(U);
+    std::vector<T> rth(U);
 
-        T x = X[b * N + s] / tmax * (T)(U - 1);
-        T x_abs = std::abs(x);
+#pragma omp for collapse(2) schedule(static)
+    for (int b = 0; b < B; b++) {
+      for (int i = 0; i < M; i++) {
+        theveninEquivRow<T>(
+            N, U, vth.data(), rth.data(), X + (size_t)b * N, Gp + (size_t)i * N,
+            Gm + (size_t)i * N, x_scale, rw_segs);
 
+        T sum = 0.0;
+        PRAGMA_SIMD
         for (int t = 0; t < U; t++) {
-          int idx = base_idx + t;
-
-          T gth_pp = ((x > (T)t) ? gp : (T)0.0) + ((x < -((T)t)) ? gm : (T)0.0);
-          T gth_mm = ((x > (T)t) ? gm : (T)0.0) + ((x < -((T)t)) ? gp : (T)0.0);
-          T gth_zz = (x_abs <= (T)t) ? sum_g : (T)0.0;
-
-          T gth = gth_pp + gth_mm + gth_zz + eps;
-          T rth = (T)1.0 / gth;
-          T vth = ((T)0.6 * gth_pp + (T)0.2 * gth_mm + (T)0.4 * gth_zz) * rth;
-
-          if (s == 0) {
-            vth_3d[idx] = vth;
-            rth_3d[idx] = rth;
-          } else {
-            T r_1 = rth_3d[idx] + rw_segs;
-            T r_2 = rth;
-
-            rth_3d[idx] = (r_1 * r_2) / (r_1 + r_2);
-            vth_3d[idx] = (vth_3d[idx] / r_1 + vth / r_2) * rth_3d[idx];
-          }
-          if (s == N - 1) {
-            rth_3d[idx] += 0.5 * rw_segs;
-          }
+          sum += (vth[t] - v_read) / rth[t];
         }
+        i_out[(size_t)b * M + i] = sum;
       }
     }
   }
@@ -109,6 +190,31 @@ template void theveninEquivCPU(
     double,
     double);
 
+template void theveninEquivSumCPU(
+    const int,
+    const int,
+    const int,
+    const int,
+    float *,
+    const float *,
+    const float *,
+    const float *,
+    float,
+    float,
+    float);
+template void theveninEquivSumCPU(
+    const int,
+    const int,
+    const int,
+    const int,
+    double *,
+    const double *,
+    const double *,
+    const double *,
+    double,
+    double,
+    double);
+
 } // namespace detail
 
 #define DISPATCH_THV(TYPE)                                                                         \
@@ -164,8 +270,63 @@ at::Tensor theveninEquiv(
   return y_output;
 };
 
+#define DISPATCH_THV_SUM(TYPE)                                                                     \
+  if (x_input.device() != torch::kCPU) {                                                           \
+    torch::Tensor thv = torch::zeros(at::IntArrayRef{2, B, M, U}, x_input.options());              \
+    detail::theveninEquivCUDA<TYPE>(                                                               \
+        B, M, N, U, thv.template data_ptr<TYPE>(), thv.template data_ptr<TYPE>() + B * M * U,      \
+        x_input.template data_ptr<TYPE>(), gp_values.template data_ptr<TYPE>(),                    \
+        gm_values.template data_ptr<TYPE>(), t_max, r_s);                                          \
+    y_output = ((thv[0] - v_read) / thv[1]).sum(2);                                                \
+  } else {                                                                                         \
+    CHECK_CPU(x_input);                                                                            \
+    detail::theveninEquivSumCPU<TYPE>(                                                             \
+        B, M, N, U, y_output.template data_ptr<TYPE>(), x_input.template data_ptr<TYPE>(),         \
+        gp_values.template data_ptr<TYPE>(), gm_values.template data_ptr<TYPE>(), t_max, r_s,      \
+        v_read);                                                                                   \
+  }
+
+at::Tensor theveninEquivSum(
+    at::Tensor &x_input,
+    at::Tensor &gp_values,
+    at::Tensor &gm_values,
+    float r_s,
+    float t_max,
+    int time_steps,
+    float v_read) {
+
+  CHECK_CONTIGUOUS(x_input);
+  CHECK_CONTIGUOUS(gm_values);
+  CHECK_CONTIGUOUS(gp_values);
+
+  TORCH_CHECK(x_input.dim() == 2, " Input must be a 2D tensor.");
+  TORCH_CHECK(gm_values.dim() == 2, " Gm must be a 2D tensor.");
+  TORCH_CHECK(gp_values.dim() == 2, " Gp must be a 2D tensor.");
+  TORCH_CHECK(gp_values.size(1) == gm_values.size(1), " Gp and Gm must be of same shape.");
+  TORCH_CHECK(gp_values.size(0) == gm_values.size(0), " Gp and Gm must be of same shape.");
+  TORCH_CHECK(x_input.size(1) == gm_values.size(1), " Input dim and Gp input dim should match.");
+
+  int B = x_input.size(0);
+  int N = x_input.size(1);
+  int M = gp_values.size(0);
+  int U = time_steps;
+
+  // output is the time summed current B x M
+  torch::Tensor y_output = torch::empty(at::IntArrayRef{B, M}, x_input.options());
+  if (x_input.dtype() == torch::kFloat32) {
+    DISPATCH_THV_SUM(float);
+  } else if (x_input.dtype() == torch::kDouble) {
+    DISPATCH_THV_SUM(double);
+  } else {
+    TORCH_CHECK(false, "Data-type not supported");
+  }
+
+  return y_output;
+};
+
 } // namespace aihwkit
 
+#undef DISPATCH_THV_SUM
 #undef DISPATCH_THV
 #undef CHECK_CPU
 #undef CHECK_CONTIGUOUS
@@ -49,6 +49,20 @@ void theveninEquivCPU(
     T tmax,
     T r_s);
 
+template <typename T>
+void theveninEquivSumCPU(
+    const int B,
+    const int M,
+    const int N,
+    const int U,
+    T *i_out,
+    const T *X,
+    const T *Gp,
+    const T *Gm,
+    T tmax,
+    T r_s,
+    T v_read);
+
 } // namespace detail
 
 at::Tensor theveninEquiv(
@@ -58,4 +72,15 @@ at::Tensor theveninEquiv(
     float r_s,
     float t_max,
     int time_steps);
+
+/* fused version that returns the time summed output current of
+   (vth - v_read) / rth [B x M] without the B x M x U intermediates */
+at::Tensor theveninEquivSum(
+    at::Tensor &x_input,
+    at::Tensor &gp_values,
+    at::Tensor &gm_values,
+    float r_s,
+    float t_max,
+    int time_steps,
+    float v_read);
 } // namespace aihwkit
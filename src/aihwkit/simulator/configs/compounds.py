@@ -459,6 +459,19 @@ class TransferCompound(UnitCell):
     default).
     """
 
+    transfer_batched: bool = False
+    """Whether to read all ``n_reads_per_transfer`` columns or rows of a
+    transfer event in one batched (matrix) forward or backward pass.
+
+    All vectors are read before any reset (``with_reset_prob``) of the
+    source device and before any write to the target device. This
+    differs from the default sequential read, reset and write of each
+    vector and is only statistically equivalent to it.
+
+    Note:
+        Only used for the ``TransferCompound`` on CPU.
+    """
+
     fast_lr: float = 1.0
     """Whether to set the `fast` tile's learning rate.
 
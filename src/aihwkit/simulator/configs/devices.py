@@ -283,6 +283,18 @@ class PulsedDevice(_PrintableMixin):
     Pulses can be obtained by ``analog_tile.tile.get_pulse_counters()``
     """
 
+    dense_update_noise_approx: bool = False
+    r"""Whether to approximate the cycle-to-cycle noise of coincident pulses.
+
+    In the dense (coincidence) update, the ``N`` pulses that hit the same
+    cross-point are applied at once in closed form for devices that
+    support it (e.g. constant step, linear step, soft bounds). Without
+    cycle-to-cycle noise this is exact. With noise, the ``N`` noisy
+    steps are only summarized into a single Gaussian (with
+    :math:`\sqrt{N}` scaled std) if this flag is set, otherwise the
+    pulses are applied one by one.
+    """
+
     def as_bindings(self, data_type: RPUDataType) -> Any:
         """Return a representation of this instance as a simulator bindings object."""
         return parameters_to_bindings(self, data_type)
@@ -864,6 +876,16 @@ class ExpStepDevice(PulsedDevice):
     dw_min_std_slope: float = 0.0
     """ cycle-to-cycle noise of the update size (in units of ``dw_min_std``, see above)."""
 
+    lut_size: int = 0
+    """Resolution of the tabulated step response (if larger than 0).
+
+    If set, the exponential step response is not evaluated for each
+    pulse but linearly interpolated from a table with ``lut_size``
+    sections over the relative weight positions of the tile. This
+    speeds up the update at the expense of an interpolation error.
+    Only for CPU tiles.
+    """
+
     write_noise_std: float = 0.0
     r"""Whether to use update write noise.
 
@@ -986,6 +1008,16 @@ class PowStepDevice(PulsedDevice):
     In units of ``pow_gamma``.
     """
 
+    pow_lut_size: int = 0
+    r"""Resolution of the tabulated step response (if larger than 0).
+
+    If set, :math:`(x)^\gamma` is not evaluated for each pulse but
+    interpolated (bi-linearly) from a table with ``pow_lut_size``
+    sections of the normalized weight position and of the range of
+    :math:`\gamma` values of the tile. This speeds up the update at
+    the expense of an interpolation error. Only for CPU tiles.
+    """
+
     write_noise_std: float = 0.0
     r"""Whether to use update write noise.
 
@@ -1125,6 +1157,16 @@ class PowStepReferenceDevice(PulsedDevice):
     In units of ``pow_gamma``.
     """
 
+    pow_lut_size: int = 0
+    r"""Resolution of the tabulated step response (if larger than 0).
+
+    If set, :math:`(x)^\gamma` is not evaluated for each pulse but
+    interpolated (bi-linearly) from a table with ``pow_lut_size``
+    sections of the normalized weight position and of the range of
+    :math:`\gamma` values of the tile. This speeds up the update at
+    the expense of an interpolation error. Only for CPU tiles.
+    """
+
     subtract_symmetry_point: bool = False
     r"""Whether store the symmetry point of each device onto the reference device.
 
@@ -145,6 +145,24 @@ class WeightModifierParameter(_PrintableMixin):
     pcm_t0: float = 20.0
     r"""PCM_NOISE parameter,  programming conversion time in seconds. """
 
+    cache_refresh_every: int = 0
+    """Reuse the modified weights across forward passes.
+
+    If non-zero, the modified weights are only re-computed if the
+    weights have been changed (e.g. by an update, ``set_weights``,
+    decay or drift) since the last modification, or if the modifier
+    parameters changed. Types without randomness (e.g. ``DISCRETIZE``,
+    ``DOREFA`` without ``sto_round`` or ``POLY`` with zero
+    ``std_dev``) are kept until then, whereas noisy types are
+    additionally re-drawn at the latest after ``cache_refresh_every``
+    calls.
+
+    Caution:
+        Direct changes to the weights that bypass the tile (e.g. when
+        using shared weights) are not detected. Only supported by the
+        RPU CPU tiles, otherwise it is ignored.
+    """
+
 
 @dataclass
 class WeightClipParameter(_PrintableMixin):
@@ -237,6 +237,26 @@ class IOParameters(_PrintableMixin):
 
     bm_test_negative_bound: bool = True
 
+    bm_rescale_analog: bool = False
+    """Whether to re-derive the bound management rounds from the first pass.
+
+    If enabled, the analog result before the ADC of the first pass is
+    kept and the outputs of the following bound management rounds are
+    computed by rescaling it to the reduced input scale (and applying
+    the output non-linearity, noise, bound and discretization again)
+    instead of recomputing the full analog matrix-vector product. The
+    output noise is not re-drawn, and the input noise and input
+    discretization are rescaled with the signal.
+
+    Note:
+        Only available on CPU and for ``mv_type``
+        ``AnalogMVType.ONE_PASS`` and
+        ``AnalogMVType.POS_NEG_SEPARATE``. It is not used when the
+        first pass clips the inputs or when ``ir_drop`` or
+        ``r_series`` is used, since then the analog result does not
+        scale with the inputs.
+    """
+
     nm_thres: float = 0.0
     r"""Constant noise management value for ``type`` ``Constant``.
 
@@ -63,3 +63,16 @@ class RuntimeParameter(_PrintableMixin):
     Note:
        Only for in case tiles are simulated with RPUCuda library.
     """
+
+    binary_extra_state: bool = False
+    """Whether to store the extra (internal) tile state in the compact
+    binary format when pickling.
+
+    The binary state is stored under a separate key and is much faster
+    to save and load for large compound tiles.
+
+    Caution:
+       Checkpoints saved with this option turned on cannot be fully
+       restored by aihwkit versions without the binary extra state
+       (the extra state is then silently skipped).
+    """
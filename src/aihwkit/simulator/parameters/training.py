@@ -93,6 +93,30 @@ class UpdateParameters(_PrintableMixin):
     """Whether to compute gradient sparsity.
     """
 
+    parallel_update: bool = False
+    """Whether to split the pulsed update into row blocks that are updated
+    concurrently (CPU only).
+
+    Only used for devices where the update of one row is independent of
+    the other rows (not the compound devices). Each row block draws from
+    its own random number substream, so results differ from the serial
+    update, but are statistically equivalent.
+
+    Note:
+        The number of threads is given by OpenMP (e.g. ``OMP_NUM_THREADS``).
+    """
+
+    row_bucketed_update: bool = False
+    """Whether to apply the sparse pulses row by row (CPU only).
+
+    The pulses of all bit line positions are first sorted by row, so
+    that each weight row is loaded once per update and receives all its
+    pulses in order. Only used for the sparse pulse types and devices
+    where the update of one row is independent of the other rows.
+    Results are statistically equivalent to the default schedule (only
+    the order of the random numbers drawn differs).
+    """
+
     sto_round: bool = False
     """Whether to enable stochastic rounding."""
 
@@ -45,6 +45,48 @@ public:
 } // namespace pybind11
 #endif
 
+/* State values are exchanged with python as lists of floats (legacy
+   dump_extra / load_extra). The binary state format is used for
+   dump_extra_binary / load_extra_binary instead. */
+namespace pybind11 {
+namespace detail {
+template <> struct type_caster<RPU::StateValue> {
+public:
+  PYBIND11_TYPE_CASTER(RPU::StateValue, _("List[float]"));
+
+  bool load(handle src, bool convert) {
+    make_caster<std::vector<double>> caster;
+    if (!caster.load(src, convert)) {
+      return false;
+    }
+    value = RPU::StateValue(cast_op<std::vector<double> &&>(std::move(caster)));
+    return true;
+  }
+  static handle cast(const RPU::StateValue &src, return_value_policy policy, handle parent) {
+    return make_caster<std::vector<double>>::cast(src.toDouble(), policy, parent);
+  }
+};
+} // namespace detail
+} // namespace pybind11
+
+/* Returns the state in the binary format as python bytes (written in place)*/
+inline py::bytes state_to_bytes(const RPU::state_t &state) {
+  size_t size = RPU::getStateBinarySize(state);
+  PyObject *obj = PyBytes_FromStringAndSize(nullptr, (Py_ssize_t)size);
+  if (obj == nullptr) {
+    throw py::error_already_set();
+  }
+  RPU::writeStateBinary(state, PyBytes_AS_STRING(obj), size);
+  return py::reinterpret_steal<py::bytes>(obj);
+}
+
+/* Views the binary state of any (contiguous) python buffer without copy. The
+   buffer needs to be kept alive while the returned state is used. */
+inline RPU::state_t state_from_buffer(const py::buffer &buffer) {
+  py::buffer_info info = buffer.request();
+  return RPU::viewStateBinary((const char *)info.ptr, (size_t)(info.size * info.itemsize));
+}
+
 #if RPU_USE_FP16
 #define DEFAULT_DTYPE                                                                              \
   ((std::is_same<half_t, T_RPU>::value)                                                            \
@@ -483,6 +483,9 @@ template <typename T> void declare_rpu_devices(py::module &m, std::string type_n
       .def_readwrite("um_reg_scale", &RPU::PulsedUpdateMetaParameter<T>::um_reg_scale)
       .def_readwrite("um_grad_scale", &RPU::PulsedUpdateMetaParameter<T>::um_grad_scale)
       .def_readwrite("d_sparsity", &RPU::PulsedUpdateMetaParameter<T>::d_sparsity)
+      .def_readwrite("parallel_update", &RPU::PulsedUpdateMetaParameter<T>::parallel_update)
+      .def_readwrite(
+          "row_bucketed_update", &RPU::PulsedUpdateMetaParameter<T>::row_bucketed_update)
       .def_readwrite("update_management", &RPU::PulsedUpdateMetaParameter<T>::update_management)
       .def_readwrite(
           "update_bl_management", &RPU::PulsedUpdateMetaParameter<T>::update_bl_management)
@@ -492,6 +495,7 @@ template <typename T> void declare_rpu_devices(py::module &m, std::string type_n
       .def(py::init<>())
       .def_readwrite("bm_test_negative_bound", &RPU::IOMetaParameter<T>::bm_test_negative_bound)
       .def_readwrite("bound_management", &RPU::IOMetaParameter<T>::bound_management)
+      .def_readwrite("bm_rescale_analog", &RPU::IOMetaParameter<T>::bm_rescale_analog)
       .def_readwrite("inp_bound", &RPU::IOMetaParameter<T>::inp_bound)
       .def_readwrite("inp_noise", &RPU::IOMetaParameter<T>::inp_noise)
       .def_readwrite("inp_res", &RPU::IOMetaParameter<T>::inp_res)
@@ -580,6 +584,7 @@ template <typename T> void declare_rpu_devices(py::module &m, std::string type_n
       .def_readwrite("w_min", &PulsedParam::w_min)
       .def_readwrite("w_min_dtod", &PulsedParam::w_min_dtod)
       .def_readwrite("count_pulses", &PulsedParam::count_pulses)
+      .def_readwrite("dense_update_noise_approx", &PulsedParam::dense_update_noise_approx)
       .def("__str__", [](PulsedParam &self) {
         std::stringstream ss;
         self.printToStream(ss);
@@ -673,6 +678,7 @@ template <typename T> void declare_rpu_devices(py::module &m, std::string type_n
       .def_readwrite("apply_write_noise_on_set", &ExpStepParam::apply_write_noise_on_set)
       .def_readwrite("dw_min_std_add", &ExpStepParam::dw_min_std_add)
       .def_readwrite("dw_min_std_slope", &ExpStepParam::dw_min_std_slope)
+      .def_readwrite("lut_size", &ExpStepParam::es_lut_size)
       .def(
           "__str__",
           [](ExpStepParam &self) {
@@ -757,6 +763,7 @@ template <typename T> void declare_rpu_devices(py::module &m, std::string type_n
       .def_readwrite("n_reads_per_transfer", &TransferParam::n_reads_per_transfer)
       .def_readwrite("with_reset_prob", &TransferParam::with_reset_prob)
       .def_readwrite("random_selection", &TransferParam::random_selection)
+      .def_readwrite("transfer_batched", &TransferParam::transfer_batched)
       .def_readwrite("transfer_columns", &TransferParam::transfer_columns)
       .def_readwrite("transfer_lr", &TransferParam::transfer_lr)
       .def_readwrite("fast_lr", &TransferParam::fast_lr)
@@ -814,6 +821,7 @@ template <typename T> void declare_rpu_devices(py::module &m, std::string type_n
       .def_readwrite("pow_gamma_dtod", &PowStepParam::ps_gamma_dtod)
       .def_readwrite("pow_up_down", &PowStepParam::ps_gamma_up_down)
       .def_readwrite("pow_up_down_dtod", &PowStepParam::ps_gamma_up_down_dtod)
+      .def_readwrite("pow_lut_size", &PowStepParam::ps_lut_size)
       .def_readwrite("write_noise_std", &PowStepParam::write_noise_std)
       .def_readwrite("apply_write_noise_on_set", &PowStepParam::apply_write_noise_on_set)
       .def(
@@ -839,6 +847,7 @@ template <typename T> void declare_rpu_devices(py::module &m, std::string type_n
       .def_readwrite("pow_gamma_dtod", &PowStepReferenceParam::ps_gamma_dtod)
       .def_readwrite("pow_up_down", &PowStepReferenceParam::ps_gamma_up_down)
       .def_readwrite("pow_up_down_dtod", &PowStepReferenceParam::ps_gamma_up_down_dtod)
+      .def_readwrite("pow_lut_size", &PowStepReferenceParam::ps_lut_size)
       .def_readwrite("reference_std", &PowStepReferenceParam::reference_std)
       .def_readwrite("reference_mean", &PowStepReferenceParam::reference_mean)
       .def_readwrite("subtract_symmetry_point", &PowStepReferenceParam::subtract_symmetry_point)
@@ -17,6 +17,11 @@
 #include "weight_clipper.h"
 #include "weight_modifier.h"
 #include "weight_remapper.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
 
 #define CHECK_CPU(x) TORCH_CHECK(x.device() == torch::kCPU, #x " must be a CPU tensor")
 #define CHECK_CONTIGUOUS(x) TORCH_CHECK(x.is_contiguous(), #x " must be contiguous")
@@ -29,6 +34,82 @@
 
 #define NAME(S) (S + type_name_add).c_str()
 
+/* Validates the forward input and builds the output tensor. */
+template <typename T, typename T_RPU>
+torch::Tensor make_forward_output(
+    RPU::RPUSimple<T_RPU> &self,
+    const torch::Tensor &x_input,
+    bool bias,
+    bool x_trans,
+    bool d_trans,
+    int &m_batch) {
+  CHECK_TORCH_INPUT(x_input);
+
+  if (x_input.dim() < 1) {
+    throw std::runtime_error("Invalid x_input dimensions: expected at least 1 dimensional tensor");
+  }
+  int in_size = x_trans ? x_input.size(0) : x_input.size(-1);
+  int expected_in_size = self.getXSize() - (bias ? 1 : 0);
+  int out_size = self.getDSize();
+  m_batch = x_input.numel() / in_size;
+
+  // Validate the x_input dimensions.
+  if (in_size != expected_in_size) {
+    std::string shape_str = x_trans ? ("[*, " + std::to_string(expected_in_size) + "]")
+                                    : ("[" + std::to_string(expected_in_size) + ",*]");
+    throw std::runtime_error("Invalid x_input dimensions: expected " + shape_str + " tensor");
+  }
+
+  // Build the buffers.
+  std::vector<int64_t> dims(x_input.sizes().begin(), x_input.sizes().end());
+  if (d_trans) {
+    dims[0] = out_size;
+  } else {
+    dims[dims.size() - 1] = out_size;
+  }
+  return torch::empty(dims, x_input.options());
+}
+
+/* Runs job(0) ... job(n_jobs - 1) on n_threads worker threads. The
+   first exception thrown by a job is re-thrown after all workers
+   finished. Needs to be called without GIL. */
+inline void run_jobs_threaded(int n_jobs, int n_threads, const std::function<void(int)> &job) {
+  if (n_threads <= 0) {
+    n_threads = (int)std::thread::hardware_concurrency();
+  }
+  n_threads = MAX(MIN(n_threads, n_jobs), 1);
+
+  std::atomic<int> next_job(0);
+  std::exception_ptr error = nullptr;
+  std::mutex error_mutex;
+
+  auto worker = [&]() {
+    int i_job;
+    while ((i_job = next_job++) < n_jobs) {
+      try {
+        job(i_job);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < n_threads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 template <typename T, typename T_RPU>
 void declare_rpu_tiles(py::module &m, std::string type_name_add) {
   using Class = RPU::RPUSimple<T_RPU>;
@@ -54,6 +135,8 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
       .def_readwrite("pcm_prob_at_gmax", &RPU::WeightModifierParameter<T_RPU>::pcm_prob_at_gmax)
       .def_readwrite("pcm_prob_at_random", &RPU::WeightModifierParameter<T_RPU>::pcm_prob_at_random)
       .def_readwrite("pcm_t0", &RPU::WeightModifierParameter<T_RPU>::pcm_t0)
+      .def_readwrite(
+          "cache_refresh_every", &RPU::WeightModifierParameter<T_RPU>::cache_refresh_every)
       .def_readwrite("g_max", &RPU::WeightModifierParameter<T_RPU>::g_max);
 
   py::class_<Class>(
@@ -117,6 +200,39 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
            Args:
                strict: Whether to throw a runtime error when a field is not found. 
            )pbdoc")
+      .def(
+          "dump_extra_binary",
+          [](Class &self) {
+            RPU::state_t state;
+            self.dumpExtra(state, "rpu");
+            return state_to_bytes(state);
+          },
+          R"pbdoc(
+           Return the additional state variables in a compact binary format.
+
+           In contrast to ``dump_extra``, all variables are kept in
+           their native data type in aligned contiguous blocks.
+
+           Returns:
+               bytes: binary state to be used with ``load_extra_binary``
+           )pbdoc")
+      .def(
+          "load_extra_binary",
+          [](Class &self, py::buffer buffer, bool strict) {
+            auto state = state_from_buffer(buffer);
+            self.loadExtra(state, "rpu", strict);
+          },
+          py::arg("buffer"), py::arg("strict"),
+          R"pbdoc(
+           Load the binary state generated by dump_extra_binary.
+
+           The data is read directly from the given buffer (e.g. ``bytes``
+           or a memory-mapped file) without intermediate copies.
+
+           Args:
+               buffer: binary state
+               strict: Whether to throw a runtime error when a field is not found.
+           )pbdoc")
       .def(
           "set_verbosity_level", [](Class &self, int verbose) { self.setVerbosityLevel(verbose); },
           py::arg("verbose"),
@@ -413,35 +529,12 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
           [](Class &self, const torch::Tensor &x_input_, bool bias = false, bool x_trans = false,
              bool d_trans = false, bool is_test = false, bool non_blocking = false) {
             auto x_input = x_input_.contiguous();
-            CHECK_TORCH_INPUT(x_input);
+            int m_batch = 0;
+            torch::Tensor d_output =
+                make_forward_output<T, T_RPU>(self, x_input, bias, x_trans, d_trans, m_batch);
 
-            if (x_input.dim() < 1) {
-              throw std::runtime_error(
-                  "Invalid x_input dimensions: expected at least 1 dimensional tensor");
-            }
-            int in_size = x_trans ? x_input.size(0) : x_input.size(-1);
-            int expected_in_size = self.getXSize() - (bias ? 1 : 0);
-            int m_batch = x_input.numel() / in_size;
-            int out_size = self.getDSize();
-
-            // Validate the x_input dimensions.
-            if (in_size != expected_in_size) {
-              std::string shape_str = x_trans ? ("[*, " + std::to_string(expected_in_size) + "]")
-                                              : ("[" + std::to_string(expected_in_size) + ",*]");
-              throw std::runtime_error(
-                  "Invalid x_input dimensions: expected " + shape_str + " tensor");
-            }
-
-            // Build the buffers.
-            std::vector<int64_t> dims(x_input.sizes().begin(), x_input.sizes().end());
-            if (d_trans) {
-              dims[0] = out_size;
-            } else {
-              dims[dims.size() - 1] = out_size;
-            }
-            torch::Tensor d_output = torch::empty(dims, x_input.options());
-
-            // Call RPU function.
+            // Call RPU function (without GIL).
+            py::gil_scoped_release release;
             std::lock_guard<std::mutex> lock(self.mutex_);
             self.forward(
                 reinterpret_cast<T_RPU *>(x_input.template data_ptr<T>()),
@@ -511,7 +604,8 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
             }
             torch::Tensor x_output = torch::empty(dims, d_input.options());
 
-            // Call RPU function.
+            // Call RPU function (without GIL).
+            py::gil_scoped_release release;
             std::lock_guard<std::mutex> lock(self.mutex_);
             self.backward(
                 reinterpret_cast<T_RPU *>(d_input.template data_ptr<T>()),
@@ -593,7 +687,8 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
                   "Invalid x_input or d_input dimensions: batch dimensions mismatch!");
             }
 
-            // Call RPU function.
+            // Call RPU function (without GIL).
+            py::gil_scoped_release release;
             std::lock_guard<std::mutex> lock(self.mutex_);
             self.update(
                 reinterpret_cast<T_RPU *>(x_input.template data_ptr<T>()),
@@ -636,7 +731,8 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
             int N = x_input.size(0); // batch
             int d_image_size = ((d_tensor.numel() / d_tensor.size(0)) / d_tensor.size(1));
 
-            // Call RPU function.
+            // Call RPU function (without GIL).
+            py::gil_scoped_release release;
             std::lock_guard<std::mutex> lock(self.mutex_);
             self.forwardIndexed(
                 reinterpret_cast<T_RPU *>(x_input.template data_ptr<T>()),
@@ -672,7 +768,8 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
             int N = d_input.size(0); // batch
             int d_image_size = ((d_input.numel() / d_input.size(0)) / d_input.size(1));
 
-            // Call RPU function.
+            // Call RPU function (without GIL).
+            py::gil_scoped_release release;
             std::lock_guard<std::mutex> lock(self.mutex_);
             self.backwardIndexed(
                 reinterpret_cast<T_RPU *>(d_input.template data_ptr<T>()),
@@ -706,7 +803,8 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
             int N = d_input.size(0); // batch
             int d_image_size = d_input.numel() / (d_input.size(0) * d_input.size(1));
 
-            // Call RPU function.
+            // Call RPU function (without GIL).
+            py::gil_scoped_release release;
             std::lock_guard<std::mutex> lock(self.mutex_);
             self.updateIndexed(
                 reinterpret_cast<T_RPU *>(x_input.template data_ptr<T>()),
@@ -890,6 +988,223 @@ void declare_rpu_tiles(py::module &m, std::string type_name_add) {
           "__deepcopy__", [](const ClassPulsed &self, py::dict) { return ClassPulsed(self); },
           py::arg("memo"))
       .def("get_meta_parameters", &ClassPulsed::getMetaPar);
+
+  m.def(
+      NAME("forward_tiles"),
+      [](const std::vector<Class *> &tiles, const std::vector<torch::Tensor> &x_inputs_,
+         bool bias = false, bool x_trans = false, bool d_trans = false, bool is_test = false,
+         int num_threads = 0) {
+        if (tiles.size() != x_inputs_.size()) {
+          throw std::runtime_error("Number of tiles and inputs must match");
+        }
+        int n_tiles = tiles.size();
+        std::vector<torch::Tensor> x_inputs(n_tiles);
+        std::vector<torch::Tensor> d_outputs(n_tiles);
+        std::vector<int> m_batches(n_tiles);
+
+        for (int i = 0; i < n_tiles; i++) {
+          x_inputs[i] = x_inputs_[i].contiguous();
+          d_outputs[i] = make_forward_output<T, T_RPU>(
+              *tiles[i], x_inputs[i], bias, x_trans, d_trans, m_batches[i]);
+        }
+
+        // Call RPU functions (without GIL).
+        py::gil_scoped_release release;
+        run_jobs_threaded(n_tiles, num_threads, [&](int i) {
+          Class &tile = *tiles[i];
+          std::lock_guard<std::mutex> lock(tile.mutex_);
+          tile.forward(
+              reinterpret_cast<T_RPU *>(x_inputs[i].template data_ptr<T>()),
+              reinterpret_cast<T_RPU *>(d_outputs[i].template data_ptr<T>()), bias, m_batches[i],
+              x_trans, d_trans, is_test);
+        });
+        return d_outputs;
+      },
+      py::arg("tiles"), py::arg("x_inputs"), py::arg("bias") = false, py::arg("x_trans") = false,
+      py::arg("d_trans") = false, py::arg("is_test") = false, py::arg("num_threads") = 0,
+      R"pbdoc(
+    Compute the forward pass of several tiles concurrently.
+
+    Each tile computes the forward of its input on a pool of worker
+    threads (the GIL is released), so that independent tiles (e.g. of
+    a mapped layer) can run in parallel.
+
+    Note:
+        The tiles might use OpenMP internally as well. Consider to
+        reduce the number of OpenMP threads accordingly.
+
+    Args:
+        tiles: list of (CPU) tiles.
+        x_inputs: list of input tensors, one for each tile (see ``forward``).
+        bias: whether to use bias.
+        x_trans: whether the ``x_input`` matrices are transposed.
+        d_trans: whether the ``d`` matrices are transposed.
+        is_test: whether inference (true) mode or training (false)
+        num_threads: number of worker threads. Default (0) uses
+            the number of hardware threads (at most one per tile).
+
+    Returns:
+        list of torch::tensor: outputs of the tiles (same order).
+    )pbdoc");
+
+  m.def(
+      NAME("forward_tile_array"),
+      [](const std::vector<std::vector<Class *>> &tiles, const torch::Tensor &x_input_,
+         const std::vector<torch::Tensor> &out_scales_, bool is_test = false,
+         int num_threads = 0) {
+        int n_in = tiles.size();
+        int n_out = n_in > 0 ? tiles[0].size() : 0;
+        if (n_in == 0 || n_out == 0) {
+          throw std::runtime_error("Tile array is empty");
+        }
+        if (!out_scales_.empty() && out_scales_.size() != (size_t)(n_in * n_out)) {
+          throw std::runtime_error("Number of out scales and tiles must match");
+        }
+
+        // split sizes are given by the tiles
+        std::vector<int> in_offsets(n_in + 1, 0);
+        std::vector<int> out_offsets(n_out + 1, 0);
+        for (int i = 0; i < n_in; i++) {
+          if (tiles[i].size() != (size_t)n_out) {
+            throw std::runtime_error("Tile array rows must have the same number of tiles");
+          }
+          in_offsets[i + 1] = in_offsets[i] + tiles[i][0]->getXSize();
+        }
+        for (int j = 0; j < n_out; j++) {
+          out_offsets[j + 1] = out_offsets[j] + tiles[0][j]->getDSize();
+        }
+        for (int i = 0; i < n_in; i++) {
+          for (int j = 0; j < n_out; j++) {
+            if (tiles[i][j]->getXSize() != in_offsets[i + 1] - in_offsets[i] ||
+                tiles[i][j]->getDSize() != out_offsets[j + 1] - out_offsets[j]) {
+              throw std::runtime_error("Tile sizes of the tile array do not match");
+            }
+          }
+        }
+        int in_size = in_offsets[n_in];
+        int out_size = out_offsets[n_out];
+
+        auto x_input = x_input_.contiguous();
+        CHECK_TORCH_INPUT(x_input);
+        if (x_input.dim() < 1 || x_input.size(-1) != in_size) {
+          throw std::runtime_error(
+              "Invalid x_input dimensions: expected [*, " + std::to_string(in_size) +
+              "] tensor");
+        }
+        int m_batch = x_input.numel() / in_size;
+
+        // out scales are either empty, scalar, or one per output of the tile
+        std::vector<torch::Tensor> out_scales(n_in * n_out);
+        for (size_t k = 0; k < out_scales_.size(); k++) {
+          out_scales[k] = out_scales_[k].contiguous();
+          CHECK_TORCH_INPUT(out_scales[k]);
+          int numel = out_scales[k].numel();
+          int tile_out_size = out_offsets[k % n_out + 1] - out_offsets[k % n_out];
+          if (numel > 1 && numel != tile_out_size) {
+            throw std::runtime_error("Invalid out scale size");
+          }
+        }
+
+        std::vector<int64_t> dims(x_input.sizes().begin(), x_input.sizes().end());
+        dims[dims.size() - 1] = out_size;
+        torch::Tensor d_output = torch::empty(dims, x_input.options());
+
+        const T_RPU *x_values = reinterpret_cast<T_RPU *>(x_input.template data_ptr<T>());
+        T_RPU *d_values = reinterpret_cast<T_RPU *>(d_output.template data_ptr<T>());
+        std::vector<const T_RPU *> scale_values(n_in * n_out, nullptr);
+        std::vector<int> scale_sizes(n_in * n_out, 0);
+        for (size_t k = 0; k < out_scales_.size(); k++) {
+          scale_sizes[k] = out_scales[k].numel();
+          if (scale_sizes[k] > 0) {
+            scale_values[k] = reinterpret_cast<T_RPU *>(out_scales[k].template data_ptr<T>());
+          }
+        }
+
+        // Call RPU functions (without GIL).
+        py::gil_scoped_release release;
+
+        // contiguous input splits
+        std::vector<std::vector<T_RPU>> x_splits(n_in > 1 ? n_in : 0);
+        if (n_in > 1) {
+          run_jobs_threaded(n_in, num_threads, [&](int i) {
+            int split_size = in_offsets[i + 1] - in_offsets[i];
+            x_splits[i].resize((size_t)m_batch * split_size);
+            for (int i_batch = 0; i_batch < m_batch; i_batch++) {
+              std::copy_n(
+                  x_values + (size_t)i_batch * in_size + in_offsets[i], split_size,
+                  x_splits[i].data() + (size_t)i_batch * split_size);
+            }
+          });
+        }
+
+        // partial outputs of all tiles concurrently
+        std::vector<std::vector<T_RPU>> d_partials(n_in * n_out);
+        run_jobs_threaded(n_in * n_out, num_threads, [&](int k) {
+          int i = k / n_out;
+          int j = k % n_out;
+          d_partials[k].resize((size_t)m_batch * (out_offsets[j + 1] - out_offsets[j]));
+          Class &tile = *tiles[i][j];
+          std::lock_guard<std::mutex> lock(tile.mutex_);
+          tile.forward(
+              n_in > 1 ? x_splits[i].data() : x_values, d_partials[k].data(), false, m_batch,
+              false, false, is_test);
+        });
+
+        // scale and reduce over the input splits in place (fixed
+        // order, in blocks of rows)
+        const int block_rows = 64;
+        int n_blocks = (m_batch + block_rows - 1) / block_rows;
+        run_jobs_threaded(n_blocks, num_threads, [&](int i_block) {
+          int b_start = i_block * block_rows;
+          int b_end = MIN(b_start + block_rows, m_batch);
+          for (int j = 0; j < n_out; j++) {
+            int split_size = out_offsets[j + 1] - out_offsets[j];
+            for (int i = 0; i < n_in; i++) {
+              int k = i * n_out + j;
+              const T_RPU *scales = scale_values[k];
+              for (int i_batch = b_start; i_batch < b_end; i_batch++) {
+                T_RPU *d = d_values + (size_t)i_batch * out_size + out_offsets[j];
+                const T_RPU *p = d_partials[k].data() + (size_t)i_batch * split_size;
+                for (int l = 0; l < split_size; l++) {
+                  T_RPU value = p[l];
+                  if (scales != nullptr) {
+                    value *= scales[scale_sizes[k] > 1 ? l : 0];
+                  }
+                  d[l] = i == 0 ? value : d[l] + value;
+                }
+              }
+            }
+          }
+        });
+        return d_output;
+      },
+      py::arg("tiles"), py::arg("x_input"), py::arg("out_scales"), py::arg("is_test") = false,
+      py::arg("num_threads") = 0,
+      R"pbdoc(
+    Compute the forward pass of a logical array of tiles concurrently.
+
+    The input is split along its last dimension according to the input
+    sizes of the tile rows, the forward of all tiles is computed on a
+    pool of worker threads (the GIL is released), and the partial
+    outputs are reduced over the input splits into one output tensor.
+
+    Args:
+        tiles: ``[n_in][n_out]`` nested list of (CPU) tiles. All tiles
+            of a row share the input split, all tiles of a column the
+            output split.
+        x_input: input tensor ``[*, in_size]``.
+        out_scales: list of ``n_in * n_out`` tensors (row-major), that
+            scale the partial output of each tile before the
+            reduction. Either empty (no scaling), one element or
+            one element per output of the tile. An empty list
+            applies no scaling at all.
+        is_test: whether inference (true) mode or training (false)
+        num_threads: number of worker threads. Default (0) uses
+            the number of hardware threads.
+
+    Returns:
+        torch::tensor: output ``[*, out_size]``.
+    )pbdoc");
 };
 
 #undef NAME
@@ -90,6 +90,39 @@ void declare_rpu_tiles_cuda(py::module &m, std::string type_name_add, bool add_u
            Args:
                strict: Whether to throw a runtime error when a field is not found. 
            )pbdoc")
+      .def(
+          "dump_extra_binary",
+          [](Class &self) {
+            RPU::state_t state;
+            self.dumpExtra(state, "rpucuda");
+            return state_to_bytes(state);
+          },
+          R"pbdoc(
+           Return the additional state variables in a compact binary format.
+
+           In contrast to ``dump_extra``, all variables are kept in
+           their native data type in aligned contiguous blocks.
+
+           Returns:
+               bytes: binary state to be used with ``load_extra_binary``
+           )pbdoc")
+      .def(
+          "load_extra_binary",
+          [](Class &self, py::buffer buffer, bool strict) {
+            auto state = state_from_buffer(buffer);
+            self.loadExtra(state, "rpucuda", strict);
+          },
+          py::arg("buffer"), py::arg("strict"),
+          R"pbdoc(
+           Load the binary state generated by dump_extra_binary.
+
+           The data is read directly from the given buffer (e.g. ``bytes``
+           or a memory-mapped file) without intermediate copies.
+
+           Args:
+               buffer: binary state
+               strict: Whether to throw a runtime error when a field is not found.
+           )pbdoc")
       .def(
           "set_shared_weights",
           [](Class &self, torch::Tensor weights) {
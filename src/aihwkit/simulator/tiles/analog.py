@@ -181,6 +181,7 @@ class AnalogTile(TileModule, TileWithPeriphery, RPUCudaSimulatorTileWrapper):
     """
 
     supports_ddp: bool = False
+    supports_multi_tile_forward: bool = True
 
     def __init__(
         self,
@@ -344,6 +344,68 @@ class AnalogMVMIRDropT(AnalogMVM):
 
         return vth_3d, rth_3d  # rth_3d in MOhm
 
+    @classmethod
+    @no_grad()
+    def _thev_equiv_current(
+        cls,
+        input_: Tensor,
+        weight: Tensor,
+        g_converter: Optional[SinglePairConductanceConverter] = None,
+        v_read: float = 0.2,
+        time_steps: int = 128,
+        t_max: float = 1.0,
+        segments: int = 8,
+        r_s: float = 0.15,
+        phys_input_size: int = 512,
+        use_extension: bool = True,
+    ) -> Tensor:
+        """Returns the time-integrated output current of the Thevenin
+        equivalents (see :meth:`_thev_equiv`), i.e. the sum over time
+        of ``(vth_3d - v_read) / rth_3d``.
+
+        If the C++ extension is available, the fused operator is used
+        which does not materialize the ``[batch_size, out_size,
+        time_steps]`` intermediates.
+
+        Args:
+            input_: ``[N, in_size]`` MVM tile input activations
+            weight: ``[in_size, out_size]`` MVM tile weights
+            g_converter: specifies weight programming scheme
+            v_read: read voltage (in volts)
+            time_steps: discrete time steps (see :meth:`_thev_equiv`)
+            t_max: max sim time
+            segments: Number of synthetic segments (see :meth:`_thev_equiv`)
+            r_s: wire series resistance in units of Ohms
+            phys_input_size: max hardware MVM tile rows (need to 0-pad)
+            use_extension: Whether to use the C++ extension operator
+                for speedup if available
+
+        Returns:
+            Output current (in uA) of dimension ``[batch_size, out_size]``
+        """
+        if not (use_extension and extension_ops is not None):
+            vth_3d, rth_3d = cls._thev_equiv(
+                input_,
+                weight,
+                g_converter,
+                time_steps=time_steps,
+                t_max=t_max,
+                segments=segments,
+                r_s=r_s,
+                phys_input_size=phys_input_size,
+                use_extension=False,
+            )
+            return torch_sum((vth_3d - v_read) / rth_3d, dim=2)
+
+        input_, weight = cls._pad_symmetric(input_, weight, phys_input_size=phys_input_size)
+        if g_converter is None:
+            g_converter = SinglePairConductanceConverter()
+        [gp_2d, gm_2d], _ = g_converter.convert_to_conductances(weight)
+
+        return extension_ops.thevenin_equiv_sum(
+            input_, gp_2d.T.contiguous(), gm_2d.T.contiguous(), r_s, t_max, time_steps, v_read
+        )
+
     @classmethod
     def _matmul_irdrop(
         cls,
@@ -388,31 +450,29 @@ class AnalogMVMIRDropT(AnalogMVM):
         else:
             new_weight = weight
 
-        vth_3d, rth_3d = cls._thev_equiv(
+        mvm_even_col_down_adc = cls._thev_equiv_current(
             input_,
             new_weight[:, 0::2],  # even cols
             g_converter,
+            v_read=io_pars.ir_drop_v_read,
             time_steps=time_steps,
             t_max=t_max,
             segments=io_pars.ir_drop_segments,
             r_s=ir_drop_rs,
             phys_input_size=phys_input_size,
-        )
-        i_out_3d = (vth_3d - io_pars.ir_drop_v_read) / rth_3d  # uA
-        mvm_even_col_down_adc = torch_sum(i_out_3d, dim=2)  # batch_size x n_cols/2
+        )  # batch_size x n_cols/2 [uA]
 
-        vth_3d, rth_3d = cls._thev_equiv(
+        mvm_odd_col_up_adc = cls._thev_equiv_current(
             flip(input_, (1,)),  # flip input
             flip(new_weight[:, 1::2], (0,)),  # odd cols
             g_converter,
+            v_read=io_pars.ir_drop_v_read,
             time_steps=time_steps,
             t_max=t_max,
             segments=io_pars.ir_drop_segments,
             r_s=ir_drop_rs,
             phys_input_size=phys_input_size,
-        )
-        i_out_3d = (vth_3d - io_pars.ir_drop_v_read) / rth_3d  # uA
-        mvm_odd_col_up_adc = torch_sum(i_out_3d, dim=2)  # batch_size x n_cols/2
+        )  # batch_size x n_cols/2 [uA]
 
         mvm = cls._interleave_cols_2d(mvm_even_col_down_adc, mvm_odd_col_up_adc)  # symmetric ADCs
         mvm /= g_converter.g_max - g_converter.g_min  # conductance normalization
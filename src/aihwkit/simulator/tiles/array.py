@@ -13,17 +13,33 @@
 """Implements analog tile module array ."""
 from typing import Any, Optional, Tuple, List, TYPE_CHECKING
 
-from torch import Tensor, cat, split, zeros
+from torch import Tensor, cat, split, zeros, empty, is_grad_enabled
 from torch.nn import ModuleList, Parameter, Module
 from torch.autograd import no_grad
 
 from aihwkit.simulator.tiles.base import TileModuleBase
+from aihwkit.simulator.rpu_base import tiles
+from aihwkit.simulator.parameters.enums import RPUDataType
 from aihwkit.exceptions import TileModuleError
 
 if TYPE_CHECKING:
     from aihwkit.simulator.configs.configs import MappableRPU
 
 
+def get_tiles_module(data_type: RPUDataType) -> Optional[Any]:
+    """Returns the tile bindings module of the data type.
+
+    Args:
+        data_type: data type of the tiles
+
+    Returns:
+        The bindings (sub-)module or ``None`` if the data type is not compiled.
+    """
+    if data_type == RPUDataType.FLOAT:
+        return tiles
+    return getattr(tiles, data_type.value, None)
+
+
 class TileModuleArray(Module, TileModuleBase):
     """Logical array of tile modules.
 
@@ -33,6 +49,13 @@ class TileModuleArray(Module, TileModuleBase):
         bias is always concatenated for the logical array and added at
         the end in digital
 
+    Note:
+
+        Without autograd (e.g. inside ``torch.no_grad()``), the forward
+        of CPU tiles is computed concurrently for all tiles of the
+        array by the multi-tile engine of the simulator (the GIL is
+        released), if all tiles support it.
+
     """
 
     supports_indexed = False
@@ -149,13 +172,90 @@ class TileModuleArray(Module, TileModuleBase):
             return weight, self.bias.clone().cpu()
         return weight, None
 
+    def _get_multi_tile_forward_tiles(
+        self, x_input: Tensor, tensor_view: Optional[Tuple] = None
+    ) -> Optional[List[List[Any]]]:
+        """Returns the simulator tiles if the forward can be computed
+        by the multi-tile engine, ``None`` otherwise.
+
+        Args:
+            x_input: input of the forward
+            tensor_view: view of the output (only ``None`` is supported)
+
+        Returns:
+            Nested list of the simulator tiles (as ``self.array``) or ``None``.
+        """
+        if is_grad_enabled() or tensor_view is not None or x_input.is_cuda:
+            return None
+
+        # bindings of the data type of the tiles (as for the tile classes)
+        data_type = self.array[0][0].get_data_type()
+        module = get_tiles_module(data_type)
+        if (
+            module is None
+            or x_input.dtype != data_type.as_torch()
+            or not hasattr(module, "forward_tile_array")
+        ):
+            return None
+
+        for in_tiles in self.array:
+            for analog_tile in in_tiles:
+                if (
+                    not getattr(analog_tile, "supports_multi_tile_forward", False)
+                    or analog_tile.is_cuda
+                    or analog_tile.get_data_type() != data_type
+                    or not isinstance(analog_tile.tile, module.FloatingPointTile)
+                    or analog_tile.get_analog_ctx().use_indexed
+                    or analog_tile.input_range is not None
+                    or analog_tile.in_trans
+                    or analog_tile.out_trans
+                    or analog_tile.analog_bias
+                    or analog_tile.digital_bias
+                ):
+                    return None
+
+        return [[analog_tile.tile for analog_tile in in_tiles] for in_tiles in self.array]
+
+    def _multi_tile_forward(self, x_input: Tensor, simulator_tiles: List[List[Any]]) -> Tensor:
+        """Computes the forward of all tiles concurrently.
+
+        Args:
+            x_input: input of the forward
+            simulator_tiles: simulator tiles as returned by
+                :meth:`_get_multi_tile_forward_tiles`
+
+        Returns:
+            output of the array (without bias)
+        """
+        is_test = not self.training
+        data_type = self.array[0][0].get_data_type()
+        dtype = data_type.as_torch()
+        out_scales = []
+        for in_tiles in self.array:
+            for analog_tile in in_tiles:
+                analog_tile.ensure_shared_weights()
+                scales = analog_tile.get_forward_out_scales(is_test)
+                if scales is None:
+                    out_scales.append(empty(0, dtype=dtype))
+                else:
+                    out_scales.append(scales.detach().reshape(-1).to(dtype).contiguous())
+
+        forward_tile_array = getattr(get_tiles_module(data_type), "forward_tile_array")
+        return forward_tile_array(simulator_tiles, x_input, out_scales, is_test)
+
     def forward(self, x_input: Tensor, tensor_view: Optional[Tuple] = None) -> Tensor:
         """Compute the forward pass."""
         # pylint: disable=arguments-differ,arguments-renamed
 
+        simulator_tiles = None
+        if self.analog_tile_count > 1:
+            simulator_tiles = self._get_multi_tile_forward_tiles(x_input, tensor_view)
+
+        analog_tile = self.array[0][0]
         if self.analog_tile_count == 1:
-            analog_tile = self.array[0][0]
             result = analog_tile(x_input)
+        elif simulator_tiles is not None:
+            result = self._multi_tile_forward(x_input, simulator_tiles)
         else:
             # mapped version
             last_dim = x_input.ndim - 1
@@ -61,6 +61,7 @@ class AnalogTileStateNames:
     ANALOG_STATE_PREFIX = "analog_tile_state_"
     ANALOG_STATE_NAME = "analog_tile_state"
     EXTRA = "state_extra"
+    EXTRA_BINARY = "state_extra_binary_v1"
 
     @staticmethod
     def get_field_names() -> List[str]:
@@ -441,7 +442,11 @@ class SimulatorTileWrapper:
         current_dict[SN.LR] = self.tile.get_learning_rate()
         current_dict.pop("tile", None)
         current_dict[SN.CONTEXT] = self.analog_ctx.data
-        current_dict[SN.EXTRA] = self.tile.dump_extra()
+        binary_extra = getattr(self.get_runtime(), "binary_extra_state", False)
+        if binary_extra and hasattr(self.tile, "dump_extra_binary"):
+            current_dict[SN.EXTRA_BINARY] = self.tile.dump_extra_binary()
+        else:
+            current_dict[SN.EXTRA] = self.tile.dump_extra()
         current_dict[SN.VERSION] = __version__
 
         # don't save device. Will be determined by loading object
@@ -491,6 +496,7 @@ class SimulatorTileWrapper:
             analog_ctx = current_dict.pop(SN.CONTEXT, None)
             weights = current_dict.pop(SN.WEIGHTS)
             extra = current_dict.pop(SN.EXTRA, None)
+            extra_binary = current_dict.pop(SN.EXTRA_BINARY, None)
 
             hidden_parameters = current_dict.pop(SN.HIDDEN_PARAMETERS)
             hidden_parameters_names = current_dict.pop(SN.HIDDEN_PARAMETER_NAMES, [])
@@ -548,7 +554,9 @@ class SimulatorTileWrapper:
             # found. Note that these extra states are only needed for some
             # tiles (compounds) if training needs to be continued without
             # resetting counters etc.)
-            if extra is not None:
+            if extra_binary is not None and hasattr(self.tile, "load_extra_binary"):
+                self.tile.load_extra_binary(extra_binary, False)
+            elif extra is not None:
                 self.tile.load_extra(extra, False)
 
         # map location should be applied to tensors in state_dict
@@ -102,6 +102,8 @@ class FloatingPointTile(TileModule, TileWithPeriphery, RPUCudaSimulatorTileWrapp
         out_trans: Whether to assume an transposed output (batch first).
     """
 
+    supports_multi_tile_forward: bool = True
+
     def __init__(
         self,
         out_size: int,
@@ -251,6 +251,27 @@ class InferenceTileWithPeriphery(TileWithPeriphery):
             return x_output * self.alpha
         return x_output
 
+    @no_grad()
+    def get_forward_out_scales(self, is_test: bool = False) -> Optional[Tensor]:
+        """Get the digital scales applied to the output of the forward.
+
+        Additionally includes the drift compensation in eval mode.
+
+        Args:
+            is_test: whether in eval mode
+
+        Returns:
+            Scale tensor (scalar or one per output) if any scale exist else None.
+        """
+        scales = super().get_forward_out_scales(is_test)
+        if (
+            is_test
+            and hasattr(self.rpu_config, "drift_compensation")
+            and self.rpu_config.drift_compensation is not None
+        ):
+            return self.alpha if scales is None else scales * self.alpha
+        return scales
+
     @no_grad()
     def post_update_step(self) -> None:
         """Operators that need to be called once per mini-batch.
@@ -343,6 +364,7 @@ class InferenceTile(TileModule, InferenceTileWithPeriphery, RPUCudaSimulatorTile
     """
 
     supports_ddp: bool = True
+    supports_multi_tile_forward: bool = True
 
     def __init__(
         self,
@@ -71,6 +71,9 @@ class TileWithPeriphery(BaseTile, SimulatorTileWrapper):
     # pylint: disable=no-member, too-many-public-methods, abstract-method
     # pylint: disable=too-many-instance-attributes
     supports_indexed = True
+    # whether the forward is the simulator tile forward followed by the
+    # scales of ``get_forward_out_scales`` (see ``TileModuleArray``)
+    supports_multi_tile_forward = False
 
     def __init__(self) -> None:
         # SimulatorTileWrapper.__init__ is called later. Only included here to
@@ -713,6 +716,23 @@ class TileWithPeriphery(BaseTile, SimulatorTileWrapper):
         else:
             self.out_scaling_alpha = as_tensor(alpha).to(self.device).view(-1)
 
+    @no_grad()
+    def get_forward_out_scales(self, is_test: bool = False) -> Optional[Tensor]:
+        """Get the digital scales applied to the output of the forward.
+
+        Combines the mapping scales (see ``post_forward``) and the
+        learned out scales (see ``apply_out_scaling``), so that the
+        forward can be computed from the bare tile forward.
+
+        Args:
+            is_test: whether in eval mode
+
+        Returns:
+            Scale tensor (scalar or one per output) if any scale exist else None.
+        """
+        # pylint: disable=unused-argument
+        return self.get_scales()
+
     def apply_out_scaling(
         self, values: Tensor, tensor_view: Optional[Tuple[int, ...]] = None
     ) -> Tensor:
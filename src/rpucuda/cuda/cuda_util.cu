@@ -51,16 +51,15 @@ namespace RPU {
   void load(                                                                                       \
       CudaContextPtr context, RPU::state_t &state, std::string key, CudaArray<T> &value,           \
       bool strict) {                                                                               \
-    std::vector<double> tmp;                                                                       \
-    try {                                                                                          \
-      tmp = state.at(key);                                                                         \
-    } catch (const std::out_of_range &oor) {                                                       \
+    auto it = state.find(key);                                                                     \
+    if (it == state.end()) {                                                                       \
       if (strict) {                                                                                \
         RPU_FATAL("Cannot find the cuda unique vector key `" << key << "` in state.");             \
       }                                                                                            \
       return;                                                                                      \
     }                                                                                              \
-    std::vector<T> out(tmp.begin(), tmp.end());                                                    \
+    std::vector<T> out(it->second.size());                                                         \
+    it->second.copyTo(out.data());                                                                 \
     if (!out.size()) {                                                                             \
       value = CudaArray<T>(context, 0);                                                            \
     } else {                                                                                       \
@@ -87,16 +86,15 @@ RPU_LOAD_ARRAY(half_t);
   void load(                                                                                       \
       CudaContextPtr context, RPU::state_t &state, std::string key,                                \
       std::unique_ptr<CudaArray<T>> &value, bool strict) {                                         \
-    std::vector<double> tmp;                                                                       \
-    try {                                                                                          \
-      tmp = state.at(key);                                                                         \
-    } catch (const std::out_of_range &oor) {                                                       \
+    auto it = state.find(key);                                                                     \
+    if (it == state.end()) {                                                                       \
       if (strict) {                                                                                \
         RPU_FATAL("Cannot find the cuda vector key `" << key << "` in state.");                    \
       }                                                                                            \
       return;                                                                                      \
     }                                                                                              \
-    std::vector<T> out(tmp.begin(), tmp.end());                                                    \
+    std::vector<T> out(it->second.size());                                                         \
+    it->second.copyTo(out.data());                                                                 \
     if (!out.size()) {                                                                             \
       value = nullptr;                                                                             \
     } else {                                                                                       \
@@ -121,8 +119,7 @@ RPU_LOAD_UNIQUE(half_t);
 #define RPU_INSERT_CUDA(TYPE)                                                                      \
   template <> void insert(RPU::state_t &state, std::string key, const CudaArray<TYPE> &value) {    \
     std::vector<TYPE> tmp = value.cpu();                                                           \
-    std::vector<double> out(tmp.begin(), tmp.end());                                               \
-    state[key] = out;                                                                              \
+    state[key] = StateValue::copyFrom(tmp.data(), tmp.size());                                     \
   }
 
 RPU_INSERT_CUDA(float);
@@ -145,10 +142,9 @@ RPU_INSERT_CUDA(half_t);
       RPU::state_t &state, std::string key, const std::unique_ptr<CudaArray<TYPE>> &value) {       \
     if (value != nullptr) {                                                                        \
       std::vector<TYPE> tmp = value->cpu();                                                        \
-      std::vector<double> out(tmp.begin(), tmp.end());                                             \
-      state[key] = out;                                                                            \
+      state[key] = StateValue::copyFrom(tmp.data(), tmp.size());                                   \
     } else {                                                                                       \
-      state[key] = std::vector<double>{};                                                          \
+      state[key] = StateValue();                                                                   \
     }                                                                                              \
   }
 
@@ -177,6 +177,9 @@ protected:
     RPU::math::elemconst<T>(context_, v, size, (T)0.0);
   };
 
+  // one batched GEMM is faster on GPU than per-image launches
+  bool hasSampleLocalForward() const override { return false; };
+
 public:
   void printWeights(int x_count, int d_count) override;
 
@@ -117,10 +117,10 @@ void PulsedRPUDeviceCuda<T>::populateFrom(const AbstractRPUDevice<T> &rpu_device
 
   PulsedRPUDeviceCudaBase<T>::populateFrom(rpu_device_in);
 
-  T *mn = rpu_device.getMinBound()[0];
-  T *mx = rpu_device.getMaxBound()[0];
-  T *su = rpu_device.getScaleUp()[0];
-  T *sd = rpu_device.getScaleDown()[0];
+  const T *mn = rpu_device.getMinBound()[0];
+  const T *mx = rpu_device.getMaxBound()[0];
+  const T *su = rpu_device.getScaleUp()[0];
+  const T *sd = rpu_device.getScaleDown()[0];
 
   // copy RPU to device variables
   param_t *tmp = new param_t[4 * size];
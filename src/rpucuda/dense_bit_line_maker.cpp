@@ -77,6 +77,8 @@ template <typename T> DenseBitLineMaker<T>::DenseBitLineMaker(const DenseBitLine
 
   x_size_ = other.x_size_;
   d_size_ = other.d_size_;
+  current_BL_ = other.current_BL_;
+  current_pulse_type_ = other.current_pulse_type_;
 
   if (other.containers_allocated_) {
     initialize(other.x_size_, other.d_size_);
@@ -135,6 +137,8 @@ DenseBitLineMaker<T> &DenseBitLineMaker<T>::operator=(DenseBitLineMaker<T> &&oth
   // other values
   x_size_ = other.x_size_;
   d_size_ = other.d_size_;
+  current_BL_ = other.current_BL_;
+  current_pulse_type_ = other.current_pulse_type_;
 
   rw_rng_ = std::move(other.rw_rng_);
 
@@ -180,18 +184,33 @@ inline void DenseBitLineMaker<T>::generateCountsMean(
 
 /** generates coincidences by just multiplying the respective count
  prob. no random fluctuations.  Coincidences might be pos of
- negative, depending on the direction of update**/
+ negative, depending on the direction of update. Only rows i_start
+ to i_end are generated. Returns false (without setting the block)
+ if all coincidences are zero **/
 template <typename T>
-void DenseBitLineMaker<T>::generateCoincidences(
+bool DenseBitLineMaker<T>::generateCoincidences(
     int *coincidences,
     const int *x_counts,
     const int x_size,
     const int *d_counts,
-    const int d_size,
+    const int i_start,
+    const int i_end,
     const int BL) {
+
+  bool all_zero = true;
+  for (int i = i_start; i < i_end; ++i) {
+    if (d_counts[i] != 0) {
+      all_zero = false;
+      break;
+    }
+  }
+  if (all_zero) {
+    return false;
+  }
+
   T bl = (T)BL;
   int idx = 0;
-  for (int i = 0; i < d_size; ++i) {
+  for (int i = i_start; i < i_end; ++i) {
     T dc = (T)d_counts[i];
     if (dc != (T)0.0) {
       dc /= bl;
@@ -207,6 +226,7 @@ void DenseBitLineMaker<T>::generateCoincidences(
       }
     }
   }
+  return true;
 }
 
 /**************************************************************************************/
@@ -243,15 +263,28 @@ inline void DenseBitLineMaker<T>::generateDetImplicit(
 }
 
 template <typename T>
-void DenseBitLineMaker<T>::generateCoincidencesDetI(
+bool DenseBitLineMaker<T>::generateCoincidencesDetI(
     int *coincidences,
     const T *x_values,
     const int x_size,
     const T *d_values,
-    const int d_size,
+    const int i_start,
+    const int i_end,
     const int BL) {
+
+  bool all_zero = true;
+  for (int i = i_start; i < i_end; ++i) {
+    if (d_values[i] != (T)0.0) {
+      all_zero = false;
+      break;
+    }
+  }
+  if (all_zero) {
+    return false;
+  }
+
   int idx = 0;
-  for (int i = 0; i < d_size; ++i) {
+  for (int i = i_start; i < i_end; ++i) {
     T dc = d_values[i];
     if (dc != (T)0.0) {
       dc *= BL;
@@ -267,11 +300,12 @@ void DenseBitLineMaker<T>::generateCoincidencesDetI(
       }
     }
   }
+  return true;
 }
 
 // makeCounts
 template <typename T>
-int *DenseBitLineMaker<T>::makeCoincidences(
+int DenseBitLineMaker<T>::makeCounts(
     const T *x_in,
     const int x_inc,
     int &x_noz,
@@ -312,8 +346,6 @@ int *DenseBitLineMaker<T>::makeCoincidences(
     // d counts
     generateCountsMean(
         d_counts_, d_in, d_inc, d_size_, d_noz, A, rng, BL, up.res, up.sto_round, lr);
-
-    generateCoincidences(coincidences_, x_counts_, x_size_, d_counts_, d_size_, BL);
     break;
 
   case PulseType::DeterministicImplicit: {
@@ -326,13 +358,61 @@ int *DenseBitLineMaker<T>::makeCoincidences(
     // d counts
     generateDetImplicit(
         d_values_, d_in, d_inc, d_size_, d_noz, A, rng, BL, up.d_res_implicit, up.sto_round, lr);
-
-    generateCoincidencesDetI(coincidences_, x_values_, x_size_, d_values_, d_size_, BL);
   } break;
   default:
     RPU_FATAL("PulseType not supported");
   }
 
+  current_BL_ = BL;
+  current_pulse_type_ = up.pulse_type;
+  return BL;
+}
+
+template <typename T> int *DenseBitLineMaker<T>::makeCoincidenceBlock(int i_start, int i_end) {
+
+  if (!containers_allocated_) {
+    RPU_FATAL("Counts need to be generated first.");
+  }
+  // block is stored at its place in the full matrix
+  int *c_block = coincidences_ + i_start * x_size_;
+  bool non_zero = false;
+
+  switch (current_pulse_type_) {
+  case PulseType::MeanCount:
+    non_zero = generateCoincidences(
+        c_block, x_counts_, x_size_, d_counts_, i_start, i_end, current_BL_);
+    break;
+  case PulseType::DeterministicImplicit:
+    non_zero = generateCoincidencesDetI(
+        c_block, x_values_, x_size_, d_values_, i_start, i_end, current_BL_);
+    break;
+  default:
+    RPU_FATAL("PulseType not supported");
+  }
+  return non_zero ? c_block : nullptr;
+}
+
+template <typename T>
+int *DenseBitLineMaker<T>::makeCoincidences(
+    const T *x_in,
+    const int x_inc,
+    int &x_noz,
+    const T *d_in,
+    const int d_inc,
+    int &d_noz,
+    RNG<T> *rng,
+    const T lr,
+    const T dw_min,
+    const PulsedUpdateMetaParameter<T> &up) {
+
+  makeCounts(x_in, x_inc, x_noz, d_in, d_inc, d_noz, rng, lr, dw_min, up);
+
+  if (makeCoincidenceBlock(0, d_size_) == nullptr) {
+    // need to set to zero
+    for (int k = 0; k < d_size_ * x_size_; ++k) {
+      coincidences_[k] = 0;
+    }
+  }
   return coincidences_;
 }
 
@@ -38,10 +38,14 @@ public:
     swap(a.d_counts_, b.d_counts_);
     swap(a.x_counts_, b.x_counts_);
     swap(a.coincidences_, b.coincidences_);
+    swap(a.d_values_, b.d_values_);
+    swap(a.x_values_, b.x_values_);
+    swap(a.current_BL_, b.current_BL_);
+    swap(a.current_pulse_type_, b.current_pulse_type_);
     swap(a.rw_rng_, b.rw_rng_);
   }
 
-  /* returns current BL*/
+  /* returns the full coincidence matrix (d_size x x_size)*/
   virtual int *makeCoincidences(
       const T *x_in,
       const int x_inc,
@@ -54,6 +58,26 @@ public:
       const T dw_min,
       const PulsedUpdateMetaParameter<T> &up);
 
+  /* Only generates the x and d counts (but not the coincidences),
+     returns current BL. Use makeCoincidenceBlock afterwards. */
+  int makeCounts(
+      const T *x_in,
+      const int x_inc,
+      int &x_noz,
+      const T *d_in,
+      const int d_inc,
+      int &d_noz,
+      RNG<T> *rng,
+      const T lr,
+      const T dw_min,
+      const PulsedUpdateMetaParameter<T> &up);
+
+  /* Generates the coincidences of the rows i_start <= i < i_end
+     (after makeCounts). Returns the pointer to the block (row-major)
+     or nullptr if all coincidences of the block are zero. Thread
+     safe for non-overlapping blocks. */
+  int *makeCoincidenceBlock(int i_start, int i_end);
+
   void printCounts(int max_n) const;
   bool supports(RPU::PulseType pulse_type) const;
 
@@ -65,20 +89,22 @@ private:
   void freeContainers();
   void allocateContainers();
   void initialize(int x_size, int d_size);
-  inline void generateCoincidences(
+  inline bool generateCoincidences(
       int *coincidences,
       const int *x_counts,
       const int x_size,
       const int *d_counts,
-      const int d_size,
+      const int i_start,
+      const int i_end,
       const int BL);
 
-  inline void generateCoincidencesDetI(
+  inline bool generateCoincidencesDetI(
       int *coincidences,
       const T *x_values,
       const int x_size,
       const T *d_values,
-      const int d_size,
+      const int i_start,
+      const int i_end,
       const int BL);
 
   inline void generateCountsMean(
@@ -119,6 +145,9 @@ private:
 
   T *d_values_ = nullptr;
   T *x_values_ = nullptr;
+
+  int current_BL_ = 0;
+  PulseType current_pulse_type_ = PulseType::None;
 };
 
 } // namespace RPU
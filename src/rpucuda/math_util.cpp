@@ -332,19 +332,21 @@ void permute132(
     const int d3,
     const bool bias) { // permute order to 132
   // bias is added to d2 (thus d1*d3 ones at the end)
-  int output_offset = 0;
-
-  int size12 = d1 * (d2 - bias);
+  int d2_wo_bias = d2 - bias;
+  int size12 = d1 * d2_wo_bias;
   int sz = sizeof(T) * (d1);
-  for (int i = 0; i < d2 - bias; ++i) {
-    int input_offset = i * d1;
+
+  // each (i, j) block of d1 is disjoint in the output
+#pragma omp parallel for collapse(2) if (size12 * d3 >= 32768)
+  for (int i = 0; i < d2_wo_bias; ++i) {
     for (int j = 0; j < d3; ++j) {
+      int output_offset = (i * d3 + j) * d1;
+      int input_offset = i * d1 + j * size12;
       std::memcpy((void *)(X_out + output_offset), (const void *)(X_in + input_offset), sz);
-      output_offset += d1;
-      input_offset += size12;
     }
   }
   if (bias) {
+    int output_offset = size12 * d3;
     int size13 = d1 * d3;
     for (int k = 0; k < size13; ++k) {
       X_out[output_offset + k] = (T)1.0;
@@ -14,6 +14,7 @@
 #include "utility_functions.h"
 #include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <math.h>
 #include <memory>
@@ -43,12 +44,13 @@ template <typename T> RNG<T>::RNG(unsigned int rseed) : gauss_list_size_(FIXED_L
   this->setSeed(rseed);
 }
 
-template <typename T> RNG<T>::~RNG() {
-  if (gauss_numbers_list_ != nullptr) {
-    delete[] gauss_numbers_list_;
-    gauss_numbers_list_ = nullptr;
-  }
-}
+template <typename T>
+RNG<T>::RNG(const RNG<T> &parent, SubstreamTag)
+    : gauss_list_size_(parent.gauss_list_size_), seed_(parent.seed_),
+      gauss_list_(parent.gauss_list_), gauss_numbers_list_(parent.gauss_numbers_list_),
+      engine_(parent.engine_) {}
+
+template <typename T> RNG<T>::~RNG() {}
 
 /*********************************************************************************/
 // copy constructor
@@ -70,20 +72,25 @@ template <typename T> RNG<T>::RNG(RNG<T> &&other) noexcept { *this = std::move(o
 // move assignment
 template <typename T> RNG<T> &RNG<T>::operator=(RNG<T> &&other) noexcept {
 
+  gauss_list_ = std::move(other.gauss_list_);
   gauss_numbers_list_ = other.gauss_numbers_list_;
   other.gauss_numbers_list_ = nullptr;
   gauss_list_size_ = other.gauss_list_size_;
   seed_ = other.seed_;
+  engine_ = other.engine_;
+  lanes_ = other.lanes_;
+  lanes_seeded_ = other.lanes_seeded_;
+  state_version_ = other.state_version_;
   return *this;
 }
 
 template <typename T> void RNG<T>::randomizeSeed() {
-  unsigned int seed =
-      (unsigned int)std::chrono::high_resolution_clock::now().time_since_epoch().count();
-  srand(seed);
-  fast_srand((randomint_t)(rand() % RPU_MAX_RAND_RANGE));
-  generateNewList();
+  unsigned long long seed =
+      (unsigned long long)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  engine_.setSeed(seed);
+  lanes_seeded_ = false;
   seed_ = 0;
+  generateNewList();
 }
 
 template <typename T> void RNG<T>::setSeed(unsigned int seed) {
@@ -91,12 +98,149 @@ template <typename T> void RNG<T>::setSeed(unsigned int seed) {
   if (seed == 0) {
     randomizeSeed();
   } else {
-    srand((randomint_t)seed);
-    fast_srand((randomint_t)seed);
+    engine_.setSeed(seed);
+    lanes_seeded_ = false;
     generateNewList();
   }
 }
 
+template <typename T> void RNG<T>::getSubstreams(std::vector<RNG<T>> &substreams, int n) {
+  substreams.clear();
+  substreams.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    substreams.push_back(RNG<T>(*this, SubstreamTag()));
+    engine_.jump();
+  }
+}
+
+template <typename T> void RNG<T>::fillUniform(T *values, int size) {
+  for (int i = 0; i < size; ++i) {
+    values[i] = sampleUniform();
+  }
+}
+
+/* Branch-free polynomial approximations (float accuracy) so that
+   the Box-Muller block loop below can be vectorized by the compiler */
+namespace {
+
+#define RPU_GAUSS_BLOCK 64
+
+FORCE_INLINE float logApprox(float x) {
+  // x = m * 2^e with m in [sqrt(0.5), sqrt(2))
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(float));
+  int e = (int)((bits >> 23) & 0xFF) - 127;
+  bits = (bits & 0x007FFFFF) | 0x3F800000;
+  float m;
+  std::memcpy(&m, &bits, sizeof(float));
+  int large = m > 1.41421356f;
+  m *= 1.0f - 0.5f * (float)large;
+  e += large;
+
+  // log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172
+  float s = (m - 1.0f) / (m + 1.0f);
+  float s2 = s * s;
+  float p = 1.0f / 9.0f;
+  p = p * s2 + 1.0f / 7.0f;
+  p = p * s2 + 1.0f / 5.0f;
+  p = p * s2 + 1.0f / 3.0f;
+  p = p * s2 + 1.0f;
+  return 2.0f * s * p + (float)e * 0.69314718f;
+}
+
+FORCE_INLINE float sqrtApprox(float x) {
+  // x * rsqrt(x) with Newton steps (sqrtf might not vectorize because of errno)
+  x += 1e-30f; // x >= 0
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(float));
+  bits = 0x5F375A86 - (bits >> 1);
+  float y;
+  std::memcpy(&y, &bits, sizeof(float));
+  y = y * (1.5f - 0.5f * x * y * y);
+  y = y * (1.5f - 0.5f * x * y * y);
+  y = y * (1.5f - 0.5f * x * y * y);
+  return x * y;
+}
+
+FORCE_INLINE void sinCos2PiApprox(float u, float &sin_value, float &cos_value) {
+  // phi = 2 pi (u - 0.5) / 4 in [-pi/4, pi/4) and then twice the double angle
+  // formula. Result is the sincos of 2 pi u - pi (that is both negated),
+  // which does not matter for the Gaussian samples
+  float phi = (u - 0.5f) * 1.57079633f;
+  float p2 = phi * phi;
+  float s = 1.0f / 362880.0f;
+  s = s * p2 - 1.0f / 5040.0f;
+  s = s * p2 + 1.0f / 120.0f;
+  s = s * p2 - 1.0f / 6.0f;
+  s = (s * p2 + 1.0f) * phi;
+  float c = -1.0f / 3628800.0f;
+  c = c * p2 + 1.0f / 40320.0f;
+  c = c * p2 - 1.0f / 720.0f;
+  c = c * p2 + 1.0f / 24.0f;
+  c = c * p2 - 0.5f;
+  c = c * p2 + 1.0f;
+
+  float s1 = 2.0f * s * c;
+  float c1 = c * c - s * s;
+  sin_value = 2.0f * s1 * c1;
+  cos_value = c1 * c1 - s1 * s1;
+}
+
+} // namespace
+
+template <typename T> void RNG<T>::fillGauss(T *values, int size) {
+  // Box-Muller on fresh uniform pairs (no list lookup), computed in
+  // blocks so that the transform runs vectorized
+  float u1[RPU_GAUSS_BLOCK];
+  float u2[RPU_GAUSS_BLOCK];
+  float z1[RPU_GAUSS_BLOCK];
+  float z2[RPU_GAUSS_BLOCK];
+  const float scale = 1.0f / 16777216.0f; // 2^-24
+  const int n_lanes = Xoshiro128Lanes::n_lanes;
+  uint32_t r1[n_lanes];
+  uint32_t r2[n_lanes];
+
+  if (!lanes_seeded_) {
+    lanes_.setSeed(engine_);
+    lanes_seeded_ = true;
+  }
+
+  for (int i_start = 0; i_start < size; i_start += 2 * RPU_GAUSS_BLOCK) {
+    int n = MIN(size - i_start, 2 * RPU_GAUSS_BLOCK);
+    int n_pairs = (n + 1) / 2;
+
+    for (int k0 = 0; k0 < n_pairs; k0 += n_lanes) {
+      lanes_.next(r1);
+      lanes_.next(r2);
+      PRAGMA_SIMD
+      for (int k = 0; k < n_lanes; ++k) {
+        // u1 in (0, 1] to avoid log(0)
+        u1[k0 + k] = (float)((r1[k] >> 8) + 1) * scale;
+        u2[k0 + k] = (float)(r2[k] >> 8) * scale;
+      }
+    }
+
+    PRAGMA_SIMD
+    for (int k = 0; k < n_pairs; ++k) {
+      float r = sqrtApprox(-2.0f * logApprox(u1[k]));
+      float sin_value, cos_value;
+      sinCos2PiApprox(u2[k], sin_value, cos_value);
+      z1[k] = r * cos_value;
+      z2[k] = r * sin_value;
+    }
+
+    T *v = values + i_start;
+    for (int k = 0; k < n_pairs; ++k) {
+      v[k] = (T)z1[k];
+    }
+    v += n_pairs;
+    for (int k = 0; k < n - n_pairs; ++k) {
+      v[k] = (T)z2[k];
+    }
+  }
+}
+#undef RPU_GAUSS_BLOCK
+
 template <typename T> void RNG<T>::generateNewList() { generateNewList(gauss_list_size_); }
 template <typename T> void RNG<T>::generateNewList(int list_size) {
 #ifdef RPU_USE_FASTMOD
@@ -104,6 +248,7 @@ template <typename T> void RNG<T>::generateNewList(int list_size) {
     RPU_FATAL("Fast mode needs constant list size (" << FIXED_LIST_SIZE << ") got: " << list_size);
   }
 #endif
+  state_version_++;
   unsigned long long seed = seed_;
   if (seed == 0) {
     seed = (unsigned long long)std::chrono::high_resolution_clock::now().time_since_epoch().count();
@@ -112,18 +257,16 @@ template <typename T> void RNG<T>::generateNewList(int list_size) {
   std::normal_distribution<float> random_dist{};
   auto nrnd = std::bind(random_dist, generator);
 
-  float *numbers = new float[list_size];
+  // new list (substreams might still hold the old one)
+  auto numbers = std::make_shared<std::vector<float>>(list_size);
 
   for (int i = 0; i < list_size; ++i) {
-    numbers[i] = nrnd();
-  }
-
-  if (gauss_numbers_list_ != nullptr) {
-    delete[] gauss_numbers_list_;
+    (*numbers)[i] = nrnd();
   }
 
   gauss_list_size_ = list_size;
-  gauss_numbers_list_ = numbers;
+  gauss_list_ = numbers;
+  gauss_numbers_list_ = gauss_list_->data();
 }
 
 template class RNG<float>;
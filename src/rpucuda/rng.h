@@ -19,33 +19,119 @@
 #include <iostream>
 #include <memory>
 #include <random>
+#include <stdint.h>
 #include <time.h>
+#include <vector>
 
+// FASTRAND: only lower 15 bits are used for the uniform numbers
 #ifdef RPU_USE_FASTRAND
 #define RPU_MAX_RAND_RANGE 0x7FFF
-#define RANDFUN fastrand
-#include <stdint.h>
 typedef int_fast16_t randomint_t;
 #else
-#define RANDFUN rand
-#define RPU_MAX_RAND_RANGE RAND_MAX
+#define RPU_MAX_RAND_RANGE 0xFFFFFF
 typedef int randomint_t;
 #endif
 
-// NEED TO BE 0x7FFF for FASTRAND!!!
+// NEED TO BE 0x7FFF for FASTMOD!!!
 #define FIXED_LIST_SIZE 32768
 #define FIXED_LIST_SIZE_MSK 0x7FFF
 namespace RPU {
 
-static randomint_t g_seed;
+/* xoshiro128++ generator (Blackman & Vigna) with jump ahead. The
+   state is kept per object so that each RNG (tile) has its own
+   reproducible stream instead of sharing the global rand() state.
+   Jump advances by 2^64 draws, which is used to split independent
+   substreams, e.g. for threads. */
+class Xoshiro128 {
+public:
+  explicit Xoshiro128(uint64_t seed) { setSeed(seed); };
+  Xoshiro128() : Xoshiro128(0){};
+
+  void setSeed(uint64_t seed) {
+    // splitmix64 to fill the state
+    for (int i = 0; i < 4; i += 2) {
+      uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      z = z ^ (z >> 31);
+      s_[i] = (uint32_t)z;
+      s_[i + 1] = (uint32_t)(z >> 32);
+    }
+  };
+
+  FORCE_INLINE uint32_t next() {
+    const uint32_t result = rotl(s_[0] + s_[3], 7) + s_[0];
+    const uint32_t t = s_[1] << 9;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = rotl(s_[3], 11);
+    return result;
+  };
+
+  void jump() {
+    static const uint32_t jump_poly[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+    uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+      for (int b = 0; b < 32; b++) {
+        if (jump_poly[i] & ((uint32_t)1 << b)) {
+          s0 ^= s_[0];
+          s1 ^= s_[1];
+          s2 ^= s_[2];
+          s3 ^= s_[3];
+        }
+        next();
+      }
+    }
+    s_[0] = s0;
+    s_[1] = s1;
+    s_[2] = s2;
+    s_[3] = s3;
+  };
 
-// Used to seed the generator.
-inline void fast_srand(randomint_t seed) { g_seed = seed; }
-// fastrand routine returns one integer, similar output value range as C lib.
-inline randomint_t fastrand() {
-  g_seed = (214013 * g_seed + 2531011);
-  return (g_seed >> 16) & 0x7FFF;
-}
+private:
+  static FORCE_INLINE uint32_t rotl(const uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+  uint32_t s_[4] = {0, 0, 0, 0};
+};
+
+/* Several interleaved xoshiro128++ streams, so that the generation
+   of a whole block of random numbers can be vectorized. Lanes are
+   seeded (via splitmix64) from a scalar generator. */
+class Xoshiro128Lanes {
+public:
+  static const int n_lanes = 8;
+
+  void setSeed(Xoshiro128 &source) {
+    for (int k = 0; k < n_lanes; k++) {
+      uint64_t seed = ((uint64_t)source.next() << 32) | source.next();
+      Xoshiro128 lane(seed);
+      for (int i = 0; i < 4; i++) {
+        s_[i][k] = lane.next();
+      }
+    }
+  };
+
+  // draws n_lanes numbers at once
+  FORCE_INLINE void next(uint32_t *result) {
+    PRAGMA_SIMD
+    for (int k = 0; k < n_lanes; k++) {
+      uint32_t x = s_[0][k] + s_[3][k];
+      result[k] = ((x << 7) | (x >> 25)) + s_[0][k];
+      const uint32_t t = s_[1][k] << 9;
+      s_[2][k] ^= s_[0][k];
+      s_[3][k] ^= s_[1][k];
+      s_[1][k] ^= s_[2][k];
+      s_[0][k] ^= s_[3][k];
+      s_[2][k] ^= t;
+      s_[3][k] = (s_[3][k] << 11) | (s_[3][k] >> 21);
+    }
+  };
+
+private:
+  uint32_t s_[4][n_lanes] = {};
+};
 
 /* this is used for construction (populate device) */
 template <typename T> class RealWorldRNG {
@@ -86,7 +172,12 @@ public:
     using std::swap;
     swap(a.gauss_list_size_, b.gauss_list_size_);
     swap(a.seed_, b.seed_);
+    swap(a.gauss_list_, b.gauss_list_);
     swap(a.gauss_numbers_list_, b.gauss_numbers_list_);
+    swap(a.engine_, b.engine_);
+    swap(a.lanes_, b.lanes_);
+    swap(a.lanes_seeded_, b.lanes_seeded_);
+    swap(a.state_version_, b.state_version_);
   }
 
   void generateNewList();
@@ -95,38 +186,60 @@ public:
   void randomizeSeed();
   void setSeed(unsigned int seed);
 
-  FORCE_INLINE randomint_t sample() { return RANDFUN(); }
+  /* Splits off n independent substreams (2^64 draws apart, sharing
+     the gauss list) e.g. to be used in parallel loops, one per work
+     item so that results do not depend on the number of threads. The
+     own state is advanced beyond all substreams.*/
+  void getSubstreams(std::vector<RNG<T>> &substreams, int n);
+
+  /* changes whenever the seed or the gauss list is renewed (e.g. to
+     know when split off substreams are outdated) */
+  inline uint64_t getStateVersion() const { return state_version_; };
 
-  FORCE_INLINE T sampleUniform() { return (float)RANDFUN() / (float)RPU_MAX_RAND_RANGE; }
+  /* bulk versions. Note that fillGauss draws fresh (vectorized
+     Box-Muller) Gaussian numbers instead of using the gauss list */
+  void fillUniform(T *values, int size);
+  void fillGauss(T *values, int size);
+
+  FORCE_INLINE randomint_t sample() { return (randomint_t)(engine_.next() & RPU_MAX_RAND_RANGE); }
+
+  // 64 uniformly random bits
+  FORCE_INLINE uint64_t sampleBits() {
+    return ((uint64_t)engine_.next() << 32) | (uint64_t)engine_.next();
+  }
+
+  FORCE_INLINE T sampleUniform() { return (float)sample() / (float)RPU_MAX_RAND_RANGE; }
 
   FORCE_INLINE T sampleUniform(float min_max) {
-    return (((float)RANDFUN() / (float)RPU_MAX_RAND_RANGE) - 0.5f) * 2.0f * min_max;
+    return (((float)sample() / (float)RPU_MAX_RAND_RANGE) - 0.5f) * 2.0f * min_max;
   }
 
   FORCE_INLINE T sampleUniform(float min_value, float max_value) {
-    return (((float)RANDFUN() / (float)RPU_MAX_RAND_RANGE) * (max_value - min_value)) + min_value;
+    return (((float)sample() / (float)RPU_MAX_RAND_RANGE) * (max_value - min_value)) + min_value;
   }
 
   FORCE_INLINE T sampleGauss() {
-#ifdef RPU_USE_FASTRAND
 #ifdef RPU_USE_FASTMOD
-    return gauss_numbers_list_[RANDFUN()]; // assume 0x7FFF for list size
+    return gauss_numbers_list_[engine_.next() & FIXED_LIST_SIZE_MSK];
 #else
-    return gauss_numbers_list_[RANDFUN() % gauss_list_size_];
-#endif
-#else
-#ifdef RPU_USE_FASTMOD
-    return gauss_numbers_list_[RANDFUN() & FIXED_LIST_SIZE_MSK];
-#else
-    return gauss_numbers_list_[RANDFUN() % gauss_list_size_];
-#endif
+    return gauss_numbers_list_[engine_.next() % (uint32_t)gauss_list_size_];
 #endif
   }
 
 private:
+  // substream: shares the list and starts at the current state of parent
+  struct SubstreamTag {};
+  RNG(const RNG<T> &parent, SubstreamTag);
+
   int gauss_list_size_;
   unsigned int seed_;
+  std::shared_ptr<std::vector<float>> gauss_list_ = nullptr;
   float *gauss_numbers_list_ = nullptr;
+  Xoshiro128 engine_;
+  // vectorized streams for the bulk versions (seeded from engine_ on first use)
+  Xoshiro128Lanes lanes_;
+  bool lanes_seeded_ = false;
+  uint64_t state_version_ = 0;
 };
 
 } // namespace RPU
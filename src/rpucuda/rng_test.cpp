@@ -0,0 +1,216 @@
+/**
+ * (C) Copyright 2020, 2021, 2022, 2023, 2024 IBM. All Rights Reserved.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#include "rng.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using namespace RPU;
+
+std::vector<uint32_t> draw(Xoshiro128 &engine, int n) {
+  std::vector<uint32_t> values(n);
+  for (auto &v : values) {
+    v = engine.next();
+  }
+  return values;
+}
+
+std::vector<randomint_t> draw(RNG<num_t> &rng, int n) {
+  std::vector<randomint_t> values(n);
+  for (auto &v : values) {
+    v = rng.sample();
+  }
+  return values;
+}
+
+/* whether the (short) window appears anywhere in the sequence */
+bool overlaps(const std::vector<uint32_t> &sequence, const std::vector<uint32_t> &window) {
+  return std::search(sequence.begin(), sequence.end(), window.begin(), window.end()) !=
+         sequence.end();
+}
+
+TEST(Xoshiro128Test, SameSeedSameSequence) {
+
+  Xoshiro128 engine1(1234), engine2(1234), engine3(1235);
+  std::vector<uint32_t> values1 = draw(engine1, 1000);
+  ASSERT_EQ(values1, draw(engine2, 1000));
+  ASSERT_NE(values1, draw(engine3, 1000));
+
+  // re-seeding restarts the sequence
+  engine1.setSeed(1234);
+  ASSERT_EQ(values1, draw(engine1, 1000));
+
+  RNG<num_t> rng1(17), rng2(17), rng3(18);
+  std::vector<randomint_t> samples1 = draw(rng1, 1000);
+  ASSERT_EQ(samples1, draw(rng2, 1000));
+  ASSERT_NE(samples1, draw(rng3, 1000));
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(rng1.sampleGauss(), rng2.sampleGauss());
+  }
+}
+
+TEST(Xoshiro128Test, JumpNonOverlapping) {
+
+  int n = 100000;
+  Xoshiro128 engine(99);
+  std::vector<uint32_t> sequence = draw(engine, n);
+
+  // jumped streams are reproducible
+  Xoshiro128 jumped1(99), jumped2(99);
+  jumped1.jump();
+  jumped2.jump();
+  std::vector<uint32_t> window = draw(jumped1, 8);
+  ASSERT_EQ(window, draw(jumped2, 8));
+
+  // and do not overlap with the beginning of the original stream
+  ASSERT_FALSE(overlaps(sequence, window));
+  std::vector<uint32_t> own_window(sequence.begin() + 500, sequence.begin() + 508);
+  ASSERT_TRUE(overlaps(sequence, own_window));
+
+  // neither with the following jumps
+  jumped1.jump();
+  ASSERT_FALSE(overlaps(sequence, draw(jumped1, 8)));
+}
+
+TEST(RNGTest, SubstreamsReproducible) {
+
+  int n_streams = 4;
+  int n = 10000;
+  RNG<num_t> rng1(5), rng2(5);
+  std::vector<RNG<num_t>> substreams1, substreams2;
+  rng1.getSubstreams(substreams1, n_streams);
+  rng2.getSubstreams(substreams2, 2 * n_streams);
+  ASSERT_EQ(substreams1.size(), n_streams);
+  ASSERT_EQ(substreams2.size(), 2 * n_streams);
+
+  // same streams independent of the number of streams split off
+  std::vector<std::vector<randomint_t>> samples(n_streams);
+  for (int k = 0; k < n_streams; k++) {
+    samples[k] = draw(substreams1[k], n);
+    ASSERT_EQ(samples[k], draw(substreams2[k], n)) << k;
+  }
+
+  // first substream continues the parent state, the parent itself is
+  // advanced beyond all substreams
+  RNG<num_t> rng3(5);
+  ASSERT_EQ(samples[0], draw(rng3, n));
+  std::vector<randomint_t> parent_samples = draw(rng1, n);
+
+  // substreams are non-overlapping
+  std::vector<std::vector<randomint_t>> windows(samples);
+  windows.push_back(parent_samples);
+  for (size_t k = 0; k < windows.size(); k++) {
+    std::vector<randomint_t> window(windows[k].begin(), windows[k].begin() + 8);
+    for (size_t l = 0; l < windows.size(); l++) {
+      if (k != l) {
+        ASSERT_TRUE(
+            std::search(windows[l].begin(), windows[l].end(), window.begin(), window.end()) ==
+            windows[l].end())
+            << k << " in " << l;
+      }
+    }
+  }
+}
+
+TEST(RNGTest, SubstreamsIndependentOfThreads) {
+
+  int n_items = 16;
+  int n = 1000;
+  std::vector<std::vector<num_t>> results;
+
+  for (int n_threads : {1, 2, 3, 8}) {
+    RNG<num_t> rng(11);
+    std::vector<RNG<num_t>> substreams;
+    rng.getSubstreams(substreams, n_items);
+
+    // one substream per work item
+    std::vector<num_t> values(n_items * n);
+#pragma omp parallel for num_threads(n_threads) schedule(dynamic)
+    for (int i_item = 0; i_item < n_items; i_item++) {
+      for (int i = 0; i < n; i++) {
+        values[i_item * n + i] = substreams[i_item].sampleUniform();
+      }
+    }
+    results.push_back(values);
+  }
+  for (size_t k = 1; k < results.size(); k++) {
+    ASSERT_EQ(results[0], results[k]) << k;
+  }
+}
+
+/* checks the moments and the tail mass against N(0, 1) */
+void checkStandardNormal(const std::vector<num_t> &values) {
+
+  double n = (double)values.size();
+  double mean = 0.0, m2 = 0.0, m4 = 0.0;
+  double n_beyond3 = 0, n_beyond4 = 0;
+  for (num_t v : values) {
+    ASSERT_TRUE(std::isfinite(v));
+    mean += v;
+    m2 += (double)v * v;
+    m4 += (double)v * v * v * v;
+    n_beyond3 += fabs(v) > 3.0;
+    n_beyond4 += fabs(v) > 4.0;
+  }
+  mean /= n;
+  double var = m2 / n - mean * mean;
+  double kurtosis = m4 / n / (var * var);
+
+  // about 5 standard errors
+  EXPECT_NEAR(mean, 0.0, 5.0 / sqrt(n));
+  EXPECT_NEAR(var, 1.0, 5.0 * sqrt(2.0 / n));
+  EXPECT_NEAR(kurtosis, 3.0, 5.0 * sqrt(96.0 / n));
+
+  // P(|z| > 3) and P(|z| > 4) of the standard normal
+  double expected3 = 2.699796e-3 * n;
+  double expected4 = 6.334248e-5 * n;
+  EXPECT_NEAR(n_beyond3, expected3, 5.0 * sqrt(expected3));
+  EXPECT_NEAR(n_beyond4, expected4, 5.0 * sqrt(expected4));
+}
+
+TEST(RNGTest, FillGaussDistribution) {
+
+  // not a multiple of the block size (odd tail)
+  int size = 2000000 + 37;
+  RNG<num_t> rng(3);
+  std::vector<num_t> values(size, std::numeric_limits<num_t>::quiet_NaN());
+  rng.fillGauss(values.data(), size);
+  checkStandardNormal(values);
+}
+
+TEST(RNGTest, FillGaussTail) {
+
+  // only partial blocks
+  for (int size : {1, 2, 37, 127}) {
+    RNG<num_t> rng(4);
+    std::vector<num_t> values;
+    std::vector<num_t> block(size);
+    while (values.size() < 1000000) {
+      std::fill(block.begin(), block.end(), std::numeric_limits<num_t>::quiet_NaN());
+      rng.fillGauss(block.data(), size);
+      values.insert(values.end(), block.begin(), block.end());
+    }
+    checkStandardNormal(values);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -37,6 +37,13 @@ extern "C" {
 #endif
 #endif
 
+// minimal number of elements for parallel indexed copies
+#define RPU_INDEXED_OMP_MIN_SIZE 32768
+// weights per (parallel) block of the flicker noise process
+#define RPU_FLICKER_BLOCK_SIZE 16384
+// bits of the fixed point flicker trap probabilities
+#define RPU_FLICKER_PROB_BITS 32
+
 namespace RPU {
 
 template <typename T> void RPUAbstract<T>::printToStream(std::stringstream &ss) const {
@@ -379,6 +386,8 @@ template <typename T> RPUSimple<T> &RPUSimple<T>::operator=(RPUSimple<T> &&other
   delta_weights_extern_ = std::move(other.delta_weights_extern_);
 
   fb_weight_modifier_ = std::move(other.fb_weight_modifier_);
+  weight_generation_ = other.weight_generation_;
+  fb_modify_count_ = other.fb_modify_count_;
 
   temp_x_vector_bias_ = other.temp_x_vector_bias_;
   temp_x_matrix_bias_ = other.temp_x_matrix_bias_;
@@ -455,6 +464,8 @@ template <typename T> void RPUSimple<T>::dumpExtra(RPU::state_t &extra, const st
 template <typename T>
 void RPUSimple<T>::loadExtra(const RPU::state_t &extra, const std::string prefix, bool strict) {
 
+  this->bumpWeightGeneration();
+
   using V = std::vector<T>;
   auto state = RPU::selectWithPrefix(extra, prefix);
 
@@ -555,6 +566,7 @@ void RPUSimple<T>::backward(
 template <typename T>
 void RPUSimple<T>::update(
     const T *X_input, const T *D_input, bool bias, int m_batch, bool x_trans, bool d_trans) {
+  this->bumpWeightGeneration();
   last_update_m_batch_ = m_batch; // this is mini-batchsize * reuse_factor !
 
   // update weights
@@ -622,6 +634,7 @@ void RPUSimple<T>::backwardMatrix(
 template <typename T>
 void RPUSimple<T>::updateMatrix(
     const T *X_input, const T *D_input, int m_batch, bool x_trans, bool d_trans) {
+  this->bumpWeightGeneration();
   RPU::math::gemm<T>(
       CblasRowMajor, d_trans ? CblasNoTrans : CblasTrans, x_trans ? CblasTrans : CblasNoTrans,
       this->d_size_, // M
@@ -702,6 +715,7 @@ void RPUSimple<T>::backwardVector(const T *d_input, T *x_output, int d_inc, int
 
 template <typename T>
 void RPUSimple<T>::updateVector(const T *x_input, const T *d_input, int x_inc, int d_inc) {
+  this->bumpWeightGeneration();
   DEBUG_OUT("RPU::updateVector. LR " << -this->getAlphaLearningRate());
 
   if (!this->getDeltaWeights()) {
@@ -820,6 +834,7 @@ void RPUSimple<T>::backwardTensor(
 template <typename T>
 void RPUSimple<T>::updateTensor(
     const T *X_input, const T *D_input, bool bias, int m_batch, int dim3, bool trans) {
+  this->bumpWeightGeneration();
   if ((dim3 == 1) || (!trans))
     this->update(X_input, D_input, bias, m_batch * dim3, trans, trans);
   else {
@@ -867,75 +882,59 @@ void RPUSimple<T>::copyIndexedInput(
   // all other RPUs just use the RPU/RPUCudaSimple::copyIndexed
   // and forwardIndex without the need to implement anything new.
 
-  int m = m_batch;
-  int input_matrix_size = total_input_size / dim3;
-  int M = m_batch * size;
-  int sz_all = size * m_batch * dim3;
+  // index 0 and 1 are constant zero and one (padding and bias),
+  // others are shifted by 2
+#define RPU_INDEXED_COPY_VALUE(J_SHIFTED, SRC)                                                     \
+  (((J_SHIFTED) <= 1) ? (T)(J_SHIFTED) : (SRC)[(J_SHIFTED)-2])
 
+  int input_matrix_size = total_input_size / dim3;
   bool batch_slice = m_batch_slice > 0;
+  int m = batch_slice ? m_batch_slice : m_batch;
+  bool use_omp = size * m * dim3 >= RPU_INDEXED_OMP_MIN_SIZE;
+  UNUSED(use_omp);
 
   if (trans) {
-    // here we additioanlly permute 132
-    if (batch_slice) {
-      sz_all = size * m_batch_slice * dim3;
-      M = m_batch_slice * dim3;
-
-      for (int idx = 0; idx < sz_all; idx++) {
-
-        int i_dim3 = (idx % M) / m_batch_slice;
-        int i_batch_slice = idx % m_batch_slice;
-        int i_xd = idx / M;
-        int batch_idx = batch_indices[i_batch_slice + m_batch * i_dim3];
-        int ind_idx = batch_idx + m_batch * i_xd;
-
-        int j_shifted = indices_shifted[ind_idx];
-        out_tensor[idx] = (j_shifted <= 1)
-                              ? (T)j_shifted
-                              : src_tensor[(j_shifted - 2) + i_dim3 * input_matrix_size];
-      }
-    } else {
-
-      int L = m_batch * dim3;
-
-      for (int idx = 0; idx < sz_all; idx++) {
-
-        int i = (idx % L) / m * M + (idx % m) + idx / L * m;
-        int j_shifted = indices_shifted[i % M];
-        out_tensor[idx] = (j_shifted <= 1)
-                              ? (T)j_shifted
-                              : src_tensor[(j_shifted - 2) + i / M * input_matrix_size];
+    // here we additioanlly permute 132: out is [size, dim3, m]
+#pragma omp parallel for collapse(2) if (use_omp)
+    for (int i_xd = 0; i_xd < size; i_xd++) {
+      for (int i_dim3 = 0; i_dim3 < dim3; i_dim3++) {
+
+        const T *src = src_tensor + i_dim3 * input_matrix_size;
+        const int *indices = indices_shifted + i_xd * m_batch;
+        T *out = out_tensor + (i_xd * dim3 + i_dim3) * m;
+
+        if (batch_slice) {
+          const int *b_indices = batch_indices + m_batch * i_dim3;
+          for (int i_batch = 0; i_batch < m; i_batch++) {
+            int j_shifted = indices[b_indices[i_batch]];
+            out[i_batch] = RPU_INDEXED_COPY_VALUE(j_shifted, src);
+          }
+        } else {
+          for (int i_batch = 0; i_batch < m; i_batch++) {
+            int j_shifted = indices[i_batch];
+            out[i_batch] = RPU_INDEXED_COPY_VALUE(j_shifted, src);
+          }
+        }
       }
     }
-  } else { // no trans
-    if (batch_slice) {
-
-      sz_all = size * m_batch_slice * dim3;
-      M = m_batch_slice * size;
-
-      for (int idx = 0; idx < sz_all; idx++) {
-
-        int i_dim3 = idx / M;
-        int i_batch_slice = (idx % M) / size;
-        int i_xd = idx % size;
-        int batch_idx = batch_indices[i_batch_slice + m_batch * i_dim3];
-        int ind_idx = batch_idx * size + i_xd;
-
-        int j_shifted = indices_shifted[ind_idx];
-        out_tensor[idx] = (j_shifted <= 1)
-                              ? (T)j_shifted
-                              : src_tensor[(j_shifted - 2) + i_dim3 * input_matrix_size];
-      }
-    } else {
-
-      for (int idx = 0; idx < sz_all; idx++) {
-
-        int j_shifted = indices_shifted[idx % M];
-        out_tensor[idx] = (j_shifted <= 1)
-                              ? (T)j_shifted
-                              : src_tensor[(j_shifted - 2) + idx / M * input_matrix_size];
+  } else { // no trans: out is [dim3, m, size]
+#pragma omp parallel for collapse(2) if (use_omp)
+    for (int i_dim3 = 0; i_dim3 < dim3; i_dim3++) {
+      for (int i_batch = 0; i_batch < m; i_batch++) {
+
+        const T *src = src_tensor + i_dim3 * input_matrix_size;
+        int batch_idx = batch_slice ? batch_indices[i_batch + m_batch * i_dim3] : i_batch;
+        const int *indices = indices_shifted + batch_idx * size;
+        T *out = out_tensor + (i_dim3 * m + i_batch) * size;
+
+        for (int i_xd = 0; i_xd < size; i_xd++) {
+          int j_shifted = indices[i_xd];
+          out[i_xd] = RPU_INDEXED_COPY_VALUE(j_shifted, src);
+        }
       }
     }
   }
+#undef RPU_INDEXED_COPY_VALUE
 }
 
 template <typename T>
@@ -950,68 +949,46 @@ void RPUSimple<T>::copyIndexedOutput(
     const bool trans,
     const int m_batch_slice,
     const int *batch_indices) {
-  bool batch_slice = m_batch_slice > 0;
 
-  // output iterator
-  int m = m_batch;
+  // the indices of one output matrix might overlap (accumulation),
+  // thus only parallel over dim3 (in the same order per output)
   int output_matrix_size = total_output_size / dim3;
-  int M = m_batch * size;
-  int sz_all = size * m_batch * dim3;
-
-  if (trans) {
-    // here we additionally permute 132
-
-    if (batch_slice) {
-      sz_all = size * m_batch_slice * dim3;
-      M = m_batch_slice * dim3;
-
-      for (int idx = 0; idx < sz_all; idx++) {
-
-        int i_dim3 = (idx % M) / m_batch_slice;
-        int i_batch_slice = idx % m_batch_slice;
-        int i_xd = idx / M;
-        int batch_idx = batch_indices[i_batch_slice + m_batch * i_dim3];
-        int ind_idx = batch_idx + m_batch * i_xd;
-
-        int j_shifted = indices_shifted[ind_idx];
-        if (j_shifted > 1)
-          out_tensor[(j_shifted - 2) + i_dim3 * output_matrix_size] += src_tensor[idx];
-      }
-
-    } else {
-
-      int L = m_batch * dim3;
-
-      for (int idx = 0; idx < sz_all; idx++) {
-        int i = (idx % L) / m * M + (idx % m) + idx / L * m;
-        int j_shifted = indices_shifted[i % M];
-        if (j_shifted > 1)
-          out_tensor[(j_shifted - 2) + i / M * output_matrix_size] += src_tensor[idx];
-      }
-    }
-  } else { // no trans
-    if (batch_slice) {
-      sz_all = size * m_batch_slice * dim3;
-      M = m_batch_slice * size;
-
-      for (int idx = 0; idx < sz_all; idx++) {
-
-        int i_dim3 = idx / M;
-        int i_batch_slice = (idx % M) / size;
-        int i_xd = idx % size;
-        int batch_idx = batch_indices[i_batch_slice + m_batch * i_dim3];
-        int ind_idx = batch_idx * size + i_xd;
-
-        int j_shifted = indices_shifted[ind_idx];
-        if (j_shifted > 1)
-          out_tensor[(j_shifted - 2) + i_dim3 * output_matrix_size] += src_tensor[idx];
+  bool batch_slice = m_batch_slice > 0;
+  int m = batch_slice ? m_batch_slice : m_batch;
+  bool use_omp = dim3 > 1 && size * m * dim3 >= RPU_INDEXED_OMP_MIN_SIZE;
+  UNUSED(use_omp);
+
+#pragma omp parallel for if (use_omp)
+  for (int i_dim3 = 0; i_dim3 < dim3; i_dim3++) {
+
+    T *out = out_tensor + i_dim3 * output_matrix_size;
+    const int *b_indices = batch_slice ? batch_indices + m_batch * i_dim3 : nullptr;
+
+    if (trans) {
+      // here we additionally permute 132: src is [size, dim3, m]
+      for (int i_xd = 0; i_xd < size; i_xd++) {
+        const int *indices = indices_shifted + i_xd * m_batch;
+        const T *src = src_tensor + (i_xd * dim3 + i_dim3) * m;
+
+        for (int i_batch = 0; i_batch < m; i_batch++) {
+          int j_shifted = indices[batch_slice ? b_indices[i_batch] : i_batch];
+          if (j_shifted > 1) {
+            out[j_shifted - 2] += src[i_batch];
+          }
+        }
       }
-
-    } else {
-      for (int idx = 0; idx < sz_all; idx++) {
-        int j_shifted = indices_shifted[idx % M];
-        if (j_shifted > 1)
-          out_tensor[(j_shifted - 2) + idx / M * output_matrix_size] += src_tensor[idx];
+    } else { // no trans: src is [dim3, m, size]
+      for (int i_batch = 0; i_batch < m; i_batch++) {
+        int batch_idx = batch_slice ? b_indices[i_batch] : i_batch;
+        const int *indices = indices_shifted + batch_idx * size;
+        const T *src = src_tensor + (i_dim3 * m + i_batch) * size;
+
+        for (int i_xd = 0; i_xd < size; i_xd++) {
+          int j_shifted = indices[i_xd];
+          if (j_shifted > 1) {
+            out[j_shifted - 2] += src[i_xd];
+          }
+        }
       }
     }
   }
@@ -1125,6 +1102,25 @@ void RPUSimple<T>::forwardIndexed(
 
   T *x_tensor = nullptr;
   T *d_tensor = nullptr;
+
+  if ((dim3 > 1) && this->hasSampleLocalForward()) {
+    // gather and compute image by image to keep the gathered input
+    // in cache (no need to materialize the full tensor nor to
+    // permute the output)
+    this->getTensorBuffer(&x_tensor, &d_tensor, m_batch, 1);
+
+    int input_matrix_size = total_input_size / dim3;
+    int output_matrix_size = this->getDSize() * m_batch;
+    for (int i_dim3 = 0; i_dim3 < dim3; i_dim3++) {
+      this->copyIndexedInput(
+          x_tensor, X_input + i_dim3 * input_matrix_size, input_matrix_size,
+          this->getMatrixIndices(), this->getXSize(), m_batch, 1, trans);
+      this->forwardMatrix(
+          x_tensor, D_output + i_dim3 * output_matrix_size, m_batch, trans, trans, is_test);
+    }
+    return;
+  }
+
   this->getTensorBuffer(&x_tensor, &d_tensor, m_batch, dim3);
 
   this->copyIndexedInput(
@@ -1219,6 +1215,7 @@ void RPUSimple<T>::backwardIndexedSlice(
 template <typename T>
 void RPUSimple<T>::updateIndexed(
     const T *X_input, const T *D_input, int total_x_input_size, int m_batch, int dim3, bool trans) {
+  this->bumpWeightGeneration();
   T *x_tensor = nullptr;
   T *d_tensor = nullptr;
 
@@ -1246,6 +1243,7 @@ void RPUSimple<T>::updateIndexedSlice(
     int m_batch_slice,
     const int *batch_indices) {
 
+  this->bumpWeightGeneration();
   T *x_tensor = nullptr;
   T *d_tensor = nullptr;
 
@@ -1265,6 +1263,7 @@ void RPUSimple<T>::updateIndexedSlice(
 /* delayed update using weight buffer*/
 
 template <typename T> void RPUSimple<T>::copyWeightsFromBuffer() {
+  this->bumpWeightGeneration();
   RPU::math::copy<T>(
       this->x_size_ * this->d_size_, this->getWeightsBuffer()[0], 1, this->getWeightsPtr()[0], 1);
 }
@@ -1295,6 +1294,7 @@ template <typename T> void RPUSimple<T>::applyDelayedWeights() {
 /* Set/Get weights related*/
 
 template <typename T> void RPUSimple<T>::setWeightsUniformRandom(T min_value, T max_value) {
+  this->bumpWeightGeneration();
   T **w = this->getWeightsPtr();
   for (int j = 0; j < this->x_size_; ++j) {
     for (int i = 0; i < this->d_size_; ++i) {
@@ -1304,6 +1304,7 @@ template <typename T> void RPUSimple<T>::setWeightsUniformRandom(T min_value, T
 }
 
 template <typename T> void RPUSimple<T>::setWeights(const T *weightsptr) {
+  this->bumpWeightGeneration();
   T *w = this->getWeightsPtr()[0];
   if (weightsptr != w) {
     int size = this->d_size_ * this->x_size_;
@@ -1380,6 +1381,7 @@ void RPUSimple<T>::setWeightsAndBias(
 }
 
 template <typename T> void RPUSimple<T>::setSharedWeights(T *weightsptr) {
+  this->bumpWeightGeneration();
   if (!shared_weights_if_) {
     this->getWeights(weightsptr); // copy existing weights to given workspace.
     delete[] *weights_;           // delete allocated memory array but not the pointer
@@ -1428,6 +1430,7 @@ template <typename T> void RPUSimple<T>::setAlphaScale(const T alpha) {
 template <typename T>
 void RPUSimple<T>::getAndResetWeightUpdate(T *prev_weight_and_dw_out, T scale) {
 
+  this->bumpWeightGeneration();
   T *w = this->getWeightsPtr()[0];
   int size = this->d_size_ * this->x_size_;
   PRAGMA_SIMD
@@ -1439,6 +1442,7 @@ void RPUSimple<T>::getAndResetWeightUpdate(T *prev_weight_and_dw_out, T scale) {
 }
 
 template <typename T> void RPUSimple<T>::applyWeightUpdate(T *dw_and_current_weight_out) {
+  this->bumpWeightGeneration();
   T *w = this->getWeightsPtr()[0];
   int size = this->d_size_ * this->x_size_;
   PRAGMA_SIMD
@@ -1553,6 +1557,7 @@ template <typename T> void RPUSimple<T>::setLearningRate(T lr) {
 
 template <typename T> void RPUSimple<T>::decayWeights(T alpha, bool bias_no_decay) {
 
+  this->bumpWeightGeneration();
   T lifetime = getPar().lifetime;
   T decay_rate = (lifetime > (T)1.0) ? ((T)1.0 / lifetime) : (T)0.0;
   T decay_scale = (T)1.0 - alpha * decay_rate;
@@ -1577,6 +1582,7 @@ template <typename T> void RPUSimple<T>::decayWeights(bool bias_no_decay) {
 }
 
 template <typename T> void RPUSimple<T>::driftWeights(T time_since_last_call) {
+  this->bumpWeightGeneration();
   if (!wdrifter_) {
     wdrifter_ = RPU::make_unique<WeightDrifter<T>>(
         this->x_size_ * this->d_size_, getPar().drift); // simpleDrift
@@ -1586,6 +1592,7 @@ template <typename T> void RPUSimple<T>::driftWeights(T time_since_last_call) {
 
 template <typename T> void RPUSimple<T>::clipWeights(T clip) {
 
+  this->bumpWeightGeneration();
   if (clip >= (T)0.0) {
     int size = this->d_size_ * this->x_size_;
     T *w = this->getWeightsPtr()[0];
@@ -1598,6 +1605,7 @@ template <typename T> void RPUSimple<T>::clipWeights(T clip) {
 
 template <typename T> void RPUSimple<T>::clipWeights(const WeightClipParameter &wclpar) {
 
+  this->bumpWeightGeneration();
   if (wclipper_ == nullptr) {
     wclipper_ = RPU::make_unique<WeightClipper<T>>(this->x_size_, this->d_size_);
   }
@@ -1606,6 +1614,7 @@ template <typename T> void RPUSimple<T>::clipWeights(const WeightClipParameter &
 
 template <typename T> void RPUSimple<T>::diffuseWeights() {
 
+  this->bumpWeightGeneration();
   T diffusion = getPar().diffusion;
   if (diffusion > (T)0.0) {
     int size = this->d_size_ * this->x_size_;
@@ -1652,8 +1661,53 @@ template <typename T> uint64_t *RPUSimple<T>::initFlickerStates() {
   return flicker_states_.data();
 }
 
+namespace {
+/* Bit-sliced Bernoulli masks of the trap probabilities: word k has
+   bit i set if the k-th binary digit (MSB first) of the fixed point
+   probability of trap i is set */
+template <typename T>
+void makeFlickerProbMasks(uint64_t *masks, const std::vector<T> &probs, const T scale) {
+  for (int k = 0; k < RPU_FLICKER_PROB_BITS; k++) {
+    masks[k] = 0;
+  }
+  for (size_t i = 0; i < probs.size(); i++) {
+    double p = MIN(MAX((double)probs[i] * (double)scale, 0.0), 1.0);
+    uint64_t p_fixed = (uint64_t)MIN(
+        p * (double)((uint64_t)1 << RPU_FLICKER_PROB_BITS),
+        (double)(((uint64_t)1 << RPU_FLICKER_PROB_BITS) - 1));
+    for (int k = 0; k < RPU_FLICKER_PROB_BITS; k++) {
+      masks[k] |= ((p_fixed >> (RPU_FLICKER_PROB_BITS - 1 - k)) & 1) << i;
+    }
+  }
+}
+
+/* All trap flips of one weight at once: each trap flips if its
+   (bit-sliced) uniform fixed point number is below its probability,
+   which is decided digit by digit for all traps in parallel. Only a
+   few random words are needed as each digit resolves half of the
+   still undecided traps on average */
+template <typename T>
+FORCE_INLINE uint64_t sampleFlickerFlips(
+    const uint64_t fls,
+    const uint64_t *masks_0to1,
+    const uint64_t *masks_1to0,
+    const uint64_t traps,
+    RNG<T> *rng) {
+  uint64_t less = 0;
+  uint64_t undecided = traps;
+  for (int k = 0; k < RPU_FLICKER_PROB_BITS && undecided; k++) {
+    uint64_t p_bits = (fls & masks_1to0[k]) | (~fls & masks_0to1[k]);
+    uint64_t u_bits = rng->sampleBits();
+    less |= undecided & ~u_bits & p_bits;
+    undecided &= ~(u_bits ^ p_bits);
+  }
+  return less;
+}
+} // namespace
+
 template <typename T> void RPUSimple<T>::diffuseWeightsPink() {
 
+  this->bumpWeightGeneration();
   ENFORCE_NO_DELAYED_UPDATE;
 
   T diffusion = getPar().diffusion;
@@ -1677,57 +1731,76 @@ template <typename T> void RPUSimple<T>::diffuseWeightsPink() {
   const uint64_t zero = 0;
   const uint64_t one = 1;
 
-  PRAGMA_SIMD
-  for (int j = 0; j < size; j++) {
-    uint64_t fls = flicker_states_[j];
+  int n_traps = (int)flicker_probs_.size();
+  uint64_t traps = n_traps >= 64 ? ~zero : ((one << (uint64_t)n_traps) - one);
+  uint64_t masks_0to1[RPU_FLICKER_PROB_BITS];
+  uint64_t masks_1to0[RPU_FLICKER_PROB_BITS]; // 1->0  therefore change prop to q1
+  makeFlickerProbMasks(masks_0to1, flicker_probs_, (T)1.0);
+  makeFlickerProbMasks(masks_1to0, flicker_probs_, sc);
+
+  auto diffuse_block = [&](int j_start, int j_end, RNG<T> *rng) -> void {
+    for (int j = j_start; j < j_end; j++) {
+      uint64_t fls = flicker_states_[j];
 #ifdef _MSC_VER
-    T last_noise_value = ((T)__popcnt64(fls));
+      T last_noise_value = ((T)__popcnt64(fls));
 #else
-    T last_noise_value = ((T)__builtin_popcountll(fls));
+      T last_noise_value = ((T)__builtin_popcountll(fls));
 #endif
-    if (flicker.wreset && (T)fabsf(w[j] - wb[j]) > flicker.wreset_tol) {
-
-      if (flicker.h > (T)0.0) {
-        // only reset 1's with prob 1-exp(-h/r^i)
-        for (int i = 0; i < flicker.n; i++) {
-          uint64_t cbit = one << (uint64_t)i;
-          fls ^= ((fls & cbit) > 0)
-                     ? ((rng_->sampleUniform() >= (T)expf(H * flicker_probs_[i])) ? cbit : zero)
-                     : zero; // use >= to get 1-exp
+      if (flicker.wreset && (T)fabsf(w[j] - wb[j]) > flicker.wreset_tol) {
+
+        if (flicker.h > (T)0.0) {
+          // only reset 1's with prob 1-exp(-h/r^i)
+          for (int i = 0; i < n_traps; i++) {
+            uint64_t cbit = one << (uint64_t)i;
+            fls ^= ((fls & cbit) > 0)
+                       ? ((rng->sampleUniform() >= (T)expf(H * flicker_probs_[i])) ? cbit : zero)
+                       : zero; // use >= to get 1-exp
+          }
+        } else {
+          // reset all with eq
+          fls = 0;
+          for (int i = 0; i < n_traps; i++) {
+            fls ^= (rng->sampleUniform() < flicker.q) ? (one << (uint64_t)i) : zero;
+          }
         }
       } else {
-        // reset all with eq
-        fls = 0;
-        for (int i = 0; i < flicker.n; i++) {
-          fls ^= (rng_->sampleUniform() < flicker.q) ? (one << (uint64_t)i) : zero;
-        }
+        fls ^= sampleFlickerFlips(fls, masks_0to1, masks_1to0, traps, rng);
       }
-    } else {
-      for (int i = 0; i < flicker.n; i++) {
-        T prob = flicker_probs_[i]; // based on flicker.q
-        uint64_t cbit = one << (uint64_t)i;
-        T stoch_value = rng_->sampleUniform();
-        fls ^= ((fls & cbit) > 0) ? ((stoch_value < prob * sc) ? cbit : zero)
-                                  :                      // 1->0  therefore change prop to q1
-                   ((stoch_value < prob) ? cbit : zero); // 0->1	q0
-      }
-    }
 #ifdef _MSC_VER
-    T noise_value = ((T)__popcnt64(fls));
+      T noise_value = ((T)__popcnt64(fls));
 #else
-    T noise_value = ((T)__builtin_popcountll(fls));
+      T noise_value = ((T)__builtin_popcountll(fls));
 #endif
-    w[j] += amp * (noise_value - last_noise_value);
-    flicker_states_[j] = fls;
-    if (flicker.wreset) {
-      wb[j] = w[j];
+      w[j] += amp * (noise_value - last_noise_value);
+      flicker_states_[j] = fls;
+      if (flicker.wreset) {
+        wb[j] = w[j];
+      }
+    }
+  };
+
+  // fixed blocks with their own random substreams, so that the
+  // result does not depend on the number of threads
+  int n_blocks = (size + RPU_FLICKER_BLOCK_SIZE - 1) / RPU_FLICKER_BLOCK_SIZE;
+  if (n_blocks > 1) {
+    std::vector<RNG<T>> rng_substreams;
+    rng_->getSubstreams(rng_substreams, n_blocks);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int i_block = 0; i_block < n_blocks; i_block++) {
+      int j_start = i_block * RPU_FLICKER_BLOCK_SIZE;
+      diffuse_block(
+          j_start, MIN(j_start + RPU_FLICKER_BLOCK_SIZE, size), &rng_substreams[i_block]);
     }
+  } else {
+    diffuse_block(0, size, &*rng_);
   }
 }
 
 template <typename T>
 bool RPUSimple<T>::swaWeights(
     const WeightRemapParameter &wrmpar, T *swa_weights, uint64_t iter, T *scales, T *biases) {
+  this->bumpWeightGeneration();
   if (wremapper_ == nullptr) {
     wremapper_ = RPU::make_unique<WeightRemapper<T>>(this->x_size_, this->d_size_);
   }
@@ -1738,6 +1811,7 @@ bool RPUSimple<T>::swaWeights(
 template <typename T>
 void RPUSimple<T>::remapWeights(const WeightRemapParameter &wrmpar, T *scales, T *biases) {
 
+  this->bumpWeightGeneration();
   if (wremapper_ == nullptr) {
     wremapper_ = RPU::make_unique<WeightRemapper<T>>(this->x_size_, this->d_size_);
   }
@@ -1751,8 +1825,14 @@ template <typename T> void RPUSimple<T>::modifyFBWeights(const WeightModifierPar
     fb_weight_modifier_ = RPU::make_unique<WeightModifier<T>>(this->x_size_, this->d_size_);
   }
 
+  if (fb_weight_modifier_->isCached(weight_generation_, wmpar)) {
+    // weights unchanged since last call: keep the modified FB weights
+    return;
+  }
+
   // modify FB weights
   fb_weight_modifier_->apply(fb_weights_[0], this->getWeightsPtr()[0], wmpar);
+  fb_modify_count_++;
 }
 
 /*********************************************************************************/
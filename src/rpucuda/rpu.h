@@ -243,6 +243,8 @@ public:
     swap(a.delta_weights_extern_, b.delta_weights_extern_);
 
     swap(a.fb_weight_modifier_, b.fb_weight_modifier_);
+    swap(a.weight_generation_, b.weight_generation_);
+    swap(a.fb_modify_count_, b.fb_modify_count_);
     swap(a.last_update_m_batch_, b.last_update_m_batch_);
 
     swap(a.bwd_alpha_, b.bwd_alpha_);
@@ -292,6 +294,11 @@ public:
 
   /* access to the CPU weight ptr*/
   inline T **getWeightsPtr() const { return this->weights_; };
+  inline uint64_t getWeightGeneration() const { return weight_generation_; };
+
+  /* version of the weights returned by getFBWeights. Changes
+     whenever the weights or the modified FB weights change */
+  inline uint64_t getFBWeightsVersion() const { return weight_generation_ + fb_modify_count_; };
   virtual T **getWeights() { return getWeightsPtr(); };
 
   /* get weights by copying weights to given pointer. Might
@@ -380,7 +387,13 @@ public:
      on the reference weights. Each call a new copied matrix will by
      generated based on the reference weights. Usually, during
      testing, the referenece weiight matrix is used instead (can be
-     selected by settiing wmpar appropriately).  */
+     selected by settiing wmpar appropriately).
+
+     If wmpar.cache_refresh_every is set, the modified weights are
+     reused as long as the weight generation (bumped by all weight
+     changing methods of the RPU) is unchanged. Note that direct
+     writes into the weight pointer (or shared weights) are not
+     tracked. */
   virtual void modifyFBWeights(const WeightModifierParameter<T> &wmpar);
 
   /* Delayed update support. If use_delayed_update is turned on when
@@ -544,6 +557,10 @@ protected:
   /* for beta GEMM during update. 0 means W=DW, 1 means W += DW */
   T getUpBeta() const;
 
+  /* whether forwardMatrix treats each sample of the batch
+     independently, so that a batch can be split (e.g. per image) */
+  virtual bool hasSampleLocalForward() const { return true; };
+
   /* This is to enable an additional weight buffer (for "delayed" update)*/
   virtual void copyWeightsFromBuffer();
   virtual void copyWeightsToBuffer();
@@ -684,6 +701,10 @@ protected:
   int last_update_m_batch_ = 1;
   bool use_delayed_update_ = false;
 
+  /* needs to be called whenever the weights are changed, so that
+     cached modified FB weights are invalidated */
+  inline void bumpWeightGeneration() { weight_generation_++; };
+
 private:
   std::vector<T *> delta_weights_extern_;
 
@@ -701,6 +722,8 @@ private:
   std::unique_ptr<WeightRemapper<T>> wremapper_ = nullptr;
   std::unique_ptr<WeightClipper<T>> wclipper_ = nullptr;
   std::unique_ptr<WeightModifier<T>> fb_weight_modifier_ = nullptr;
+  uint64_t weight_generation_ = 0;
+  uint64_t fb_modify_count_ = 0;
 
   int *matrix_indices_ = nullptr;
   bool matrix_indices_set_ = false;
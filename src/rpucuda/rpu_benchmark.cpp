@@ -0,0 +1,488 @@
+/**
+ * (C) Copyright 2020, 2021, 2022, 2023, 2024 IBM. All Rights Reserved.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#include "math_util.h"
+#include "rng.h"
+#include "rpu_constantstep_device.h"
+#include "rpu_expstep_device.h"
+#include "rpu_hidden_device.h"
+#include "rpu_linearstep_device.h"
+#include "rpu_mixedprec_device.h"
+#include "rpu_onesided_device.h"
+#include "rpu_piecewisestep_device.h"
+#include "rpu_powstep_device.h"
+#include "rpu_powstep_reference_device.h"
+#include "rpu_pulsed.h"
+#include "rpu_softbounds_reference_device.h"
+#include "rpu_transfer_device.h"
+#include "rpu_vector_device.h"
+#include "rpu_weight_updater.h"
+#include "sparse_bit_line_maker.h"
+#include "utility_functions.h"
+#include "weight_drifter.h"
+#include "weight_modifier.h"
+#include "benchmark/benchmark.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Micro-benchmarks of the CPU simulator hot paths. Throughput is
+// reported as MACs/s for the forward, as pulses/s for the update
+// (nominal pulse coincidences, i.e. desired_BL * x_size * d_size per
+// update) and the bit line maker (desired_BL * (x_size + d_size) per
+// call), and as elements/s (items_per_second) otherwise.
+//
+// Run e.g. with:
+//   ./rpu_benchmark --benchmark_filter=Forward --benchmark_format=json
+
+namespace {
+
+using namespace RPU;
+
+constexpr int N_DEVICE_TYPES = 16;
+constexpr int N_MODIFIER_TYPES = 8;
+
+void fillUniform(std::vector<num_t> &v, RealWorldRNG<num_t> &rng, num_t scale = 1.0) {
+  for (auto &value : v) {
+    value = scale * (2.0 * rng.sampleUniform() - 1.0);
+  }
+}
+
+void setRate(benchmark::State &state, const std::string &name, double per_iteration) {
+  state.counters[name] =
+      benchmark::Counter(per_iteration, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+ConstantStepRPUDeviceMetaParameter<num_t> getConstantStepParameter() {
+  ConstantStepRPUDeviceMetaParameter<num_t> dp;
+  dp.dw_min = 0.001;
+  dp.w_max = 1.0;
+  dp.w_min = -1.0;
+  return dp;
+}
+
+/* returns the device meta parameter for the given type index */
+std::unique_ptr<AbstractRPUDeviceMetaParameter<num_t>> createDeviceParameter(int type) {
+  auto dp_cs = getConstantStepParameter();
+
+  switch (type) {
+  case 0:
+    return RPU::make_unique<ConstantStepRPUDeviceMetaParameter<num_t>>(dp_cs);
+  case 1:
+    return RPU::make_unique<LinearStepRPUDeviceMetaParameter<num_t>>();
+  case 2:
+    return RPU::make_unique<SoftBoundsRPUDeviceMetaParameter<num_t>>();
+  case 3:
+    return RPU::make_unique<ExpStepRPUDeviceMetaParameter<num_t>>();
+  case 4:
+    return RPU::make_unique<PowStepRPUDeviceMetaParameter<num_t>>();
+  case 5:
+    return RPU::make_unique<PowStepReferenceRPUDeviceMetaParameter<num_t>>();
+  case 6: {
+    auto dp = RPU::make_unique<PiecewiseStepRPUDeviceMetaParameter<num_t>>();
+    dp->piecewise_up_vec = {1.5, 1.0, 0.5};
+    dp->piecewise_down_vec = {0.5, 1.0, 1.5};
+    return dp;
+  }
+  case 7:
+    return RPU::make_unique<SoftBoundsReferenceRPUDeviceMetaParameter<num_t>>();
+  case 8:
+    return RPU::make_unique<HiddenStepRPUDeviceMetaParameter<num_t>>();
+  case 9:
+    return RPU::make_unique<VectorRPUDeviceMetaParameter<num_t>>(dp_cs, 2);
+  case 10:
+    return RPU::make_unique<OneSidedRPUDeviceMetaParameter<num_t>>(dp_cs);
+  case 11: {
+    auto dp = RPU::make_unique<TransferRPUDeviceMetaParameter<num_t>>(dp_cs, 2);
+    dp->gamma = 0.0;
+    dp->transfer_every = 1;
+    return dp;
+  }
+  case 12: {
+    auto dp = RPU::make_unique<MixedPrecRPUDeviceMetaParameter<num_t>>();
+    dp->setDevicePar(dp_cs);
+    return dp;
+  }
+  // tabulated step responses
+  case 13: {
+    auto dp = RPU::make_unique<ExpStepRPUDeviceMetaParameter<num_t>>();
+    dp->es_lut_size = 64;
+    return dp;
+  }
+  case 14: {
+    auto dp = RPU::make_unique<PowStepRPUDeviceMetaParameter<num_t>>();
+    dp->ps_lut_size = 64;
+    return dp;
+  }
+  case 15: {
+    auto dp = RPU::make_unique<PowStepReferenceRPUDeviceMetaParameter<num_t>>();
+    dp->ps_lut_size = 64;
+    return dp;
+  }
+  default:
+    RPU_FATAL("Unknown device type index.");
+  }
+}
+
+/* exposes the tensor copies of RPUSimple */
+class RPUSimpleCopies : public RPUSimple<num_t> {
+public:
+  RPUSimpleCopies(int x_size, int d_size) : RPUSimple<num_t>(x_size, d_size){};
+  using RPUSimple<num_t>::copyIndexedInput;
+  using RPUSimple<num_t>::copyIndexedOutput;
+};
+
+/* the shifted indices of an im2col with 0 (padding) and 1 (bias)*/
+std::vector<int>
+makeIndices(int size, int m_batch, int input_matrix_size, RealWorldRNG<num_t> &rng) {
+  std::vector<int> indices(size * m_batch);
+  for (auto &index : indices) {
+    index = (int)(rng.sampleUniform() * (num_t)(input_matrix_size + 2));
+    index = MIN(index, input_matrix_size + 1);
+  }
+  return indices;
+}
+
+/* Forward of RPUPulsed. Args: x_size (= d_size), m_batch, is_perfect */
+void BM_RPUPulsedForward(benchmark::State &state) {
+  int size = state.range(0);
+  int m_batch = state.range(1);
+
+  PulsedMetaParameter<num_t> p;
+  p.f_io.is_perfect = state.range(2) > 0;
+  auto dp = getConstantStepParameter();
+
+  RPUPulsed<num_t> rpu(size, size);
+  rpu.populateParameter(&p, &dp);
+  rpu.setWeightsUniformRandom(-0.5, 0.5);
+
+  RealWorldRNG<num_t> rw_rng(0);
+  std::vector<num_t> x(size * m_batch);
+  std::vector<num_t> d(size * m_batch);
+  fillUniform(x, rw_rng);
+
+  for (auto _ : state) {
+    rpu.forward(x.data(), d.data(), false, m_batch, false, false, false);
+    benchmark::DoNotOptimize(d.data());
+  }
+  setRate(state, "MACs", (double)size * size * m_batch);
+}
+BENCHMARK(BM_RPUPulsedForward)
+    ->ArgNames({"size", "m_batch", "perfect"})
+    ->ArgsProduct({{64, 256, 512}, {1, 16, 128}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+/* Weight read-out through the analog forward. Args: x_size (= d_size), is_perfect */
+void BM_RPUPulsedGetWeightsReal(benchmark::State &state) {
+  int size = state.range(0);
+
+  PulsedMetaParameter<num_t> p;
+  p.f_io.is_perfect = state.range(1) > 0;
+  auto dp = getConstantStepParameter();
+
+  RPUPulsed<num_t> rpu(size, size);
+  rpu.populateParameter(&p, &dp);
+  rpu.setWeightsUniformRandom(-0.5, 0.5);
+
+  std::vector<num_t> w(size * size);
+  for (auto _ : state) {
+    rpu.getWeightsReal(w.data());
+    benchmark::DoNotOptimize(w.data());
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_RPUPulsedGetWeightsReal)
+    ->ArgNames({"size", "perfect"})
+    ->ArgsProduct({{256, 1024}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+/* Closed-loop weight programming with verify reads through the
+   analog forward. Args: x_size (= d_size), is_perfect */
+void BM_RPUPulsedSetWeightsReal(benchmark::State &state) {
+  int size = state.range(0);
+
+  PulsedMetaParameter<num_t> p;
+  p.f_io.is_perfect = state.range(1) > 0;
+  auto dp = getConstantStepParameter();
+  // all targets are reachable in time
+  dp.w_min_dtod = 0.0;
+  dp.w_max_dtod = 0.0;
+  dp.dw_min_dtod = 0.0;
+
+  RPUPulsed<num_t> rpu(size, size);
+  rpu.populateParameter(&p, &dp);
+  rpu.setLearningRate(1.0);
+
+  RealWorldRNG<num_t> rw_rng(0);
+  std::vector<num_t> w(size * size);
+  fillUniform(w, rw_rng, 0.5);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    rpu.setWeightsUniformRandom(-0.5, 0.5);
+    state.ResumeTiming();
+    rpu.setWeightsReal(w.data(), 1);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_RPUPulsedSetWeightsReal)
+    ->ArgNames({"size", "perfect"})
+    ->ArgsProduct({{64, 128}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+/* Single vector update of every device type. Args: device type, x_size (= d_size), pulse type
+   (0: StochasticCompressed (sparse), 1: DeterministicImplicit (dense)) */
+void BM_UpdateVectorWithDevice(benchmark::State &state) {
+  int type = state.range(0);
+  int size = state.range(1);
+
+  RealWorldRNG<num_t> rw_rng(0);
+  auto dp = createDeviceParameter(type);
+  std::unique_ptr<AbstractRPUDevice<num_t>> device(dp->createDevice(size, size, &rw_rng));
+  state.SetLabel(dp->getName());
+
+  num_t **weights = Array_2D_Get<num_t>(size, size);
+  for (int i = 0; i < size * size; i++) {
+    weights[0][i] = 0.1 * (2.0 * rw_rng.sampleUniform() - 1.0);
+  }
+  device->onSetWeights(weights);
+
+  PulsedUpdateMetaParameter<num_t> up;
+  up.desired_BL = 31;
+  up.update_management = true;
+  up.update_bl_management = false;
+  up.pulse_type =
+      state.range(2) > 0 ? PulseType::DeterministicImplicit : PulseType::StochasticCompressed;
+
+  PulsedRPUWeightUpdater<num_t> updater(size, size, std::make_shared<RNG<num_t>>(0));
+  updater.setUpPar(up);
+
+  std::vector<num_t> x(size);
+  std::vector<num_t> d(size);
+  fillUniform(x, rw_rng);
+  fillUniform(d, rw_rng);
+
+  for (auto _ : state) {
+    updater.updateVectorWithDevice(weights, x.data(), 1, d.data(), 1, 0.01, 1, &*device);
+    benchmark::ClobberMemory();
+  }
+  setRate(state, "pulses", (double)up.desired_BL * size * size);
+  Array_2D_Free<num_t>(weights);
+}
+BENCHMARK(BM_UpdateVectorWithDevice)
+    ->ArgNames({"device", "size", "dense"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, N_DEVICE_TYPES - 1, 1), {256}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+/* Stochastic pulse train generation. Args: x_size (= d_size), desired_BL */
+void BM_SparseBitLineMakerMakeCounts(benchmark::State &state) {
+  int size = state.range(0);
+
+  PulsedUpdateMetaParameter<num_t> up;
+  up.desired_BL = state.range(1);
+  up.update_management = true;
+  up.update_bl_management = false;
+  up.pulse_type = PulseType::StochasticCompressed;
+
+  SparseBitLineMaker<num_t> sblm(size, size);
+  RNG<num_t> rng(0);
+  RealWorldRNG<num_t> rw_rng(0);
+  std::vector<num_t> x(size);
+  std::vector<num_t> d(size);
+  fillUniform(x, rw_rng);
+  fillUniform(d, rw_rng);
+
+  int x_noz = 0;
+  int d_noz = 0;
+  for (auto _ : state) {
+    int BL = sblm.makeCounts(x.data(), 1, x_noz, d.data(), 1, d_noz, &rng, 0.01, 0.001, up);
+    benchmark::DoNotOptimize(BL);
+  }
+  setRate(state, "pulses", (double)up.desired_BL * (size + size));
+}
+BENCHMARK(BM_SparseBitLineMakerMakeCounts)
+    ->ArgNames({"size", "BL"})
+    ->ArgsProduct({{256, 1024}, {31, 255}})
+    ->Unit(benchmark::kMicrosecond);
+
+/* Weight drift with device-to-device variations. Args: x_size (= d_size) */
+void BM_WeightDrifterApply(benchmark::State &state) {
+  int size = state.range(0);
+
+  DriftParameter<num_t> par;
+  par.nu = 0.05;
+  par.nu_dtod = 0.1;
+  par.nu_std = 0.01;
+  par.nu_k = 0.01;
+  par.w_read_std = 0.01;
+
+  RealWorldRNG<num_t> rw_rng(0);
+  WeightDrifter<num_t> drifter(size * size, par, &rw_rng);
+  RNG<num_t> rng(0);
+
+  std::vector<num_t> w(size * size);
+  fillUniform(w, rw_rng, 0.5);
+
+  for (auto _ : state) {
+    drifter.apply(w.data(), 1.0, rng);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_WeightDrifterApply)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+/* 1/f flicker noise process (64 traps). Args: x_size (= d_size) */
+void BM_DiffuseWeightsPink(benchmark::State &state) {
+  int size = state.range(0);
+
+  SimpleMetaParameter<num_t> par;
+  par.diffusion = 0.001;
+  RPUSimple<num_t> rpu(size, size);
+  rpu.populateParameter(&par);
+  rpu.setWeightsUniformRandom(-0.5, 0.5);
+  rpu.initFlickerStates();
+
+  for (auto _ : state) {
+    rpu.diffuseWeightsPink();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_DiffuseWeightsPink)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+/* Simple weight drift (uniform nu, no noise). Args: x_size (= d_size) */
+void BM_WeightDrifterApplySimple(benchmark::State &state) {
+  int size = state.range(0);
+
+  DriftParameter<num_t> par;
+  par.nu = 0.05;
+
+  WeightDrifter<num_t> drifter(size * size, par);
+  RNG<num_t> rng(0);
+  RealWorldRNG<num_t> rw_rng(0);
+
+  std::vector<num_t> w(size * size);
+  fillUniform(w, rw_rng, 0.5);
+
+  for (auto _ : state) {
+    drifter.apply(w.data(), 1.0, rng);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_WeightDrifterApplySimple)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+/* Weight modifier of the given type (Copy is run with drop
+   connections). Args: modifier type, x_size (= d_size) */
+void BM_WeightModifierApply(benchmark::State &state) {
+  static const WeightModifierType types[N_MODIFIER_TYPES] = {
+      WeightModifierType::Copy,
+      WeightModifierType::Discretize,
+      WeightModifierType::MultNormal,
+      WeightModifierType::AddNormal,
+      WeightModifierType::DiscretizeAddNormal,
+      WeightModifierType::DoReFa,
+      WeightModifierType::Poly,
+      WeightModifierType::ProgNoise,
+  };
+  int size = state.range(1);
+
+  WeightModifierParameter<num_t> wmpar;
+  wmpar.type = types[state.range(0)];
+  wmpar.std_dev = 0.05;
+  wmpar.sto_round = true;
+  if (wmpar.type == WeightModifierType::Copy) {
+    wmpar.pdrop = 0.1;
+    state.SetLabel("DropConnect");
+  } else {
+    state.SetLabel(wmpar.getTypeName());
+  }
+
+  WeightModifier<num_t> modifier(size, size);
+  RealWorldRNG<num_t> rw_rng(0);
+  std::vector<num_t> w(size * size);
+  std::vector<num_t> new_w(size * size);
+  fillUniform(w, rw_rng, 0.5);
+
+  for (auto _ : state) {
+    modifier.apply(new_w.data(), w.data(), wmpar);
+    benchmark::DoNotOptimize(new_w.data());
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_WeightModifierApply)
+    ->ArgNames({"type", "size"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, N_MODIFIER_TYPES - 1, 1), {512}})
+    ->Unit(benchmark::kMicrosecond);
+
+/* Tensor permute of the convolution forward. Args: size, dim3, m_batch */
+void BM_Permute132(benchmark::State &state) {
+  int size = state.range(0);
+  int dim3 = state.range(1);
+  int m_batch = state.range(2);
+
+  RealWorldRNG<num_t> rw_rng(0);
+  std::vector<num_t> in(size * dim3 * m_batch);
+  std::vector<num_t> out(in.size());
+  fillUniform(in, rw_rng);
+
+  for (auto _ : state) {
+    math::permute132<num_t>(out.data(), in.data(), m_batch, size, dim3, false);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * in.size());
+  state.SetBytesProcessed(state.iterations() * in.size() * 2 * sizeof(num_t));
+}
+BENCHMARK(BM_Permute132)
+    ->ArgNames({"size", "dim3", "m_batch"})
+    ->ArgsProduct({{64, 576}, {16}, {196, 1024}})
+    ->Unit(benchmark::kMicrosecond);
+
+/* Indexed (im2col) gather and scatter. Args: size, dim3, m_batch, trans, output */
+void BM_CopyIndexed(benchmark::State &state) {
+  int size = state.range(0);
+  int dim3 = state.range(1);
+  int m_batch = state.range(2);
+  bool trans = state.range(3) > 0;
+  bool output = state.range(4) > 0;
+
+  RealWorldRNG<num_t> rw_rng(0);
+  RPUSimpleCopies rpu(size, size);
+  int matrix_size = size * m_batch / 4; // overlapping patches
+  std::vector<int> indices = makeIndices(size, m_batch, matrix_size, rw_rng);
+  std::vector<num_t> matrix(matrix_size * dim3);
+  std::vector<num_t> tensor(size * m_batch * dim3);
+  fillUniform(matrix, rw_rng);
+  fillUniform(tensor, rw_rng);
+
+  for (auto _ : state) {
+    if (output) {
+      rpu.copyIndexedOutput(
+          matrix.data(), tensor.data(), matrix.size(), indices.data(), size, m_batch, dim3, trans);
+      benchmark::DoNotOptimize(matrix.data());
+    } else {
+      rpu.copyIndexedInput(
+          tensor.data(), matrix.data(), matrix.size(), indices.data(), size, m_batch, dim3, trans);
+      benchmark::DoNotOptimize(tensor.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tensor.size());
+}
+BENCHMARK(BM_CopyIndexed)
+    ->ArgNames({"size", "dim3", "m_batch", "trans", "output"})
+    ->ArgsProduct({{576}, {16}, {196}, {0, 1}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -34,51 +34,71 @@ template <typename T>
 void ConstantStepRPUDevice<T>::doSparseUpdate(
     T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng) {
 
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *w = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
   T dw_min_std = getPar().dw_min_std;
 
   if (dw_min_std > (T)0.0) {
     PULSED_UPDATE_W_LOOP(
         T dw = 0; if (sign > 0) {
-          dw = ((T)1.0 + dw_min_std * rng->sampleGauss()) * scale_down[j];
+          dw = ((T)1.0 + dw_min_std * rng->sampleGauss()) * pack[j].scale_down;
           w[j] -= dw;
         } else {
-          dw = ((T)1.0 + dw_min_std * rng->sampleGauss()) * scale_up[j];
+          dw = ((T)1.0 + dw_min_std * rng->sampleGauss()) * pack[j].scale_up;
           w[j] += dw;
-        } w[j] = MIN(w[j], max_bound[j]);
-        w[j] = MAX(w[j], min_bound[j]););
+        } w[j] = MIN(w[j], pack[j].max_bound);
+        w[j] = MAX(w[j], pack[j].min_bound););
   } else {
 
     PULSED_UPDATE_W_LOOP(
-        if (sign > 0) { w[j] -= scale_down[j]; } else { w[j] += scale_up[j]; } w[j] =
-            MIN(w[j], max_bound[j]);
-        w[j] = MAX(w[j], min_bound[j]););
+        if (sign > 0) { w[j] -= pack[j].scale_down; } else { w[j] += pack[j].scale_up; } w[j] =
+            MIN(w[j], pack[j].max_bound);
+        w[j] = MAX(w[j], pack[j].min_bound););
   }
 }
 
+namespace {
 template <typename T>
-void ConstantStepRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+inline void update_n_pulses(
+    T &w, const int n, const int sign, const PulsedUpdateParameterPack<T> &pack, const T dw_min_std,
+    RNG<T> *rng) {
 
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  T dw = sign > 0 ? -pack.scale_down : pack.scale_up;
+  if (dw_min_std > (T)0.0) {
+    // sum of the n noisy steps as one Gaussian (bounds only applied at the end)
+    w += dw * ((T)n + dw_min_std * (T)sqrtf((float)n) * rng->sampleGauss());
+  } else {
+    // first step separately since w might start out of bounds, the
+    // remaining n - 1 steps are exact up to the bound
+    w += dw;
+    w = MIN(w, pack.max_bound);
+    w = MAX(w, pack.min_bound);
+    w += (T)(n - 1) * dw;
+  }
+  w = MIN(w, pack.max_bound);
+  w = MAX(w, pack.min_bound);
+}
+} // namespace
+
+template <typename T>
+void ConstantStepRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
+
+  auto *pack = this->getPackedUpdateParameters();
   T *w = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
   T dw_min_std = getPar().dw_min_std;
+  bool n_pulses_if = dw_min_std <= (T)0.0 || getPar().dense_update_noise_approx;
 
-  PULSED_UPDATE_W_LOOP_DENSE(
+  PULSED_UPDATE_W_LOOP_DENSE_N(
+      n_pulses_if, update_n_pulses(w[j], ac, sign, pack[j], dw_min_std, rng),
       T dw = dw_min_std > (T)0.0 ? dw_min_std * rng->sampleGauss() : (T)0.0; if (sign > 0) {
-        dw = ((T)1.0 + dw) * scale_down[j];
+        dw = ((T)1.0 + dw) * pack[j].scale_down;
         w[j] -= dw;
       } else {
-        dw = ((T)1.0 + dw) * scale_up[j];
+        dw = ((T)1.0 + dw) * pack[j].scale_up;
         w[j] += dw;
-      } w[j] = MIN(w[j], max_bound[j]);
-      w[j] = MAX(w[j], min_bound[j]);
+      } w[j] = MIN(w[j], pack[j].max_bound);
+      w[j] = MAX(w[j], pack[j].min_bound);
 
   );
 }
@@ -11,6 +11,8 @@
  */
 
 #include "rpu_expstep_device.h"
+#include <cmath>
+#include <limits>
 
 namespace RPU {
 
@@ -18,8 +20,49 @@ template <typename T>
 void ExpStepRPUDevice<T>::populate(
     const ExpStepRPUDeviceMetaParameter<T> &p, RealWorldRNG<T> *rng) {
   PulsedRPUDevice<T>::populate(p, rng);
+  buildStepTables();
 }
+
+template <typename T> void ExpStepRPUDevice<T>::buildStepTables() {
+
+  // the step response depends on w / (max_bound - min_bound) only, thus
+  // one table (each direction) over the range of all devices
+  const auto &par = getPar();
+  T s_min = std::numeric_limits<T>::max();
+  T s_max = std::numeric_limits<T>::lowest();
+  for (int i = 0; i < this->x_size_ * this->d_size_; ++i) {
+    T b_diff = this->w_max_bound_[0][i] - this->w_min_bound_[0][i];
+    if (b_diff > (T)0.0) {
+      s_min = MIN(s_min, this->w_min_bound_[0][i] / b_diff);
+      s_max = MAX(s_max, this->w_max_bound_[0][i] / b_diff);
+    }
+  }
+  int n_sections = s_max > s_min ? par.es_lut_size : 0;
+  step_down_table_.build(n_sections, s_min, s_max, (T)0.0, (T)0.0, [&par](const T &s, const T &) {
+    T z = (T)2.0 * s * par.es_a + par.es_b;
+    return MAX((T)1.0 - par.es_A_down * (T)expf(par.es_gamma_down * (-z)), (T)0.0);
+  });
+  step_up_table_.build(n_sections, s_min, s_max, (T)0.0, (T)0.0, [&par](const T &s, const T &) {
+    T z = (T)2.0 * s * par.es_a + par.es_b;
+    return MAX((T)1.0 - par.es_A_up * (T)expf(par.es_gamma_up * z), (T)0.0);
+  });
+}
+
 template <typename T>
+inline T ExpStepRPUDevice<T>::getStepResponse(const T &w_rel, const bool down) const {
+  if (step_down_table_.isActive()) {
+    return down ? step_down_table_(w_rel, (T)0.0) : step_up_table_(w_rel, (T)0.0);
+  }
+  const auto &par = getPar();
+  T z = (T)2.0 * w_rel * par.es_a + par.es_b;
+  if (down) {
+    return MAX((T)1.0 - par.es_A_down * (T)expf(par.es_gamma_down * (-z)), (T)0.0);
+  } else {
+    return MAX((T)1.0 - par.es_A_up * (T)expf(par.es_gamma_up * z), (T)0.0);
+  }
+}
+
+template <typename T, typename StepFun>
 inline void update_once(
     T &w,
     T &w_apparent,
@@ -28,25 +71,20 @@ inline void update_once(
     T &max_bound,
     T &scale_down,
     T &scale_up,
-    const T &es_a,
-    const T &es_b,
-    const T &es_A_down,
-    const T &es_A_up,
-    const T &es_gamma_down,
-    const T &es_gamma_up,
+    const StepFun &step_fun,
     const T &dw_min_std,
     const T &write_noise_std,
     RNG<T> *rng) {
   T b_diff = (max_bound - min_bound);
   if (b_diff > (T)0.0) {
-    T z = (T)2.0 * w / b_diff * es_a + es_b;
+    T w_rel = w / b_diff;
 
     if (sign > 0) {
-      T y_down = MAX((T)1.0 - es_A_down * (T)expf(es_gamma_down * (-z)), (T)0.0);
+      T y_down = step_fun(w_rel, true);
       w -= y_down * ((T)1.0 + dw_min_std * rng->sampleGauss()) * scale_down;
 
     } else {
-      T y_up = MAX((T)1.0 - es_A_up * (T)expf(es_gamma_up * z), (T)0.0);
+      T y_up = step_fun(w_rel, false);
       w += y_up * ((T)1.0 + dw_min_std * rng->sampleGauss()) * scale_up;
     }
 
@@ -60,7 +98,7 @@ inline void update_once(
   }
 }
 
-template <typename T>
+template <typename T, typename StepFun>
 inline void update_once_complex_noise(
     T &w,
     T &w_apparent,
@@ -69,12 +107,7 @@ inline void update_once_complex_noise(
     T &max_bound,
     T &scale_down,
     T &scale_up,
-    const T &es_a,
-    const T &es_b,
-    const T &es_A_down,
-    const T &es_A_up,
-    const T &es_gamma_down,
-    const T &es_gamma_up,
+    const StepFun &step_fun,
     const T &dw_min_std,
     const T &dw_min_std_add,
     const T &dw_min_std_slope,
@@ -82,15 +115,15 @@ inline void update_once_complex_noise(
     RNG<T> *rng) {
   T b_diff = (max_bound - min_bound);
   if (b_diff > (T)0.0) {
-    T z = (T)2.0 * w / b_diff * es_a + es_b;
+    T w_rel = w / b_diff;
     T dw;
 
     if (sign > 0) {
-      T y_down = MAX((T)1.0 - (T)es_A_down * (T)expf(es_gamma_down * (-z)), (T)0);
+      T y_down = step_fun(w_rel, true);
       dw = -y_down * scale_down;
 
     } else {
-      T y_up = MAX((T)1.0 - (T)es_A_up * (T)expf(es_gamma_up * z), (T)0);
+      T y_up = step_fun(w_rel, false);
       dw = y_up * scale_up;
     }
 
@@ -112,55 +145,53 @@ void ExpStepRPUDevice<T>::doSparseUpdate(
     T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng) {
 
   const auto &par = getPar();
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *w = par.usesPersistentWeight() ? this->w_persistent_[i] : weights[i];
   T *w_apparent = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
+  auto step_fun = [this](const T &w_rel, const bool down) {
+    return getStepResponse(w_rel, down);
+  };
 
   T write_noise_std = par.getScaledWriteNoise();
   if (par.hasComplexNoise()) {
     PULSED_UPDATE_W_LOOP(update_once_complex_noise(
-                             w[j], w_apparent[j], sign, min_bound[j], max_bound[j], scale_down[j],
-                             scale_up[j], par.es_a, par.es_b, par.es_A_down, par.es_A_up,
-                             par.es_gamma_down, par.es_gamma_up, par.dw_min_std, par.dw_min_std_add,
-                             par.dw_min_std_slope, write_noise_std, rng););
+                             w[j], w_apparent[j], sign, pack[j].min_bound, pack[j].max_bound,
+                             pack[j].scale_down, pack[j].scale_up, step_fun, par.dw_min_std,
+                             par.dw_min_std_add, par.dw_min_std_slope, write_noise_std, rng););
   } else {
 
     PULSED_UPDATE_W_LOOP(update_once(
-                             w[j], w_apparent[j], sign, min_bound[j], max_bound[j], scale_down[j],
-                             scale_up[j], par.es_a, par.es_b, par.es_A_down, par.es_A_up,
-                             par.es_gamma_down, par.es_gamma_up, par.dw_min_std, write_noise_std,
-                             rng););
+                             w[j], w_apparent[j], sign, pack[j].min_bound, pack[j].max_bound,
+                             pack[j].scale_down, pack[j].scale_up, step_fun, par.dw_min_std,
+                             write_noise_std, rng););
   }
 };
 
 template <typename T>
-void ExpStepRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+void ExpStepRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
 
   const auto &par = getPar();
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  auto *pack = this->getPackedUpdateParameters();
   T *w = par.usesPersistentWeight() ? this->w_persistent_[0] : weights[0];
   T *w_apparent = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
+  auto step_fun = [this](const T &w_rel, const bool down) {
+    return getStepResponse(w_rel, down);
+  };
 
   T write_noise_std = par.getScaledWriteNoise();
   if (par.hasComplexNoise()) {
 
-    PULSED_UPDATE_W_LOOP_DENSE(
-        update_once_complex_noise(
-            w[j], w_apparent[j], sign, min_bound[j], max_bound[j], scale_down[j], scale_up[j],
-            par.es_a, par.es_b, par.es_A_down, par.es_A_up, par.es_gamma_down, par.es_gamma_up,
-            par.dw_min_std, par.dw_min_std_add, par.dw_min_std_slope, write_noise_std, rng););
+    PULSED_UPDATE_W_LOOP_DENSE(update_once_complex_noise(
+                                   w[j], w_apparent[j], sign, pack[j].min_bound, pack[j].max_bound,
+                                   pack[j].scale_down, pack[j].scale_up, step_fun, par.dw_min_std,
+                                   par.dw_min_std_add, par.dw_min_std_slope, write_noise_std,
+                                   rng););
 
   } else {
     PULSED_UPDATE_W_LOOP_DENSE(update_once(
-                                   w[j], w_apparent[j], sign, min_bound[j], max_bound[j],
-                                   scale_down[j], scale_up[j], par.es_a, par.es_b, par.es_A_down,
-                                   par.es_A_up, par.es_gamma_down, par.es_gamma_up, par.dw_min_std,
+                                   w[j], w_apparent[j], sign, pack[j].min_bound, pack[j].max_bound,
+                                   pack[j].scale_down, pack[j].scale_up, step_fun, par.dw_min_std,
                                    write_noise_std, rng););
   }
 }
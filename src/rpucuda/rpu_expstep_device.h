@@ -33,6 +33,7 @@ BUILD_PULSED_DEVICE_META_PARAMETER(
     T es_b = (T)0.2425;            /*p_02425 */
     T dw_min_std_add = (T)0.0;     // additive part of dw noise
     T dw_min_std_slope = (T)0.0;   // multiplicative part of noise with abs(w)
+    int es_lut_size = 0;           // tabulated step response if > 0 (CPU only)
     ,
     /*print body*/
     ss << "\t es_A_up:\t\t" << es_A_up << std::endl;
@@ -45,6 +46,8 @@ BUILD_PULSED_DEVICE_META_PARAMETER(
       ss << "\t dw_min_std_add:\t " << dw_min_std_add << std::endl;
     } if (dw_min_std_slope != (T)0.0) {
       ss << "\t dw_min_std_slope:\t " << dw_min_std_slope << std::endl;
+    } if (es_lut_size > 0) {
+      ss << "\t es_lut_size:\t\t" << es_lut_size << std::endl;
     },
     /* calc weight granularity body */
     T up_down = this->up_down;
@@ -75,24 +78,41 @@ template <typename T> class ExpStepRPUDevice : public PulsedRPUDevice<T> {
       /* dtor*/
       ,
       /* copy */
+      step_down_table_ = other.step_down_table_;
+      step_up_table_ = other.step_up_table_;
       ,
       /* move assignment */
+      step_down_table_ = std::move(other.step_down_table_);
+      step_up_table_ = std::move(other.step_up_table_);
       ,
       /* swap*/
+      swap(a.step_down_table_, b.step_down_table_);
+      swap(a.step_up_table_, b.step_up_table_);
       ,
       /* dp names*/
       ,
       /* dp2vec body*/
       ,
       /* vec2dp body*/
+      buildStepTables();
       ,
       /*invert copy DP */
+      buildStepTables();
   );
 
   void doSparseUpdate(
       T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng)
       override;
-  void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) override;
+  void doDenseUpdateRows(
+      T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) override;
+
+private:
+  void buildStepTables();
+  inline T getStepResponse(const T &w_rel, const bool down) const;
+
+  // tabulated step responses over w / (max_bound - min_bound), see es_lut_size
+  StepResponseTable<T> step_down_table_;
+  StepResponseTable<T> step_up_table_;
 };
 
 } // namespace RPU
@@ -66,6 +66,73 @@ void ForwardBackwardPass<T>::gemv(
   }
 }
 
+template <typename T>
+void ForwardBackwardPass<T>::gemm(
+    T **weights,
+    const T *in_values,
+    const int in_size,
+    const bool in_trans,
+    T *out_values,
+    const int out_size,
+    const bool out_trans,
+    const int m_batch,
+    const T alpha,
+    const T beta,
+    const bool transposed) {
+  // Y = alpha * W * X + beta * Y  (column-wise for each sample)
+
+  int in_ld = in_trans ? m_batch : in_size;
+  if (out_trans) {
+    // [out_size x m_batch]
+    RPU::math::gemm<T>(
+        CblasRowMajor, transposed ? CblasTrans : CblasNoTrans, in_trans ? CblasNoTrans : CblasTrans,
+        out_size, // M
+        m_batch,  // N
+        in_size,  // K
+        alpha, weights[0], this->x_size_, in_values, in_ld, beta, out_values, m_batch);
+  } else {
+    // [m_batch x out_size]
+    RPU::math::gemm<T>(
+        CblasRowMajor, in_trans ? CblasTrans : CblasNoTrans, transposed ? CblasNoTrans : CblasTrans,
+        m_batch,  // M
+        out_size, // N
+        in_size,  // K
+        alpha, in_values, in_ld, weights[0], this->x_size_, beta, out_values, out_size);
+  }
+}
+
+template <typename T>
+void ForwardBackwardPass<T>::forwardMatrix(
+    T **weights,
+    const T *X_input,
+    T *D_output,
+    const int m_batch,
+    const bool x_trans,
+    const bool d_trans,
+    const T alpha,
+    const bool is_test) {
+
+  UNUSED(is_test);
+  gemm(
+      weights, X_input, this->x_size_, x_trans, D_output, this->d_size_, d_trans, m_batch, alpha,
+      (T)0.0, false);
+}
+
+template <typename T>
+void ForwardBackwardPass<T>::backwardMatrix(
+    T **weights,
+    const T *D_input,
+    T *X_output,
+    const int m_batch,
+    const bool d_trans,
+    const bool x_trans,
+    const T alpha) {
+
+  gemm(
+      weights, D_input, this->d_size_, d_trans, X_output, this->x_size_, x_trans, m_batch, alpha,
+      (T)0.0, true);
+}
+
 template <typename T>
 void ForwardBackwardPass<T>::dumpExtra(RPU::state_t &extra, const std::string prefix) {
 
@@ -242,10 +309,35 @@ ForwardBackwardPassIOManaged<T>::operator=(ForwardBackwardPassIOManaged<T> &&oth
   b_io_ = other.b_io_;
   checked_implemented_ = other.checked_implemented_;
   rng_ = std::move(other.rng_);
+  invalidateWeightsCache();
 
   return *this;
 }
 
+template <typename T> void ForwardBackwardPassIOManaged<T>::invalidateWeightsCache() {
+  for (auto &entry : abs_weights_cache_) {
+    entry.valid = false;
+  }
+  neg_weights_valid_ = false;
+}
+
+template <typename T>
+void ForwardBackwardPassIOManaged<T>::setWeightsVersion(uint64_t version) {
+  weights_version_ = version;
+  weights_version_set_ = true;
+}
+
+template <typename T> void ForwardBackwardPassIOManaged<T>::resetWeightsVersion() {
+  weights_version_set_ = false;
+  invalidateWeightsCache();
+}
+
+template <typename T>
+void ForwardBackwardPassIOManaged<T>::setFBParameter(FBParameter<T> fb_pars) {
+  ForwardBackwardPass<T>::setFBParameter(fb_pars);
+  invalidateWeightsCache(); // read asymmetries might have changed
+}
+
 template <typename T>
 void ForwardBackwardPassIOManaged<T>::populateFBParameter(
     const IOMetaParameter<T> &f_io, const IOMetaParameter<T> &b_io) {
@@ -256,6 +348,7 @@ void ForwardBackwardPassIOManaged<T>::populateFBParameter(
   f_io_.initializeForForward(this->x_size_, this->d_size_);
   b_io_.initializeForBackward(this->x_size_, this->d_size_);
   checked_implemented_ = false;
+  invalidateWeightsCache();
 
   // v offset forward
   auto populate = [this](
@@ -264,8 +357,9 @@ void ForwardBackwardPassIOManaged<T>::populateFBParameter(
     mv_pars.v_offset = io.v_offset_vec;
     if ((mv_pars.v_offset.size() != out_size) && io.hasVoltageOffsets()) {
       mv_pars.v_offset.resize(out_size);
+      rng_->fillGauss(mv_pars.v_offset.data(), (int)out_size);
       for (size_t i = 0; i < out_size; i++) {
-        mv_pars.v_offset[i] = MAX(io.v_offset_std * rng_->sampleGauss(), (T)0.0);
+        mv_pars.v_offset[i] = MAX(io.v_offset_std * mv_pars.v_offset[i], (T)0.0);
       }
     }
 
@@ -278,11 +372,12 @@ void ForwardBackwardPassIOManaged<T>::populateFBParameter(
     if (io.hasNLCalibration()) {
       if (mv_pars.out_nonlinearity.size() != out_size) {
         mv_pars.out_nonlinearity.resize(out_size);
+        rng_->fillGauss(mv_pars.out_nonlinearity.data(), (int)out_size);
 
         for (size_t i = 0; i < out_size; i++) {
           mv_pars.out_nonlinearity[i] = (T)fabsf(
               io.out_nonlinearity / out_bound *
-              ((T)1.0 + MAX(io.out_nonlinearity_std, (T)0.0) * rng_->sampleGauss()));
+              ((T)1.0 + MAX(io.out_nonlinearity_std, (T)0.0) * mv_pars.out_nonlinearity[i]));
         }
       }
     }
@@ -303,18 +398,20 @@ void ForwardBackwardPassIOManaged<T>::populateFBParameter(
     if (io.w_read_asymmetry_dtod) {
       size_t size = out_size * in_size;
       mv_pars.w_asymmetry.resize(size);
+      rng_->fillGauss(mv_pars.w_asymmetry.data(), (int)size);
 
       for (size_t i = 0; i < size; i++) {
-        mv_pars.w_asymmetry[i] = ((T)1.0 + io.w_read_asymmetry_dtod * rng_->sampleGauss());
+        mv_pars.w_asymmetry[i] = ((T)1.0 + io.w_read_asymmetry_dtod * mv_pars.w_asymmetry[i]);
       }
     }
 
     if (io.out_noise_std > (T)0.0) {
       mv_pars.out_noise_values.resize(out_size);
+      rng_->fillGauss(mv_pars.out_noise_values.data(), (int)out_size);
 
       for (size_t i = 0; i < out_size; i++) {
         mv_pars.out_noise_values[i] =
-            (T)fabsf(io.out_noise * ((T)1.0 + io.out_noise_std * rng_->sampleGauss()));
+            (T)fabsf(io.out_noise * ((T)1.0 + io.out_noise_std * mv_pars.out_noise_values[i]));
       }
     }
   };
@@ -328,6 +425,68 @@ template <typename T> void ForwardBackwardPassIOManaged<T>::ensureImplemented()
 /*********************************************************************/
 /* Non-idealities */
 
+template <typename T> const T *ForwardBackwardPassIOManaged<T>::sampleGaussValues(int size) {
+  // bulk (vectorized) Gaussian numbers for the noise of a whole vector
+  gauss_values_.resize(size);
+  rng_->fillGauss(gauss_values_.data(), size);
+  return gauss_values_.data();
+}
+
+template <typename T> T *ForwardBackwardPassIOManaged<T>::getAbsWeights(T **weights) {
+
+  const T *src = weights == neg_weights_ ? neg_weights_src_ : nullptr;
+  AbsWeightsCacheEntry &entry = abs_weights_cache_[src != nullptr ? 1 : 0];
+
+  if (weights_version_set_ && entry.valid && entry.weights == weights[0] && entry.src == src &&
+      entry.version == weights_version_) {
+    return entry.values.data();
+  }
+
+  int size = this->d_size_ * this->x_size_;
+  entry.values.resize(size);
+  T *abs_w = entry.values.data();
+  const T *w = weights[0];
+  PRAGMA_SIMD
+  for (int i = 0; i < size; ++i) {
+    abs_w[i] = (T)fabsf(w[i]);
+  }
+  entry.weights = weights[0];
+  entry.src = src;
+  entry.version = weights_version_;
+  entry.valid = weights_version_set_;
+  return abs_w;
+}
+
+template <typename T>
+const T *ForwardBackwardPassIOManaged<T>::computeOutputWeightNoiseVariance(
+    T **weights,
+    const T *in_values,
+    const int in_size,
+    const int out_size,
+    const int m_batch,
+    const IOMetaParameter<T> &io,
+    const bool transposed) {
+
+  if (io.w_noise_type != OutputWeightNoiseType::PCMRead || io.w_noise <= (T)0.0) {
+    return nullptr;
+  }
+
+  size_t in_total = (size_t)m_batch * in_size;
+  tmp_in_values_.resize(in_total);
+  PRAGMA_SIMD
+  for (size_t j = 0; j < in_total; ++j) {
+    tmp_in_values_[j] = in_values[j] * in_values[j];
+  }
+
+  // var = |W| * x.^2 for all samples at once
+  noise_var_matrix_values_.resize((size_t)m_batch * out_size);
+  T *abs_w = getAbsWeights(weights);
+  this->gemm(
+      &abs_w, tmp_in_values_.data(), in_size, false, noise_var_matrix_values_.data(), out_size,
+      false, m_batch, (T)1.0, (T)0.0, transposed);
+  return noise_var_matrix_values_.data();
+}
+
 template <typename T>
 void ForwardBackwardPassIOManaged<T>::applyOutputWeightNoise(
     T **weights,
@@ -337,7 +496,8 @@ void ForwardBackwardPassIOManaged<T>::applyOutputWeightNoise(
     const T *in_values,
     const int in_size,
     const IOMetaParameter<T> &io,
-    const bool transposed) {
+    const bool transposed,
+    const T *noise_var_values) {
 
   if (io.w_noise_type == OutputWeightNoiseType::None) {
     return;
@@ -348,10 +508,11 @@ void ForwardBackwardPassIOManaged<T>::applyOutputWeightNoise(
     if (io.w_noise > (T)0.0) {
       T x_norm = RPU::math::nrm2<T>(in_size, in_values, 1);
       T w_std = io.w_noise * x_norm;
+      const T *noise_values = sampleGaussValues(out_size);
       int i_out = 0;
       PRAGMA_SIMD
       for (int i = 0; i < out_size; ++i) {
-        out_values[i_out] += w_std * rng_->sampleGauss();
+        out_values[i_out] += w_std * noise_values[i];
         i_out += out_inc;
       }
     }
@@ -359,28 +520,27 @@ void ForwardBackwardPassIOManaged<T>::applyOutputWeightNoise(
   case OutputWeightNoiseType::PCMRead:
     if (io.w_noise > (T)0.0) {
       T w_std = io.w_noise;
-      tmp_in_values_.resize(in_size);
 
-      PRAGMA_SIMD
-      for (int j = 0; j < in_size; ++j) {
-        tmp_in_values_[j] = in_values[j] * in_values[j];
+      if (noise_var_values == nullptr) {
+        // var = |W| * x.^2
+        tmp_in_values_.resize(in_size);
+        PRAGMA_SIMD
+        for (int j = 0; j < in_size; ++j) {
+          tmp_in_values_[j] = in_values[j] * in_values[j];
+        }
+        tmp_out_values_.resize(out_size);
+        T *abs_w = getAbsWeights(weights);
+        this->gemv(
+            &abs_w, tmp_in_values_.data(), in_size, 1, tmp_out_values_.data(), out_size, 1,
+            (T)1.0, (T)0.0, transposed);
+        noise_var_values = tmp_out_values_.data();
       }
-      // likely relatively slow. Since |W|*x.^2 without GEMV...
+
+      const T *noise_values = sampleGaussValues(out_size);
       int i_out = 0;
+      PRAGMA_SIMD
       for (int i = 0; i < out_size; ++i) {
-        T accum = 0.0;
-        if (transposed) {
-          PRAGMA_SIMD
-          for (int j = 0; j < in_size; ++j) {
-            accum += (T)fabsf(weights[j][i]) * tmp_in_values_[j];
-          }
-        } else {
-          PRAGMA_SIMD
-          for (int j = 0; j < in_size; ++j) {
-            accum += (T)fabsf(weights[i][j]) * tmp_in_values_[j];
-          }
-        }
-        out_values[i_out] += (T)w_std * (T)sqrtf(accum) * rng_->sampleGauss();
+        out_values[i_out] += w_std * (T)sqrtf(noise_var_values[i]) * noise_values[i];
         i_out += out_inc;
       }
     }
@@ -515,22 +675,17 @@ template <typename T>
 const T *ForwardBackwardPassIOManaged<T>::computeTotalCurrent(
     T **weights, const int out_size, const T *in_values, const int in_size, bool transposed) {
 
-  current_buffer_values_.resize(out_size);
-  for (int i = 0; i < out_size; ++i) {
-    T accum = 0.0;
-    if (transposed) {
-      PRAGMA_SIMD
-      for (int j = 0; j < in_size; ++j) {
-        accum += (T)fabsf(weights[j][i]) * (T)fabsf(in_values[j]);
-      }
-    } else {
-      PRAGMA_SIMD
-      for (int j = 0; j < in_size; ++j) {
-        accum += (T)fabsf(weights[i][j]) * (T)fabsf(in_values[j]);
-      }
-    }
-    current_buffer_values_[i] = accum;
+  // sum_j(|w_ij|*|x_j|)
+  abs_in_values_.resize(in_size);
+  PRAGMA_SIMD
+  for (int j = 0; j < in_size; ++j) {
+    abs_in_values_[j] = (T)fabsf(in_values[j]);
   }
+  current_buffer_values_.resize(out_size);
+  T *abs_w = getAbsWeights(weights);
+  this->gemv(
+      &abs_w, abs_in_values_.data(), in_size, 1, current_buffer_values_.data(), out_size, 1,
+      (T)1.0, (T)0.0, transposed);
 
   return current_buffer_values_.data();
 }
@@ -545,7 +700,8 @@ void ForwardBackwardPassIOManaged<T>::applyNonIdealities(
     const int in_size,
     const MVParameter<T> &mv_pars,
     const IOMetaParameter<T> &io,
-    const bool transposed) {
+    const bool transposed,
+    const T *noise_var_values) {
 
   // IR drop
   if (io.ir_drop > (T)0) {
@@ -561,7 +717,8 @@ void ForwardBackwardPassIOManaged<T>::applyNonIdealities(
   // weight dependent noise
   if (io.w_noise_type != OutputWeightNoiseType::None) {
     applyOutputWeightNoise(
-        weights, out_values, out_size, out_inc, in_values, in_size, io, transposed);
+        weights, out_values, out_size, out_inc, in_values, in_size, io, transposed,
+        noise_var_values);
   }
 }
 
@@ -570,9 +727,9 @@ void ForwardBackwardPassIOManaged<T>::applyNonIdealities(
 
 #define ARGS                                                                                       \
   T *out_values, const T *in_values, const int in_size, const int in_inc, const T scale,           \
-      const IOMetaParameter<T> &io, std::shared_ptr<RNG<T>> &rng
+      const IOMetaParameter<T> &io, const T *noise_values, std::shared_ptr<RNG<T>> &rng
 
-#define ARGS_CALL out_values, in_values, in_size, in_inc, scale, io, rng
+#define ARGS_CALL out_values, in_values, in_size, in_inc, scale, io, noise_values, rng
 
 template <typename T, bool scaling, bool with_noise, bool sto_round_if, bool with_asymmetry>
 inline void prepareInputImplStage4(ARGS) {
@@ -597,8 +754,8 @@ inline void prepareInputImplStage4(ARGS) {
     value = (value < -bound) ? -bound : value;
 
     // inp noise after the bound + DAC ?!
-    if (noise > (T)0.0) {
-      value += noise * rng->sampleGauss();
+    if (with_noise) {
+      value += noise * noise_values[j];
     }
 
     if (with_asymmetry) {
@@ -640,6 +797,7 @@ template <typename T, bool scaling> inline void prepareInputImplStage1(ARGS) {
 
 template <typename T>
 T *ForwardBackwardPassIOManaged<T>::prepareInput(
+    T *out_values,
     const T *in_values,
     const int in_size,
     const int in_inc,
@@ -647,17 +805,28 @@ T *ForwardBackwardPassIOManaged<T>::prepareInput(
     const bool scaling,
     const IOMetaParameter<T> &io) {
 
-  in_buffer_values_.resize(in_size);
-
+  const T *noise_values = io.inp_noise > (T)0.0 ? sampleGaussValues(in_size) : nullptr;
   if (scaling) {
     prepareInputImplStage1<T, true>(
-        in_buffer_values_.data(), in_values, in_size, in_inc, scale, io, rng_);
+        out_values, in_values, in_size, in_inc, scale, io, noise_values, rng_);
   } else {
     prepareInputImplStage1<T, false>(
-        in_buffer_values_.data(), in_values, in_size, in_inc, scale, io, rng_);
+        out_values, in_values, in_size, in_inc, scale, io, noise_values, rng_);
   }
+  return out_values;
+}
+
+template <typename T>
+T *ForwardBackwardPassIOManaged<T>::prepareInput(
+    const T *in_values,
+    const int in_size,
+    const int in_inc,
+    const T scale,
+    const bool scaling,
+    const IOMetaParameter<T> &io) {
 
-  return in_buffer_values_.data();
+  in_buffer_values_.resize(in_size);
+  return prepareInput(in_buffer_values_.data(), in_values, in_size, in_inc, scale, scaling, io);
 }
 
 /*********************************************************************/
@@ -665,9 +834,9 @@ T *ForwardBackwardPassIOManaged<T>::prepareInput(
 
 #define ARGS                                                                                       \
   T *out_values, const int out_size, const int out_inc, const MVParameter<T> &mv_pars,             \
-      const IOMetaParameter<T> &io, std::shared_ptr<RNG<T>> &rng
+      const IOMetaParameter<T> &io, const T *noise_values, std::shared_ptr<RNG<T>> &rng
 
-#define ARGS_CALL out_values, out_size, out_inc, mv_pars, io, rng
+#define ARGS_CALL out_values, out_size, out_inc, mv_pars, io, noise_values, rng
 
 template <
     typename T,
@@ -700,7 +869,7 @@ inline bool finalizeOutputImplStage5(ARGS) {
 
     if (with_noise) {
       const T noise_std = io.out_noise_std > (T)0.0 ? mv_pars.out_noise_values[i] : io.out_noise;
-      value += noise_std * rng->sampleGauss();
+      value += noise_std * noise_values[i];
     }
 
     value = getDiscretizedValueSR<sto_round_if>(value, res, *rng);
@@ -757,7 +926,7 @@ template <typename T, bool with_asymmetry> inline bool finalizeOutputImplStage1(
   if (io.out_noise > (T)0.0 || io.out_noise_std > (T)0.0) {
     return finalizeOutputImplStage2<T, true, with_asymmetry>(ARGS_CALL);
   } else {
-    return finalizeOutputImplStage2<T, true, with_asymmetry>(ARGS_CALL);
+    return finalizeOutputImplStage2<T, false, with_asymmetry>(ARGS_CALL);
   }
 }
 
@@ -772,11 +941,75 @@ bool ForwardBackwardPassIOManaged<T>::finalizeOutput(
     const MVParameter<T> &mv_pars,
     const IOMetaParameter<T> &io) {
 
+  const T *noise_values = (io.out_noise > (T)0.0 || io.out_noise_std > (T)0.0)
+                              ? sampleGaussValues(out_size)
+                              : nullptr;
+  return finalizeOutput(out_values, out_size, out_inc, mv_pars, io, noise_values);
+}
+
+template <typename T>
+bool ForwardBackwardPassIOManaged<T>::finalizeOutput(
+    T *out_values,
+    const int out_size,
+    const int out_inc,
+    const MVParameter<T> &mv_pars,
+    const IOMetaParameter<T> &io,
+    const T *noise_values) {
+
   if (io.out_asymmetry > (T)0.0) {
-    return finalizeOutputImplStage1<T, true>(out_values, out_size, out_inc, mv_pars, io, rng_);
+    return finalizeOutputImplStage1<T, true>(
+        out_values, out_size, out_inc, mv_pars, io, noise_values, rng_);
   } else {
-    return finalizeOutputImplStage1<T, false>(out_values, out_size, out_inc, mv_pars, io, rng_);
+    return finalizeOutputImplStage1<T, false>(
+        out_values, out_size, out_inc, mv_pars, io, noise_values, rng_);
+  }
+}
+
+template <typename T>
+bool ForwardBackwardPassIOManaged<T>::finalizeOutputKeepAnalog(
+    T *out_values,
+    const int out_size,
+    const int out_inc,
+    T *analog_values,
+    T *noise_values,
+    const MVParameter<T> &mv_pars,
+    const IOMetaParameter<T> &io) {
+
+  int i_out = 0;
+  PRAGMA_SIMD
+  for (int i = 0; i < out_size; ++i) {
+    analog_values[i] = out_values[i_out];
+    i_out += out_inc;
+  }
+
+  bool with_noise = io.out_noise > (T)0.0 || io.out_noise_std > (T)0.0;
+  if (with_noise) {
+    rng_->fillGauss(noise_values, out_size);
+  }
+  return finalizeOutput(
+      out_values, out_size, out_inc, mv_pars, io, with_noise ? noise_values : nullptr);
+}
+
+template <typename T>
+bool ForwardBackwardPassIOManaged<T>::rescaleAnalogOutput(
+    T *out_values,
+    const int out_size,
+    const int out_inc,
+    const T *analog_values,
+    const T *noise_values,
+    const T ratio,
+    const MVParameter<T> &mv_pars,
+    const IOMetaParameter<T> &io) {
+
+  int i_out = 0;
+  PRAGMA_SIMD
+  for (int i = 0; i < out_size; ++i) {
+    out_values[i_out] = analog_values[i] * ratio;
+    i_out += out_inc;
   }
+  bool with_noise = io.out_noise > (T)0.0 || io.out_noise_std > (T)0.0;
+  return finalizeOutput(
+      out_values, out_size, out_inc, mv_pars, io, with_noise ? noise_values : nullptr);
 }
 
 /********************************************************************************/
@@ -803,6 +1036,34 @@ inline void ForwardBackwardPassIOManaged<T>::computeAnalogMVSinglePass(
       weights, out_values, out_size, out_inc, in_values, in_size, mv_pars, io, transposed);
 }
 
+template <typename T>
+inline T **ForwardBackwardPassIOManaged<T>::getNegWeights(
+    T **weights, const MVParameter<T> &mv_pars, const IOMetaParameter<T> &io) {
+
+  if (io.w_read_asymmetry_dtod <= (T)0.0) {
+    return weights;
+  }
+  if (neg_weights_ == nullptr) {
+    neg_weights_ = Array_2D_Get<T>(this->d_size_, this->x_size_);
+  }
+  // forward and backward use different asymmetries
+  bool fwd = &mv_pars == &this->fb_pars_.fwd;
+  if (weights_version_set_ && neg_weights_valid_ && neg_weights_src_ == weights[0] &&
+      neg_weights_version_ == weights_version_ && neg_weights_fwd_ == fwd) {
+    return neg_weights_;
+  }
+  PRAGMA_SIMD
+  for (int i = 0; i < this->d_size_ * this->x_size_; ++i) {
+    neg_weights_[0][i] = weights[0][i] * mv_pars.w_asymmetry[i];
+  }
+  neg_weights_src_ = weights[0];
+  neg_weights_version_ = weights_version_;
+  neg_weights_fwd_ = fwd;
+  neg_weights_valid_ = weights_version_set_;
+  abs_weights_cache_[1].valid = false;
+  return neg_weights_;
+}
+
 template <typename T>
 inline bool ForwardBackwardPassIOManaged<T>::computeAnalogMV(
     T **weights,
@@ -817,12 +1078,25 @@ inline bool ForwardBackwardPassIOManaged<T>::computeAnalogMV(
     const MVParameter<T> &mv_pars,
     const IOMetaParameter<T> &io,
     const bool transposed,
-    const bool is_test) {
+    const bool is_test,
+    const bool keep_analog) {
 
   // not used. We don't distinguish between evaluation and
   // training. Noise will be always present
   UNUSED(is_test);
 
+  // optionally keep the pre-ADC result for the rescaled bound management
+  auto finalize = [&](T *out, int inc) -> bool {
+    if (!keep_analog) {
+      return finalizeOutput(out, out_size, inc, mv_pars, io);
+    }
+    analog_buffer_values_.resize(out_size);
+    analog_noise_values_.resize(out_size);
+    return finalizeOutputKeepAnalog(
+        out, out_size, inc, analog_buffer_values_.data(), analog_noise_values_.data(), mv_pars,
+        io);
+  };
+
   // scale, apply bound, discretize and scale and input noise
   T *in_values = prepareInput(org_in_values, in_size, in_inc, scale, scaling, io);
   switch (io.mv_type) {
@@ -831,7 +1105,7 @@ inline bool ForwardBackwardPassIOManaged<T>::computeAnalogMV(
     computeAnalogMVSinglePass(
         weights, in_values, in_size, 1, out_values, out_size, out_inc, 1.0, 0.0, mv_pars, io,
         transposed);
-    return finalizeOutput(out_values, out_size, out_inc, mv_pars, io);
+    return finalize(out_values, out_inc);
   }
 
   case AnalogMVType::PosNegSeparateDigitalSum:
@@ -846,18 +1120,7 @@ inline bool ForwardBackwardPassIOManaged<T>::computeAnalogMV(
       pos_neg_buffer_values_[i] = in_values[i] < (T)0 ? in_values[i] : (T)0.0;
     }
 
-    // this will be extremely ineffecient...
-    T **neg_weights = weights;
-    if (io.w_read_asymmetry_dtod > (T)0.0) {
-      if (neg_weights_ == nullptr) {
-        neg_weights_ = Array_2D_Get<T>(this->d_size_, this->x_size_);
-      }
-
-      neg_weights = neg_weights_;
-      for (int i = 0; i < this->d_size_ * this->x_size_; ++i) {
-        neg_weights[0][i] = weights[0][i] * mv_pars.w_asymmetry[i];
-      }
-    }
+    T **neg_weights = getNegWeights(weights, mv_pars, io);
     bool bound_success = false;
 
     computeAnalogMVSinglePass(
@@ -890,7 +1153,7 @@ inline bool ForwardBackwardPassIOManaged<T>::computeAnalogMV(
     }
 
     if (io.mv_type == AnalogMVType::PosNegSeparate) {
-      bound_success = finalizeOutput(out_values, out_size, out_inc, mv_pars, io);
+      bound_success = finalize(out_values, out_inc);
     }
 
     return bound_success;
@@ -900,53 +1163,246 @@ inline bool ForwardBackwardPassIOManaged<T>::computeAnalogMV(
   }
 }
 
+template <typename T>
+inline void ForwardBackwardPassIOManaged<T>::computeAnalogMVBatch(
+    T **weights,
+    const T *org_in_values,
+    const int in_size,
+    const bool in_trans,
+    T *out_values,
+    const int out_size,
+    const bool out_trans,
+    const int m_batch,
+    const T *scale_values,
+    const bool scaling,
+    int *bound_test_passed,
+    const MVParameter<T> &mv_pars,
+    const IOMetaParameter<T> &io,
+    const bool transposed,
+    const bool is_test,
+    const bool keep_analog) {
+
+  UNUSED(is_test);
+  const int in_offset = in_trans ? 1 : in_size;
+  const int in_inc = in_trans ? m_batch : 1;
+  const int out_offset = out_trans ? 1 : out_size;
+  const int out_inc = out_trans ? m_batch : 1;
+
+  // one-hot inputs of forwardOneHotMatrix: without input noise and
+  // stochastic rounding the zeros pass the DAC unchanged
+  const bool one_hot = one_hot_col_start_ >= 0 && !transposed && !in_trans &&
+                       io.inp_noise <= (T)0.0 && !io.inp_sto_round;
+
+  // scale, apply bound, discretize and scale and input noise. Prepared
+  // inputs are stored as [m_batch x in_size] so that each sample is contiguous
+  in_matrix_buffer_values_.resize((size_t)m_batch * in_size);
+  T *in_values = in_matrix_buffer_values_.data();
+  for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+    T *in = in_values + (size_t)i_batch * in_size;
+    const T *org_in = org_in_values + (size_t)i_batch * in_offset;
+    if (one_hot) {
+      int j = one_hot_col_start_ + i_batch;
+      std::fill(in, in + in_size, (T)0.0);
+      prepareInput(
+          in + j, org_in + (size_t)j * in_inc, 1, in_inc, scale_values[i_batch], scaling, io);
+    } else {
+      prepareInput(in, org_in, in_size, in_inc, scale_values[i_batch], scaling, io);
+    }
+  }
+
+  // applies all the sample-wise non-idealities on the GEMM result
+  auto apply_non_idealities = [&](T **w, const T *in, T *out, int offset, int inc) -> void {
+    const T *noise_var =
+        computeOutputWeightNoiseVariance(w, in, in_size, out_size, m_batch, io, transposed);
+    for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+      applyNonIdealities(
+          w, out + (size_t)i_batch * offset, out_size, inc, in + (size_t)i_batch * in_size, in_size,
+          mv_pars, io, transposed,
+          noise_var != nullptr ? noise_var + (size_t)i_batch * out_size : nullptr);
+    }
+  };
+  auto finalize = [&](T *out, int offset, int inc, bool combine) -> void {
+    for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+      bool passed = finalizeOutput(out + (size_t)i_batch * offset, out_size, inc, mv_pars, io);
+      bound_test_passed[i_batch] = combine ? (passed && bound_test_passed[i_batch]) : passed;
+    }
+  };
+  // same, but keeps the pre-ADC results [m_batch x out_size] for the rescaled bound management
+  auto finalize_keep = [&](T *out, int offset, int inc) -> void {
+    analog_matrix_buffer_values_.resize((size_t)m_batch * out_size);
+    analog_noise_matrix_values_.resize((size_t)m_batch * out_size);
+    for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+      bound_test_passed[i_batch] = finalizeOutputKeepAnalog(
+          out + (size_t)i_batch * offset, out_size, inc,
+          analog_matrix_buffer_values_.data() + (size_t)i_batch * out_size,
+          analog_noise_matrix_values_.data() + (size_t)i_batch * out_size, mv_pars, io);
+    }
+  };
+
+  switch (io.mv_type) {
+  case AnalogMVType::OnePass: {
+    // this is the standard one pass MV
+    if (one_hot) {
+      // MV of a one-hot input is just the (scaled) weight column
+      const int col_start = one_hot_col_start_;
+#pragma omp parallel for if ((size_t)m_batch * out_size > 65536)
+      for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+        int j = col_start + i_batch;
+        T value = in_values[(size_t)i_batch * in_size + j];
+        T *out = out_values + (size_t)i_batch * out_offset;
+        int i_out = 0;
+        for (int i = 0; i < out_size; ++i) {
+          out[i_out] = value * weights[i][j];
+          i_out += out_inc;
+        }
+      }
+    } else {
+      this->gemm(
+          weights, in_values, in_size, false, out_values, out_size, out_trans, m_batch, (T)1.0,
+          (T)0.0, transposed);
+    }
+    apply_non_idealities(weights, in_values, out_values, out_offset, out_inc);
+    if (keep_analog) {
+      finalize_keep(out_values, out_offset, out_inc);
+    } else {
+      finalize(out_values, out_offset, out_inc, false);
+    }
+    return;
+  }
+
+  case AnalogMVType::PosNegSeparateDigitalSum:
+  case AnalogMVType::PosNegSeparate: {
+    size_t in_total = (size_t)m_batch * in_size;
+    pos_neg_matrix_buffer_values_.resize(in_total);
+    out_matrix_buffer_values_.resize((size_t)m_batch * out_size);
+    T *pos_neg_values = pos_neg_matrix_buffer_values_.data();
+    T *neg_out_values = out_matrix_buffer_values_.data();
+    bool digital_sum = io.mv_type == AnalogMVType::PosNegSeparateDigitalSum;
+
+    // note: input noise is applied already above... ignore
+    // first pass negative
+    PRAGMA_SIMD
+    for (size_t i = 0; i < in_total; ++i) {
+      pos_neg_values[i] = in_values[i] < (T)0 ? in_values[i] : (T)0.0;
+    }
+
+    T **neg_weights = getNegWeights(weights, mv_pars, io);
+    this->gemm(
+        neg_weights, pos_neg_values, in_size, false, neg_out_values, out_size, false, m_batch,
+        (T)1.0, (T)0.0, transposed);
+    apply_non_idealities(neg_weights, pos_neg_values, neg_out_values, out_size, 1);
+
+    if (digital_sum) {
+      finalize(neg_out_values, out_size, 1, false);
+    }
+
+    // second pass for positive, added to negative
+    PRAGMA_SIMD
+    for (size_t i = 0; i < in_total; ++i) {
+      pos_neg_values[i] = in_values[i] > (T)0 ? in_values[i] : (T)0.0;
+    }
+
+    this->gemm(
+        weights, pos_neg_values, in_size, false, out_values, out_size, out_trans, m_batch, (T)1.0,
+        (T)0.0, transposed);
+    apply_non_idealities(weights, pos_neg_values, out_values, out_offset, out_inc);
+
+    if (digital_sum) {
+      finalize(out_values, out_offset, out_inc, true);
+    }
+
+    for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+      T *out = out_values + (size_t)i_batch * out_offset;
+      const T *neg_out = neg_out_values + (size_t)i_batch * out_size;
+      int i_out = 0;
+      PRAGMA_SIMD
+      for (int j = 0; j < out_size; ++j) {
+        out[i_out] += neg_out[j];
+        i_out += out_inc;
+      }
+    }
+
+    if (!digital_sum) {
+      if (keep_analog) {
+        finalize_keep(out_values, out_offset, out_inc);
+      } else {
+        finalize(out_values, out_offset, out_inc, false);
+      }
+    }
+    return;
+  }
+  default:
+    RPU_FATAL("AnalogMVType not implemented.");
+  }
+}
+
 /********************************************************************************/
 /*  public entries with noise / bound management */
 
 template <typename T>
-void ForwardBackwardPassIOManaged<T>::forwardVector(
+inline bool ForwardBackwardPassIOManaged<T>::isBoundManagementExhausted(
+    const T reduction, const IOMetaParameter<T> &io) const {
+  return ((int)reduction > io.max_bm_factor) ||
+         ((io.inp_res > (T)0.0) && (reduction > io.max_bm_res / io.inp_res));
+}
+
+template <typename T>
+inline bool
+ForwardBackwardPassIOManaged<T>::canRescaleAnalog(const IOMetaParameter<T> &io) const {
+  // the analog result needs to be linear in the input scale (IR drop
+  // and series resistance are not) and finalized in one go
+  return io.bm_rescale_analog && io.bound_management != BoundManagementType::None &&
+         (io.mv_type == AnalogMVType::OnePass || io.mv_type == AnalogMVType::PosNegSeparate) &&
+         io.ir_drop <= (T)0.0 && io.r_series <= (T)0.0;
+}
+
+template <typename T>
+inline bool ForwardBackwardPassIOManaged<T>::isInputUnclipped(
+    const T *x_input,
+    const int x_size,
+    const int x_inc,
+    const T scale,
+    const IOMetaParameter<T> &io) const {
+  if (io.inp_bound <= (T)0.0) {
+    return true;
+  }
+  T max_input = 0.0;
+  int j_x = 0;
+  for (int j = 0; j < x_size; ++j) {
+    T value = (T)fabsf(x_input[j_x]);
+    max_input = value > max_input ? value : max_input;
+    j_x += x_inc;
+  }
+  return max_input * scale <= io.inp_bound;
+}
+
+template <typename T>
+inline T ForwardBackwardPassIOManaged<T>::forwardVectorBoundManaged(
     T **weights,
     const T *x_input,
     const int x_inc,
     T *d_output,
     const int d_inc,
-    const T alpha,
-    const bool is_test) {
-  if (f_io_.isPerfect()) {
-    // short-cut for FP
-    ForwardBackwardPass<T>::forwardVector(
-        weights, x_input, x_inc, d_output, d_inc, f_io_.out_scale * alpha, is_test);
-    return;
-  }
-  if (!checked_implemented_) {
-    ensureImplemented();
-    checked_implemented_ = true;
-  }
-  T nm_scale_value = computeNoiseManagement(
-      x_input, this->x_size_, x_inc, f_io_.noise_management, aux_nm_value_, f_io_);
+    T nm_scale_value,
+    int bm_round,
+    T reduction_due_to_bound_management,
+    const bool is_test,
+    const T *analog_values,
+    const T *analog_noise_values,
+    T analog_scale) {
+  // bound management loop. Returns the final input scale. Can be
+  // started at a later round (with the state of the round before).
+  // If given (or kept in the first round), the later rounds are
+  // derived from the pre-ADC result of the analog_scale round
+
   bool nm = f_io_.noise_management != NoiseManagementType::None;
   bool bm = f_io_.bound_management != BoundManagementType::None;
-
-  if (nm && (nm_scale_value <= (T)0.0) && (f_io_.inp_noise <= (T)0.0)) {
-    // short cut. output will be zero anyway
-    int i_d = 0;
-    PRAGMA_SIMD
-    for (int i = 0; i < this->d_size_; ++i) {
-      d_output[i_d] = (T)0.0;
-      i_d += d_inc;
-    }
-    return;
-  }
-
-  T out_scale = (T)1.0;
-  out_scale = f_io_.out_scale * alpha;
+  bool rescale = canRescaleAnalog(f_io_);
 
   bool bound_test_passed = false;
-  T reduction_due_to_bound_management = 0.5;
   T scale = 1.;
   bool scaling = false;
 
-  int bm_round = 0;
   while (bound_test_passed == false) {
 
     bound_test_passed = true;
@@ -974,25 +1430,209 @@ void ForwardBackwardPassIOManaged<T>::forwardVector(
       scaling = true;
     }
 
-    bound_test_passed = computeAnalogMV(
-        weights, x_input, this->x_size_, x_inc, d_output, this->d_size_, d_inc, scale, scaling,
-        this->fb_pars_.fwd, f_io_, false, is_test);
+    if (analog_values != nullptr) {
+      bound_test_passed = rescaleAnalogOutput(
+          d_output, this->d_size_, d_inc, analog_values, analog_noise_values,
+          scale / analog_scale, this->fb_pars_.fwd, f_io_);
+    } else {
+      bool keep_analog = rescale && isInputUnclipped(x_input, this->x_size_, x_inc, scale, f_io_);
+      bound_test_passed = computeAnalogMV(
+          weights, x_input, this->x_size_, x_inc, d_output, this->d_size_, d_inc, scale, scaling,
+          this->fb_pars_.fwd, f_io_, false, is_test, keep_analog);
+      if (keep_analog) {
+        analog_values = analog_buffer_values_.data();
+        analog_noise_values = analog_noise_values_.data();
+        analog_scale = scale;
+      }
+    }
 
     if (bm) {
-      bound_test_passed =
-          bound_test_passed || (((int)reduction_due_to_bound_management > f_io_.max_bm_factor) ||
-                                ((f_io_.inp_res > (T)0.0) && (reduction_due_to_bound_management >
-                                                              f_io_.max_bm_res / f_io_.inp_res)));
+      bound_test_passed = bound_test_passed ||
+                          isBoundManagementExhausted(reduction_due_to_bound_management, f_io_);
     } else {
       bound_test_passed = true;
     }
   }
+  return scale;
+}
 
-  if (scaling || out_scale != (T)1.0) {
+template <typename T>
+void ForwardBackwardPassIOManaged<T>::forwardVector(
+    T **weights,
+    const T *x_input,
+    const int x_inc,
+    T *d_output,
+    const int d_inc,
+    const T alpha,
+    const bool is_test) {
+  if (f_io_.isPerfect()) {
+    // short-cut for FP
+    ForwardBackwardPass<T>::forwardVector(
+        weights, x_input, x_inc, d_output, d_inc, f_io_.out_scale * alpha, is_test);
+    return;
+  }
+  if (!checked_implemented_) {
+    ensureImplemented();
+    checked_implemented_ = true;
+  }
+  T nm_scale_value = computeNoiseManagement(
+      x_input, this->x_size_, x_inc, f_io_.noise_management, aux_nm_value_, f_io_);
+  bool nm = f_io_.noise_management != NoiseManagementType::None;
+
+  if (nm && (nm_scale_value <= (T)0.0) && (f_io_.inp_noise <= (T)0.0)) {
+    // short cut. output will be zero anyway
+    int i_d = 0;
+    PRAGMA_SIMD
+    for (int i = 0; i < this->d_size_; ++i) {
+      d_output[i_d] = (T)0.0;
+      i_d += d_inc;
+    }
+    return;
+  }
+
+  T out_scale = f_io_.out_scale * alpha;
+
+  T scale = forwardVectorBoundManaged(
+      weights, x_input, x_inc, d_output, d_inc, nm_scale_value, 0, 0.5, is_test);
+
+  if (scale != (T)1.0 || out_scale != (T)1.0) {
     RPU::math::scal<T>(this->d_size_, out_scale / scale, d_output, d_inc);
   }
 };
 
+template <typename T>
+void ForwardBackwardPassIOManaged<T>::forwardMatrix(
+    T **weights,
+    const T *X_input,
+    T *D_output,
+    const int m_batch,
+    const bool x_trans,
+    const bool d_trans,
+    const T alpha,
+    const bool is_test) {
+  if (f_io_.isPerfect()) {
+    // short-cut for FP
+    ForwardBackwardPass<T>::forwardMatrix(
+        weights, X_input, D_output, m_batch, x_trans, d_trans, f_io_.out_scale * alpha, is_test);
+    return;
+  }
+  if (!checked_implemented_) {
+    ensureImplemented();
+    checked_implemented_ = true;
+  }
+
+  const int x_offset = x_trans ? 1 : this->x_size_;
+  const int x_inc = x_trans ? m_batch : 1;
+  const int d_offset = d_trans ? 1 : this->d_size_;
+  const int d_inc = d_trans ? m_batch : 1;
+
+  bool nm = f_io_.noise_management != NoiseManagementType::None;
+  bool bm = f_io_.bound_management != BoundManagementType::None;
+  T out_scale = f_io_.out_scale * alpha;
+
+  // noise management (sequentially in case of running averages)
+  nm_scale_values_.resize(m_batch);
+  scale_values_.resize(m_batch);
+  bound_test_passed_.resize(m_batch);
+  for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+    T nm_scale_value = computeNoiseManagement(
+        X_input + (size_t)i_batch * x_offset, this->x_size_, x_inc, f_io_.noise_management,
+        aux_nm_value_, f_io_);
+    nm_scale_values_[i_batch] = nm_scale_value;
+    scale_values_[i_batch] = (nm && nm_scale_value > (T)0.0) ? (T)1.0 / nm_scale_value : (T)1.0;
+  }
+
+  // first round of all samples in one go
+  bool rescale = canRescaleAnalog(f_io_);
+  computeAnalogMVBatch(
+      weights, X_input, this->x_size_, x_trans, D_output, this->d_size_, d_trans, m_batch,
+      scale_values_.data(), nm || bm, bound_test_passed_.data(), this->fb_pars_.fwd, f_io_, false,
+      is_test, rescale);
+
+  for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+    T *d_output = D_output + (size_t)i_batch * d_offset;
+    T nm_scale_value = nm_scale_values_[i_batch];
+
+    if (nm && (nm_scale_value <= (T)0.0) && (f_io_.inp_noise <= (T)0.0)) {
+      // short cut. output will be zero anyway
+      int i_d = 0;
+      PRAGMA_SIMD
+      for (int i = 0; i < this->d_size_; ++i) {
+        d_output[i_d] = (T)0.0;
+        i_d += d_inc;
+      }
+      continue;
+    }
+
+    T scale = scale_values_[i_batch];
+    if (bm && !bound_test_passed_[i_batch] && !isBoundManagementExhausted((T)1.0, f_io_)) {
+      // only the saturated samples continue the bound management individually
+      const T *x_input = X_input + (size_t)i_batch * x_offset;
+      if (rescale && isInputUnclipped(x_input, this->x_size_, x_inc, scale, f_io_)) {
+        scale = forwardVectorBoundManaged(
+            weights, x_input, x_inc, d_output, d_inc, nm_scale_value, 1, 1.0, is_test,
+            analog_matrix_buffer_values_.data() + (size_t)i_batch * this->d_size_,
+            analog_noise_matrix_values_.data() + (size_t)i_batch * this->d_size_, scale);
+      } else {
+        scale = forwardVectorBoundManaged(
+            weights, x_input, x_inc, d_output, d_inc, nm_scale_value, 1, 1.0, is_test);
+      }
+    }
+
+    if (scale != (T)1.0 || out_scale != (T)1.0) {
+      RPU::math::scal<T>(this->d_size_, out_scale / scale, d_output, d_inc);
+    }
+  }
+}
+
+template <typename T>
+void ForwardBackwardPassIOManaged<T>::forwardOneHotMatrix(
+    T **weights,
+    const int col_start,
+    T *D_output,
+    const int m_batch,
+    const T alpha,
+    const bool is_test) {
+
+  if (col_start < 0 || m_batch < 0 || col_start + m_batch > this->x_size_) {
+    RPU_FATAL("One-hot column block out of range.");
+  }
+  const int d_size = this->d_size_;
+
+  if (f_io_.isPerfect()) {
+    // short-cut for FP: plain copy of the block of columns
+    T out_scale = f_io_.out_scale * alpha;
+#pragma omp parallel for if ((size_t)m_batch * d_size > 65536)
+    for (int i = 0; i < d_size; ++i) {
+      const T *w_row = weights[i] + col_start;
+      T *d_output = D_output + (size_t)i * m_batch;
+      PRAGMA_SIMD
+      for (int j = 0; j < m_batch; ++j) {
+        d_output[j] = out_scale * w_row[j];
+      }
+    }
+    return;
+  }
+
+  // only the hot entries are set (and reset again afterwards)
+  size_t size = (size_t)m_batch * this->x_size_;
+  if (one_hot_matrix_values_.size() < size) {
+    one_hot_matrix_values_.resize(size, (T)0.0);
+  }
+  T *x_input = one_hot_matrix_values_.data();
+  for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+    x_input[(size_t)i_batch * this->x_size_ + col_start + i_batch] = (T)1.0;
+  }
+
+  one_hot_col_start_ = col_start;
+  forwardMatrix(weights, x_input, D_output, m_batch, false, true, alpha, is_test);
+  one_hot_col_start_ = -1;
+
+  for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+    x_input[(size_t)i_batch * this->x_size_ + col_start + i_batch] = (T)0.0;
+  }
+}
+
 template <typename T>
 void ForwardBackwardPassIOManaged<T>::backwardVector(
     T **weights, const T *d_input, const int d_inc, T *x_output, const int x_inc, const T alpha) {
@@ -1031,6 +1671,69 @@ void ForwardBackwardPassIOManaged<T>::backwardVector(
     RPU::math::scal<T>(this->x_size_, out_scale * nm_scale_value, x_output, x_inc);
   }
 };
+template <typename T>
+void ForwardBackwardPassIOManaged<T>::backwardMatrix(
+    T **weights,
+    const T *D_input,
+    T *X_output,
+    const int m_batch,
+    const bool d_trans,
+    const bool x_trans,
+    const T alpha) {
+
+  if (b_io_.isPerfect()) {
+    // short-cut for FP
+    ForwardBackwardPass<T>::backwardMatrix(
+        weights, D_input, X_output, m_batch, d_trans, x_trans, b_io_.out_scale * alpha);
+    return;
+  }
+
+  const int d_offset = d_trans ? 1 : this->d_size_;
+  const int d_inc = d_trans ? m_batch : 1;
+  const int x_offset = x_trans ? 1 : this->x_size_;
+  const int x_inc = x_trans ? m_batch : 1;
+
+  // io managed version
+  b_io_.bound_management = BoundManagementType::None; // not supported
+  bool nm = b_io_.noise_management != NoiseManagementType::None;
+  T out_scale = b_io_.out_scale * alpha;
+
+  nm_scale_values_.resize(m_batch);
+  scale_values_.resize(m_batch);
+  bound_test_passed_.resize(m_batch);
+  for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+    T nm_scale_value = computeNoiseManagement(
+        D_input + (size_t)i_batch * d_offset, this->d_size_, d_inc, b_io_.noise_management,
+        aux_nm_value_, b_io_);
+    nm_scale_values_[i_batch] = nm_scale_value;
+    scale_values_[i_batch] = nm_scale_value > (T)0.0 ? (T)1.0 / nm_scale_value : (T)1.0;
+  }
+
+  computeAnalogMVBatch(
+      weights, D_input, this->d_size_, d_trans, X_output, this->x_size_, x_trans, m_batch,
+      scale_values_.data(), nm, bound_test_passed_.data(), this->fb_pars_.bwd, b_io_, true, false);
+
+  for (int i_batch = 0; i_batch < m_batch; ++i_batch) {
+    T *x_output = X_output + (size_t)i_batch * x_offset;
+    T nm_scale_value = nm_scale_values_[i_batch];
+
+    if (nm && (nm_scale_value <= (T)0.0)) {
+      // max is zero. output is just zero. short-cut
+      int j_x = 0;
+      PRAGMA_SIMD
+      for (int j = 0; j < this->x_size_; j++) {
+        x_output[j_x] = (T)0.0;
+        j_x += x_inc;
+      }
+      continue;
+    }
+
+    T scale_back = nm ? out_scale * nm_scale_value : out_scale;
+    if (scale_back != (T)1.0) {
+      RPU::math::scal<T>(this->x_size_, scale_back, x_output, x_inc);
+    }
+  }
+};
 #undef CHECK_INPUT_BOUNDS
 
 template <typename T>
@@ -1051,6 +1754,7 @@ void ForwardBackwardPassIOManaged<T>::loadExtra(
 
   auto state = RPU::selectWithPrefix(extra, prefix);
   RPU::load(state, "aux_nm_value", aux_nm_value_, strict);
+  invalidateWeightsCache();
 }
 
 template class ForwardBackwardPassIOManaged<float>;
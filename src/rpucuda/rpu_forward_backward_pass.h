@@ -14,6 +14,7 @@
 
 #include "rng.h"
 #include "rpu_pulsed_meta_parameter.h"
+#include <array>
 #include <memory>
 
 namespace RPU {
@@ -55,7 +56,7 @@ public:
   }
 
   const FBParameter<T> &getFBParameter() const { return fb_pars_; };
-  void setFBParameter(FBParameter<T> fb_pars) { fb_pars_ = fb_pars; };
+  virtual void setFBParameter(FBParameter<T> fb_pars) { fb_pars_ = fb_pars; };
 
   virtual void forwardVector(
       T **weights,
@@ -69,6 +70,25 @@ public:
   virtual void backwardVector(
       T **weights, const T *d_input, const int d_inc, T *x_output, const int x_inc, const T alpha);
 
+  virtual void forwardMatrix(
+      T **weights,
+      const T *X_input,
+      T *D_output,
+      const int m_batch,
+      const bool x_trans,
+      const bool d_trans,
+      const T alpha,
+      const bool is_test);
+
+  virtual void backwardMatrix(
+      T **weights,
+      const T *D_input,
+      T *X_output,
+      const int m_batch,
+      const bool d_trans,
+      const bool x_trans,
+      const T alpha);
+
   inline void gemv(
       T **weights,
       const T *in_values,
@@ -81,6 +101,21 @@ public:
       const T beta,
       const bool transpose);
 
+  /* batched version of gemv: in [m_batch x in_size] (or transposed
+     [in_size x m_batch] if in_trans) to out likewise*/
+  inline void gemm(
+      T **weights,
+      const T *in_values,
+      const int in_size,
+      const bool in_trans,
+      T *out_values,
+      const int out_size,
+      const bool out_trans,
+      const int m_batch,
+      const T alpha,
+      const T beta,
+      const bool transposed);
+
   virtual void dumpExtra(RPU::state_t &extra, const std::string prefix);
   virtual void loadExtra(const RPU::state_t &extra, const std::string prefix, bool strict);
 
@@ -113,10 +148,28 @@ public:
     swap(a.b_io_, b.b_io_);
     swap(a.checked_implemented_, b.checked_implemented_);
     swap(a.rng_, b.rng_);
+    swap(a.weights_version_, b.weights_version_);
+    swap(a.weights_version_set_, b.weights_version_set_);
+    swap(a.abs_weights_cache_, b.abs_weights_cache_);
+    swap(a.neg_weights_, b.neg_weights_);
+    swap(a.neg_weights_src_, b.neg_weights_src_);
+    swap(a.neg_weights_version_, b.neg_weights_version_);
+    swap(a.neg_weights_fwd_, b.neg_weights_fwd_);
+    swap(a.neg_weights_valid_, b.neg_weights_valid_);
 
     // others are tmps so far
   }
 
+  void setFBParameter(FBParameter<T> fb_pars) override;
+
+  /* Sets the version of the weights given to the following calls.
+     The version needs to change whenever the weight values change
+     and allows to cache quantities derived from the weights (|W|,
+     read asymmetry weights) across calls. Without a version (the
+     default) they are recomputed in each call. */
+  void setWeightsVersion(uint64_t version);
+  void resetWeightsVersion();
+
   void dumpExtra(RPU::state_t &extra, const std::string prefix) override;
   void loadExtra(const RPU::state_t &extra, const std::string prefix, bool strict) override;
 
@@ -133,6 +186,44 @@ public:
       T **weights, const T *d_input, const int d_inc, T *x_output, const int x_inc, const T alpha)
       override;
 
+  /* Batched versions: the MVM is computed as one GEMM over the
+     batch, all per-sample management and non-idealities are applied
+     on the output block afterwards. Statistically equivalent to the
+     looped vector versions */
+  void forwardMatrix(
+      T **weights,
+      const T *X_input,
+      T *D_output,
+      const int m_batch,
+      const bool x_trans,
+      const bool d_trans,
+      const T alpha,
+      const bool is_test) override;
+
+  void backwardMatrix(
+      T **weights,
+      const T *D_input,
+      T *X_output,
+      const int m_batch,
+      const bool d_trans,
+      const bool x_trans,
+      const T alpha) override;
+
+  /* Forward pass of the one-hot inputs e_{col_start}, ...,
+     e_{col_start + m_batch - 1}, ie. a read-out of m_batch weight
+     columns into D_output [d_size x m_batch]. Same statistics as
+     forwardMatrix on the corresponding block of the identity, but
+     the DAC stage only converts the hot entries (if input noise and
+     stochastic rounding are off) and the analog GEMM becomes a
+     column gather */
+  void forwardOneHotMatrix(
+      T **weights,
+      const int col_start,
+      T *D_output,
+      const int m_batch,
+      const T alpha,
+      const bool is_test);
+
   void populateFBParameter(const IOMetaParameter<T> &f_io_, const IOMetaParameter<T> &b_io_);
 
   inline bool computeAnalogMV(
@@ -148,9 +239,45 @@ public:
       const MVParameter<T> &mv_pars,
       const IOMetaParameter<T> &io,
       const bool transposed,
-      const bool is_test);
+      const bool is_test,
+      const bool keep_analog = false);
+
+  inline void computeAnalogMVBatch(
+      T **weights,
+      const T *org_in_values,
+      const int in_size,
+      const bool in_trans,
+      T *out_values,
+      const int out_size,
+      const bool out_trans,
+      const int m_batch,
+      const T *scale_values,
+      const bool scaling,
+      int *bound_test_passed,
+      const MVParameter<T> &mv_pars,
+      const IOMetaParameter<T> &io,
+      const bool transposed,
+      const bool is_test,
+      const bool keep_analog = false);
 
 protected:
+  // fills and returns the internal buffer with size Gaussian numbers
+  inline const T *sampleGaussValues(int size);
+
+  /* returns |W| (same layout as weights), cached for a set weights version */
+  inline T *getAbsWeights(T **weights);
+
+  /* computes the PCM read noise variances |W| x.^2 for the whole
+     batch [m_batch x in_size] into [m_batch x out_size] with one GEMM */
+  inline const T *computeOutputWeightNoiseVariance(
+      T **weights,
+      const T *in_values,
+      const int in_size,
+      const int out_size,
+      const int m_batch,
+      const IOMetaParameter<T> &io,
+      const bool transposed);
+
   inline void applyOutputWeightNoise(
       T **weights,
       T *out_values,
@@ -159,7 +286,8 @@ protected:
       const T *in_values,
       const int in_size,
       const IOMetaParameter<T> &io,
-      const bool transposed);
+      const bool transposed,
+      const T *noise_var_values = nullptr);
 
   inline void applyIrDrop(
       T **weights,
@@ -190,7 +318,8 @@ protected:
       const int in_size,
       const MVParameter<T> &mv_pars,
       const IOMetaParameter<T> &io,
-      const bool transposed);
+      const bool transposed,
+      const T *noise_var_values = nullptr);
 
   inline const T *computeTotalCurrent(
       T **weights,
@@ -199,6 +328,15 @@ protected:
       const int in_size,
       const bool transposed);
 
+  inline T *prepareInput(
+      T *out_values,
+      const T *in_values,
+      const int in_size,
+      const int in_inc,
+      const T scale,
+      const bool scaling,
+      const IOMetaParameter<T> &io);
+
   inline T *prepareInput(
       const T *in_values,
       const int in_size,
@@ -214,6 +352,36 @@ protected:
       const MVParameter<T> &mv_pars,
       const IOMetaParameter<T> &io);
 
+  inline bool finalizeOutput(
+      T *out_values,
+      const int out_size,
+      const int out_inc,
+      const MVParameter<T> &mv_pars,
+      const IOMetaParameter<T> &io,
+      const T *noise_values);
+
+  /* finalizes the output after storing the pre-ADC values and the
+     output noise draws (both contiguous of out_size) */
+  inline bool finalizeOutputKeepAnalog(
+      T *out_values,
+      const int out_size,
+      const int out_inc,
+      T *analog_values,
+      T *noise_values,
+      const MVParameter<T> &mv_pars,
+      const IOMetaParameter<T> &io);
+
+  /* re-derives the output from kept pre-ADC values scaled by ratio */
+  inline bool rescaleAnalogOutput(
+      T *out_values,
+      const int out_size,
+      const int out_inc,
+      const T *analog_values,
+      const T *noise_values,
+      const T ratio,
+      const MVParameter<T> &mv_pars,
+      const IOMetaParameter<T> &io);
+
   inline void computeAnalogMVSinglePass(
       T **weights,
       const T *in_values,
@@ -230,8 +398,33 @@ protected:
 
 private:
   inline void ensureImplemented();
+  void invalidateWeightsCache();
+  inline T **
+  getNegWeights(T **weights, const MVParameter<T> &mv_pars, const IOMetaParameter<T> &io);
+  inline bool isBoundManagementExhausted(const T reduction, const IOMetaParameter<T> &io) const;
+  inline bool canRescaleAnalog(const IOMetaParameter<T> &io) const;
+  inline bool isInputUnclipped(
+      const T *x_input,
+      const int x_size,
+      const int x_inc,
+      const T scale,
+      const IOMetaParameter<T> &io) const;
+  inline T forwardVectorBoundManaged(
+      T **weights,
+      const T *x_input,
+      const int x_inc,
+      T *d_output,
+      const int d_inc,
+      T nm_scale_value,
+      int bm_round,
+      T reduction_due_to_bound_management,
+      const bool is_test,
+      const T *analog_values = nullptr,
+      const T *analog_noise_values = nullptr,
+      T analog_scale = (T)0.0);
 
   // tmp for non-ideal computations
+  std::vector<T> gauss_values_;
   std::vector<T> tmp_in_values_;
   std::vector<T> tmp_out_values_;
   std::vector<T> tmp_c_values_;
@@ -242,8 +435,44 @@ private:
   std::vector<T> out_buffer_values_;
   std::vector<T> pos_neg_buffer_values_;
 
+  // batch buffers for the matrix versions
+  std::vector<T> in_matrix_buffer_values_;
+  std::vector<T> out_matrix_buffer_values_;
+  std::vector<T> pos_neg_matrix_buffer_values_;
+  std::vector<T> scale_values_;
+  std::vector<T> nm_scale_values_;
+  std::vector<int> bound_test_passed_;
+
+  // one-hot input block of forwardOneHotMatrix (kept zero between calls)
+  std::vector<T> one_hot_matrix_values_;
+  int one_hot_col_start_ = -1;
+
+  // pre-ADC results and output noise kept for the rescaled bound management
+  std::vector<T> analog_buffer_values_;
+  std::vector<T> analog_noise_values_;
+  std::vector<T> analog_matrix_buffer_values_;
+  std::vector<T> analog_noise_matrix_values_;
+
   T **neg_weights_ = nullptr;
 
+  // weights version and the caches derived from the weights
+  struct AbsWeightsCacheEntry {
+    const T *weights = nullptr;
+    const T *src = nullptr; // source of the neg weights, if these are cached
+    uint64_t version = 0;
+    bool valid = false;
+    std::vector<T> values;
+  };
+  uint64_t weights_version_ = 0;
+  bool weights_version_set_ = false;
+  std::array<AbsWeightsCacheEntry, 2> abs_weights_cache_; // pos and neg weights
+  const T *neg_weights_src_ = nullptr;
+  uint64_t neg_weights_version_ = 0;
+  bool neg_weights_fwd_ = true;
+  bool neg_weights_valid_ = false;
+  std::vector<T> noise_var_matrix_values_;
+  std::vector<T> abs_in_values_;
+
   T aux_nm_value_ = -1.0;
   IOMetaParameter<T> f_io_;
   IOMetaParameter<T> b_io_;
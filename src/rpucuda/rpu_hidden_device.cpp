@@ -104,11 +104,8 @@ inline void update_once(
 template <typename T>
 void HiddenStepRPUDevice<T>::doSparseUpdate(
     T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng) {
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *w = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
   T *hw = hidden_weights_[i];
   T *hs_scale_down = hs_scale_down_[i];
   T *hs_scale_up = hs_scale_up_[i];
@@ -116,19 +113,17 @@ void HiddenStepRPUDevice<T>::doSparseUpdate(
   const auto &par = getPar();
 
   PULSED_UPDATE_W_LOOP(update_once(
-                           w[j], sign, hw[j], min_bound[j], max_bound[j], scale_down[j],
-                           scale_up[j], hs_scale_down[j], hs_scale_up[j], par.dw_min_std,
-                           par.hs_dw_min_std, rng););
+                           w[j], sign, hw[j], pack[j].min_bound, pack[j].max_bound,
+                           pack[j].scale_down, pack[j].scale_up, hs_scale_down[j], hs_scale_up[j],
+                           par.dw_min_std, par.hs_dw_min_std, rng););
 }
 
 template <typename T>
-void HiddenStepRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+void HiddenStepRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
 
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  auto *pack = this->getPackedUpdateParameters();
   T *w = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
   T *hw = hidden_weights_[0];
   T *hs_scale_down = hs_scale_down_[0];
   T *hs_scale_up = hs_scale_up_[0];
@@ -136,9 +131,9 @@ void HiddenStepRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T
   const auto &par = getPar();
 
   PULSED_UPDATE_W_LOOP_DENSE(update_once(
-                                 w[j], sign, hw[j], min_bound[j], max_bound[j], scale_down[j],
-                                 scale_up[j], hs_scale_down[j], hs_scale_up[j], par.dw_min_std,
-                                 par.hs_dw_min_std, rng););
+                                 w[j], sign, hw[j], pack[j].min_bound, pack[j].max_bound,
+                                 pack[j].scale_down, pack[j].scale_up, hs_scale_down[j],
+                                 hs_scale_up[j], par.dw_min_std, par.hs_dw_min_std, rng););
 }
 
 template class HiddenStepRPUDevice<float>;
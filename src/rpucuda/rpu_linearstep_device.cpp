@@ -168,6 +168,63 @@ inline void update_once_add(
     w_apparent = w + write_noise_std * rng->sampleGauss();
   }
 }
+
+template <typename T>
+inline void update_n_pulses(
+    T &w,
+    T &w_apparent,
+    const int n,
+    int &sign,
+    T &scale_down,
+    T &scale_up,
+    T &slope_down,
+    T &slope_up,
+    T &min_bound,
+    T &max_bound,
+    const T &dw_min_std,
+    const bool mult_noise,
+    const T &write_noise_std,
+    RNG<T> *rng) {
+  // one (noise-free) pulse is the affine map w <- (1 + a) * w + b
+  T a = sign > 0 ? -slope_down : slope_up;
+  T b = sign > 0 ? -scale_down : scale_up;
+  T w_start = w;
+
+  // first pulse separately since w might start out of bounds
+  w += a * w + b;
+  w = MAX(w, min_bound);
+  w = MIN(w, max_bound);
+
+  int m = n - 1;
+  if (a > (T)-1.0) {
+    // remaining m pulses: (1 + a)^m * w + b * sum_k (1 + a)^k. The
+    // unclipped iterates are monotone and never cross the fixed
+    // point, thus clipping once at the end is exact
+    T sum_q = a == (T)0.0 ? (T)m : (T)expm1f((float)m * log1pf((float)a)) / a;
+    w += a * sum_q * w + b * sum_q;
+  } else {
+    // oscillating map (overly steep slopes): no closed form
+    for (int k = 0; k < m; k++) {
+      w += a * w + b;
+      w = MAX(w, min_bound);
+      w = MIN(w, max_bound);
+    }
+  }
+
+  if (dw_min_std > (T)0.0) {
+    // sum of the n noisy steps approximated by one Gaussian
+    T dw_std = mult_noise ? (T)fabsf(w - w_start) / (T)sqrtf((float)n)
+                          : (T)fabsf(b) * (T)sqrtf((float)n);
+    w += dw_min_std * dw_std * rng->sampleGauss();
+  }
+  w = MAX(w, min_bound);
+  w = MIN(w, max_bound);
+
+  // write noise is redrawn on each pulse, thus only the last one matters
+  if (write_noise_std > (T)0.0) {
+    w_apparent = w + write_noise_std * rng->sampleGauss();
+  }
+}
 } // namespace
 
 template <typename T>
@@ -176,54 +233,63 @@ void LinearStepRPUDevice<T>::doSparseUpdate(
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *slope_down = w_slope_down_[i];
   T *slope_up = w_slope_up_[i];
   T *w = par.usesPersistentWeight() ? this->w_persistent_[i] : weights[i];
   T *w_apparent = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
 
   T write_noise_std = par.getScaledWriteNoise();
   if (par.ls_mult_noise) {
     PULSED_UPDATE_W_LOOP(update_once_mult(
-                             w[j], w_apparent[j], sign, scale_down[j], scale_up[j], slope_down[j],
-                             slope_up[j], min_bound[j], max_bound[j], par.dw_min_std,
-                             write_noise_std, rng););
+                             w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                             slope_down[j], slope_up[j], pack[j].min_bound, pack[j].max_bound,
+                             par.dw_min_std, write_noise_std, rng););
   } else {
     PULSED_UPDATE_W_LOOP(update_once_add(
-                             w[j], w_apparent[j], sign, scale_down[j], scale_up[j], slope_down[j],
-                             slope_up[j], min_bound[j], max_bound[j], par.dw_min_std,
-                             write_noise_std, rng););
+                             w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                             slope_down[j], slope_up[j], pack[j].min_bound, pack[j].max_bound,
+                             par.dw_min_std, write_noise_std, rng););
   }
 }
 
 template <typename T>
-void LinearStepRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+void LinearStepRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  auto *pack = this->getPackedUpdateParameters();
   T *slope_down = w_slope_down_[0];
   T *slope_up = w_slope_up_[0];
   T *w = par.usesPersistentWeight() ? this->w_persistent_[0] : weights[0];
   T *w_apparent = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
   T write_noise_std = par.getScaledWriteNoise();
 
+  bool n_pulses_if = par.dw_min_std <= (T)0.0 || par.dense_update_noise_approx;
+
   if (par.ls_mult_noise) {
-    PULSED_UPDATE_W_LOOP_DENSE(update_once_mult(
-                                   w[j], w_apparent[j], sign, scale_down[j], scale_up[j],
-                                   slope_down[j], slope_up[j], min_bound[j], max_bound[j],
-                                   par.dw_min_std, write_noise_std, rng););
+    PULSED_UPDATE_W_LOOP_DENSE_N(
+        n_pulses_if,
+        update_n_pulses(
+            w[j], w_apparent[j], ac, sign, pack[j].scale_down, pack[j].scale_up, slope_down[j],
+            slope_up[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std, true,
+            write_noise_std, rng),
+        update_once_mult(
+            w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up, slope_down[j],
+            slope_up[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std, write_noise_std,
+            rng););
   } else {
-    PULSED_UPDATE_W_LOOP_DENSE(update_once_add(
-                                   w[j], w_apparent[j], sign, scale_down[j], scale_up[j],
-                                   slope_down[j], slope_up[j], min_bound[j], max_bound[j],
-                                   par.dw_min_std, write_noise_std, rng););
+    PULSED_UPDATE_W_LOOP_DENSE_N(
+        n_pulses_if,
+        update_n_pulses(
+            w[j], w_apparent[j], ac, sign, pack[j].scale_down, pack[j].scale_up, slope_down[j],
+            slope_up[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std, false,
+            write_noise_std, rng),
+        update_once_add(
+            w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up, slope_down[j],
+            slope_up[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std, write_noise_std,
+            rng););
   }
 }
 
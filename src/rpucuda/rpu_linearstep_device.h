@@ -200,7 +200,8 @@ template <typename T> class LinearStepRPUDevice : public PulsedRPUDevice<T> {
   void doSparseUpdate(
       T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng)
       override;
-  void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) override;
+  void doDenseUpdateRows(
+      T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) override;
 
 private:
   T **w_slope_up_ = nullptr;
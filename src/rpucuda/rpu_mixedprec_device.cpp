@@ -151,12 +151,7 @@ void MixedPrecRPUDevice<T>::populate(
 
 template <typename T>
 void MixedPrecRPUDevice<T>::forwardUpdate(
-    T **weights,
-    const T lr,
-    int j_row_start,
-    const T *transfer_d_vec,
-    const int n_vec,
-    const bool trans) {
+    T **weights, const T lr, int j_row_start, const int n_vec, const bool trans) {
 
   if (!lr) { // not used actually
     return;
@@ -165,30 +160,33 @@ void MixedPrecRPUDevice<T>::forwardUpdate(
     RPU_NOT_IMPLEMENTED;
   }
 
-  if (this->transfer_tmp_.size() < (size_t)this->x_size_) {
-    this->transfer_tmp_.resize(this->x_size_);
+  size_t tmp_size = (size_t)n_vec * this->x_size_;
+  if (this->transfer_tmp_.size() < tmp_size) {
+    this->transfer_tmp_.resize(tmp_size);
   }
 
   if (this->granularity_ <= (T)0.0) {
     RPU_FATAL("Granularity cannot be zero!");
   }
 
-  // forward / update
+  // forward
   for (size_t j = 0; j < (size_t)n_vec; j++) {
     T *chi_row = chi_[j_row_start + j];
+    T *tmp_row = this->transfer_tmp_.data() + j * this->x_size_;
 
     PRAGMA_SIMD
     for (size_t i = 0; i < (size_t)this->x_size_; i++) {
       T value = chi_row[i];
       T dw = (T)truncf(value / this->granularity_);
-      this->transfer_tmp_[i] = dw;
+      tmp_row[i] = dw;
       chi_row[i] = value - dw * this->granularity_;
     }
-
-    this->transfer_pwu_->updateVectorWithDevice(
-        weights, this->transfer_tmp_.data(), 1, transfer_d_vec + (size_t)this->d_size_ * j, 1,
-        this->granularity_ * lr, n_vec, &*this->rpu_device_);
   }
+
+  // update the block of rows
+  this->transfer_pwu_->updateRowsWithDevice(
+      weights, this->transfer_tmp_.data(), j_row_start, n_vec, this->granularity_ * lr, n_vec,
+      &*this->rpu_device_);
 }
 
 /*********************************************************************************/
@@ -117,12 +117,7 @@ public:
   void setChi(const T *data) override;
 
   void forwardUpdate(
-      T **weights,
-      const T lr,
-      int i_row_start,
-      const T *transfer_vec,
-      const int n_vec,
-      const bool trans) override;
+      T **weights, const T lr, int i_row_start, const int n_vec, const bool trans) override;
 
   void doDirectVectorUpdate(
       T **weights,
@@ -166,7 +166,6 @@ MixedPrecRPUDeviceBase<T>::MixedPrecRPUDeviceBase(const MixedPrecRPUDeviceBase<T
   current_row_index_ = other.current_row_index_;
   current_update_index_ = other.current_update_index_;
   transfer_tmp_ = other.transfer_tmp_;
-  transfer_d_vecs_ = other.transfer_d_vecs_;
   avg_sparsity_ = other.avg_sparsity_;
   granularity_ = other.granularity_;
 }
@@ -199,7 +198,6 @@ MixedPrecRPUDeviceBase<T>::operator=(MixedPrecRPUDeviceBase<T> &&other) noexcept
   current_row_index_ = other.current_row_index_;
   current_update_index_ = other.current_update_index_;
   transfer_tmp_ = std::move(other.transfer_tmp_);
-  transfer_d_vecs_ = std::move(other.transfer_d_vecs_);
   avg_sparsity_ = other.avg_sparsity_;
   granularity_ = other.granularity_;
 
@@ -259,7 +257,6 @@ void MixedPrecRPUDeviceBase<T>::dumpExtra(RPU::state_t &extra, const std::string
   RPU::insert(state, "current_update_index", current_update_index_);
   RPU::insert(state, "avg_sparsity", avg_sparsity_);
 
-  // transfer_d_vecs not handled (generated on the fly)
 
   RPU::insertWithPrefix(extra, state, prefix);
 }
@@ -316,7 +313,7 @@ template <typename T> void MixedPrecRPUDeviceBase<T>::computeSparsity(const int
 }
 
 template <typename T> void MixedPrecRPUDeviceBase<T>::transfer(T **weights, const T lr) {
-  // updating the matrix with rows of using one-hot transfer vectors
+  // updating the matrix rows (with implicit one-hot transfer vectors)
 
   const auto &par = getPar();
   if (par.n_rows_per_transfer == 0 || (T)fabsf(lr) == (T)0) {
@@ -333,26 +330,17 @@ template <typename T> void MixedPrecRPUDeviceBase<T>::transfer(T **weights, cons
         MIN((int)floorf(this->rw_rng_.sampleUniform() * (T)this->d_size_), this->d_size_ - 1), 0);
   }
 
-  int d2_size = this->d_size_ * this->d_size_;
-  // create transfer vectors on the fly
-  if (transfer_d_vecs_.size() < (size_t)d2_size) {
-    transfer_d_vecs_.resize(d2_size, (T)0.0);
-    for (int i = 0; i < d2_size; i += this->d_size_ + 1) {
-      transfer_d_vecs_[i] = 1.0;
-    }
-  }
-
-  T *tvec = transfer_d_vecs_.data() + (size_t)i_row * this->d_size_;
+  // rows are given by index (implicit one-hot transfer vectors)
   int n_rest = this->d_size_ - i_row;
 
   if (n_rest < n_transfers) {
     // rest
-    forwardUpdate(weights, lr, i_row, tvec, n_rest, false);
+    forwardUpdate(weights, lr, i_row, n_rest, false);
     // from beginning
-    forwardUpdate(weights, lr, 0, transfer_d_vecs_.data(), n_transfers - n_rest, false);
+    forwardUpdate(weights, lr, 0, n_transfers - n_rest, false);
 
   } else {
-    forwardUpdate(weights, lr, i_row, tvec, n_transfers, false);
+    forwardUpdate(weights, lr, i_row, n_transfers, false);
   }
   current_row_index_ = (i_row + n_transfers) % this->d_size_;
 }
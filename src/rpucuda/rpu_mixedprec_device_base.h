@@ -103,7 +103,6 @@ public:
     swap(a.current_row_index_, b.current_row_index_);
     swap(a.current_update_index_, b.current_update_index_);
 
-    swap(a.transfer_d_vecs_, b.transfer_d_vecs_);
     swap(a.avg_sparsity_, b.avg_sparsity_);
 
     swap(a.rw_rng_, b.rw_rng_);
@@ -150,12 +149,7 @@ protected:
   void computeSparsity(const int kx, const int kd);
   virtual void transfer(T **weights, const T lr);
   virtual void forwardUpdate(
-      T **weights,
-      const T lr,
-      int i_row_start,
-      const T *transfer_vec,
-      const int n_vec,
-      const bool trans) {
+      T **weights, const T lr, int i_row_start, const int n_vec, const bool trans) {
     RPU_NOT_IMPLEMENTED;
   };
 
@@ -173,7 +167,6 @@ protected:
 private:
   int current_row_index_ = 0;
   int64_t current_update_index_ = 0;
-  std::vector<T> transfer_d_vecs_;
   T avg_sparsity_ = 0.0f;
   const PulsedUpdateMetaParameter<T> *up_ptr_ = nullptr;
 };
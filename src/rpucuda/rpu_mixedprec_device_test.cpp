@@ -0,0 +1,184 @@
+/**
+ * (C) Copyright 2020, 2021, 2022, 2023, 2024 IBM. All Rights Reserved.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#include "rng.h"
+#include "rpu_constantstep_device.h"
+#include "rpu_mixedprec_device.h"
+#include "rpu_mixedprec_int_device.h"
+#include "rpu_vector_device.h"
+#include "utility_functions.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <tuple>
+
+namespace {
+
+using namespace RPU;
+
+/* mixed-precision device with a seeded transfer updater that
+   optionally transfers with explicit one-hot d vectors (one vector
+   update per row) instead of the row update */
+template <typename DeviceT> class TestTransferDevice : public DeviceT {
+public:
+  using DeviceT::DeviceT;
+
+  void seedTransfer(unsigned int seed) {
+    this->transfer_pwu_ = RPU::make_unique<PulsedRPUWeightUpdater<num_t>>(
+        this->x_size_, this->d_size_, std::make_shared<RNG<num_t>>(seed));
+  };
+
+  void forwardUpdate(
+      num_t **weights, const num_t lr, int j_row_start, const int n_vec, const bool trans)
+      override {
+
+    if (!one_hot) {
+      DeviceT::forwardUpdate(weights, lr, j_row_start, n_vec, trans);
+      return;
+    }
+
+    // quantize chi into transfer_tmp_ using scratch copies for the update
+    std::unique_ptr<AbstractRPUDevice<num_t>> device(this->rpu_device_->clone());
+    auto pwu = RPU::make_unique<PulsedRPUWeightUpdater<num_t>>(
+        this->x_size_, this->d_size_, std::make_shared<RNG<num_t>>(1));
+    pwu->setUpPar(this->transfer_pwu_->getUpPar());
+    num_t **w_scratch = Array_2D_Get<num_t>(this->d_size_, this->x_size_);
+    for (int i = 0; i < this->size_; i++) {
+      w_scratch[0][i] = weights[0][i];
+    }
+    std::swap(device, this->rpu_device_);
+    std::swap(pwu, this->transfer_pwu_);
+    DeviceT::forwardUpdate(w_scratch, lr, j_row_start, n_vec, trans);
+    std::swap(device, this->rpu_device_);
+    std::swap(pwu, this->transfer_pwu_);
+    Array_2D_Free<num_t>(w_scratch);
+
+    // one-hot vector updates
+    num_t transfer_lr = scale_lr ? this->granularity_ * lr : this->granularity_;
+    std::vector<num_t> d_vec(this->d_size_, (num_t)0.0);
+    for (int j = 0; j < n_vec; j++) {
+      d_vec[j_row_start + j] = (num_t)1.0;
+      this->transfer_pwu_->updateVectorWithDevice(
+          weights, this->transfer_tmp_.data() + j * this->x_size_, 1, d_vec.data(), 1,
+          transfer_lr, n_vec, &*this->rpu_device_);
+      d_vec[j_row_start + j] = (num_t)0.0;
+    }
+  };
+
+  bool one_hot = false;
+  bool scale_lr = true;
+};
+
+class MixedPrecRPUDeviceTestFixture
+    : public ::testing::TestWithParam<std::tuple<PulseType, bool>> {
+public:
+  void SetUp() {
+    x_size = 7;
+    d_size = 9;
+
+    up.pulse_type = std::get<0>(GetParam());
+    up.desired_BL = 31;
+
+    dp_cs.dw_min = 0.01;
+    dp_cs.dw_min_std = 0.3;
+    dp_cs.w_max = 1.0;
+    dp_cs.w_min = -1.0;
+
+    // a meta-device keeps a state across update cycles
+    dp_vec = VectorRPUDeviceMetaParameter<num_t>(dp_cs, 2);
+    dp_vec.update_policy = VectorDeviceUpdatePolicy::SingleSequential;
+  };
+
+  template <typename DeviceT, typename ParT> void checkTransfer(ParT &par, bool scale_lr) {
+    if (std::get<1>(GetParam())) {
+      par.setDevicePar(dp_vec);
+    } else {
+      par.setDevicePar(dp_cs);
+    }
+    par.transfer_every = 1;
+    par.n_rows_per_transfer = 4; // wraps around the rows
+
+    RealWorldRNG<num_t> rw_rng(1), rw_rng_ref(1), rw_rng_vec(2);
+    TestTransferDevice<DeviceT> rpu_device(x_size, d_size, par, &rw_rng);
+    TestTransferDevice<DeviceT> ref_device(x_size, d_size, par, &rw_rng_ref);
+    rpu_device.seedTransfer(3);
+    ref_device.seedTransfer(3);
+    ref_device.one_hot = true;
+    ref_device.scale_lr = scale_lr;
+
+    num_t **weights = Array_2D_Get<num_t>(d_size, x_size);
+    num_t **weights_ref = Array_2D_Get<num_t>(d_size, x_size);
+    for (int i = 0; i < x_size * d_size; i++) {
+      weights[0][i] = weights_ref[0][i] = (num_t)0.0;
+    }
+    rpu_device.onSetWeights(weights);
+    ref_device.onSetWeights(weights_ref);
+
+    std::vector<num_t> x_vec(x_size), d_vec(d_size);
+    for (int k = 0; k < 10; k++) {
+      for (auto &x : x_vec) {
+        x = rw_rng_vec.sampleGauss();
+      }
+      for (auto &d : d_vec) {
+        d = rw_rng_vec.sampleGauss();
+      }
+      rpu_device.doDirectVectorUpdate(weights, x_vec.data(), 1, d_vec.data(), 1, 0.1, 1, up);
+      ref_device.doDirectVectorUpdate(weights_ref, x_vec.data(), 1, d_vec.data(), 1, 0.1, 1, up);
+    }
+
+    std::vector<num_t> chi(x_size * d_size), chi_ref(x_size * d_size);
+    rpu_device.getChi(chi.data());
+    ref_device.getChi(chi_ref.data());
+
+    int n_changed = 0;
+    for (int i = 0; i < x_size * d_size; i++) {
+      ASSERT_EQ(weights[0][i], weights_ref[0][i]) << i;
+      ASSERT_EQ(chi[i], chi_ref[i]) << i;
+      n_changed += weights[0][i] != (num_t)0.0;
+    }
+    ASSERT_GT(n_changed, x_size * d_size / 2);
+
+    Array_2D_Free<num_t>(weights);
+    Array_2D_Free<num_t>(weights_ref);
+  };
+
+  int x_size, d_size;
+  PulsedUpdateMetaParameter<num_t> up;
+  ConstantStepRPUDeviceMetaParameter<num_t> dp_cs;
+  VectorRPUDeviceMetaParameter<num_t> dp_vec;
+};
+
+// sparse pulse type and whether to use a meta-device (vector unit cell)
+INSTANTIATE_TEST_CASE_P(
+    PulseTypeVectorDevice,
+    MixedPrecRPUDeviceTestFixture,
+    ::testing::Combine(
+        ::testing::Values(PulseType::StochasticCompressed, PulseType::DeterministicImplicit),
+        ::testing::Bool()));
+
+TEST_P(MixedPrecRPUDeviceTestFixture, TransferRowsVersusOneHot) {
+
+  MixedPrecRPUDeviceMetaParameter<num_t> par;
+  checkTransfer<MixedPrecRPUDevice<num_t>>(par, true);
+}
+
+TEST_P(MixedPrecRPUDeviceTestFixture, IntTransferRowsVersusOneHot) {
+
+  MixedPrecIntRPUDeviceMetaParameter<num_t> par;
+  checkTransfer<MixedPrecIntRPUDevice<num_t>>(par, false);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
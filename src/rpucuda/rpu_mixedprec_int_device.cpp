@@ -191,12 +191,7 @@ void MixedPrecIntRPUDevice<T>::loadExtra(
 
 template <typename T>
 void MixedPrecIntRPUDevice<T>::forwardUpdate(
-    T **weights,
-    const T lr,
-    int j_row_start,
-    const T *transfer_d_vec,
-    const int n_vec,
-    const bool trans) {
+    T **weights, const T lr, int j_row_start, const int n_vec, const bool trans) {
 
   if (!lr) { // not used actually
     return;
@@ -207,30 +202,33 @@ void MixedPrecIntRPUDevice<T>::forwardUpdate(
   }
 
   const auto &par = getPar();
-  if (this->transfer_tmp_.size() < (size_t)this->x_size_) {
-    this->transfer_tmp_.resize(this->x_size_);
+  size_t tmp_size = (size_t)n_vec * this->x_size_;
+  if (this->transfer_tmp_.size() < tmp_size) {
+    this->transfer_tmp_.resize(tmp_size);
   }
   T d_width = md_ / (T)(par.n_d_bins / 2);
   T x_width = mx_ / (T)(par.n_x_bins / 2); // needs to be integer div
   T momentum = par.momentum_chi;
   T thres = MAX((T)roundf(this->granularity_ / (T)fabsf(lr) / d_width / x_width), (T)1.0);
 
-  // forward / update
+  // forward
   for (size_t j = 0; j < (size_t)n_vec; j++) {
     int32_t *chi_row = chi_[j_row_start + j];
+    T *tmp_row = this->transfer_tmp_.data() + j * this->x_size_;
 
     PRAGMA_SIMD
     for (size_t i = 0; i < (size_t)this->x_size_; i++) {
       T value = (T)chi_row[i];
       T dw = (T)truncf(value / thres);
-      this->transfer_tmp_[i] = dw;
+      tmp_row[i] = dw;
       chi_row[i] = (int32_t)value - (int32_t)roundf(((T)1.0 - momentum) * thres * dw);
     }
-
-    this->transfer_pwu_->updateVectorWithDevice(
-        weights, this->transfer_tmp_.data(), 1, transfer_d_vec + (size_t)this->d_size_ * j, 1,
-        this->granularity_, n_vec, &*this->rpu_device_);
   }
+
+  // update the block of rows
+  this->transfer_pwu_->updateRowsWithDevice(
+      weights, this->transfer_tmp_.data(), j_row_start, n_vec, this->granularity_, n_vec,
+      &*this->rpu_device_);
 }
 
 /*********************************************************************************/
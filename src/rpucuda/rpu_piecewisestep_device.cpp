@@ -61,18 +61,15 @@ inline void update_once(
 
   } else {
     // interpolation
-    T w_scaled = MAX((w - min_bound) / (max_bound - min_bound) * (T)n_sections, (T)0.0);
-    size_t w_index = MIN((size_t)floorf(w_scaled), n_sections - 1);
-    T t = MIN(w_scaled - (T)w_index, (T)1.0); // convex fraction
-    T t1 = (T)1.0 - t;
-
     if (sign > 0) {
-      T interpolated_down =
-          scale_down * (t1 * piecewise_down_vec[w_index] + t * piecewise_down_vec[w_index + 1]);
+      T interpolated_down = scale_down * interpolateStepResponse(
+                                             piecewise_down_vec.data(), n_sections, w,
+                                             min_bound, max_bound);
       w -= interpolated_down * ((T)1.0 + dw_min_std * rng->sampleGauss());
     } else {
-      T interpolated_up =
-          scale_up * (t1 * piecewise_up_vec[w_index] + t * piecewise_up_vec[w_index + 1]);
+      T interpolated_up = scale_up * interpolateStepResponse(
+                                         piecewise_up_vec.data(), n_sections, w, min_bound,
+                                         max_bound);
       w += interpolated_up * ((T)1.0 + dw_min_std * rng->sampleGauss());
     }
   }
@@ -93,36 +90,31 @@ void PiecewiseStepRPUDevice<T>::doSparseUpdate(
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *w = par.usesPersistentWeight() ? this->w_persistent_[i] : weights[i];
   T *w_apparent = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
   T write_noise_std = par.getScaledWriteNoise();
 
   PULSED_UPDATE_W_LOOP(update_once(
-                           w[j], w_apparent[j], sign, scale_down[j], scale_up[j], min_bound[j],
-                           max_bound[j], par.piecewise_up_vec, par.piecewise_down_vec,
-                           par.dw_min_std, write_noise_std, rng););
+                           w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                           pack[j].min_bound, pack[j].max_bound, par.piecewise_up_vec,
+                           par.piecewise_down_vec, par.dw_min_std, write_noise_std, rng););
 }
 
 template <typename T>
-void PiecewiseStepRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+void PiecewiseStepRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  auto *pack = this->getPackedUpdateParameters();
   T *w = par.usesPersistentWeight() ? this->w_persistent_[0] : weights[0];
   T *w_apparent = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
   T write_noise_std = par.getScaledWriteNoise();
 
   PULSED_UPDATE_W_LOOP_DENSE(update_once(
-                                 w[j], w_apparent[j], sign, scale_down[j], scale_up[j],
-                                 min_bound[j], max_bound[j], par.piecewise_up_vec,
+                                 w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                                 pack[j].min_bound, pack[j].max_bound, par.piecewise_up_vec,
                                  par.piecewise_down_vec, par.dw_min_std, write_noise_std, rng););
 }
 
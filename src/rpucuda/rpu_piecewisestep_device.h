@@ -80,6 +80,7 @@ template <typename T> class PiecewiseStepRPUDevice : public PulsedRPUDevice<T> {
   void doSparseUpdate(
       T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng)
       override;
-  void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) override;
+  void doDenseUpdateRows(
+      T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) override;
 };
 } // namespace RPU
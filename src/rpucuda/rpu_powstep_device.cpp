@@ -53,6 +53,22 @@ void PowStepRPUDevice<T>::populate(
       }
     }
   }
+  buildStepTable();
+}
+
+template <typename T> void PowStepRPUDevice<T>::buildStepTable() {
+
+  // one table over the range of all (up and down) gammas of the tile
+  int size = this->x_size_ * this->d_size_;
+  T gamma_min = std::numeric_limits<T>::max();
+  T gamma_max = std::numeric_limits<T>::lowest();
+  for (int i = 0; i < size; ++i) {
+    gamma_min = MIN(gamma_min, MIN(w_gamma_up_[0][i], w_gamma_down_[0][i]));
+    gamma_max = MAX(gamma_max, MAX(w_gamma_up_[0][i], w_gamma_down_[0][i]));
+  }
+  pow_table_.build(
+      size > 0 ? getPar().ps_lut_size : 0, (T)0.0, (T)1.0, gamma_min, gamma_max,
+      [](const T &u, const T &gamma) { return (T)powf(u, gamma); });
 }
 
 template <typename T> void PowStepRPUDevice<T>::printDP(int x_count, int d_count) const {
@@ -91,7 +107,7 @@ template <typename T> void PowStepRPUDevice<T>::printDP(int x_count, int d_count
 }
 
 namespace {
-template <typename T>
+template <typename T, typename PowFun>
 inline void update_once(
     T &w,
     T &w_apparent,
@@ -104,16 +120,17 @@ inline void update_once(
     T &max_bound,
     const T &dw_min_std,
     const T &write_noise_std,
+    const PowFun &pow_fun,
     RNG<T> *rng) {
   T range = max_bound - min_bound;
   if (range == (T)0.0) {
     return;
   }
   if (sign > 0) {
-    w -= scale_down * (T)powf((w - min_bound) / range, gamma_down) *
+    w -= scale_down * pow_fun((w - min_bound) / range, gamma_down) *
          ((T)1.0 + dw_min_std * rng->sampleGauss());
   } else {
-    w += scale_up * (T)powf(((max_bound - w) / range), gamma_up) *
+    w += scale_up * pow_fun((max_bound - w) / range, gamma_up) *
          ((T)1.0 + dw_min_std * rng->sampleGauss());
   }
   w = MAX(w, min_bound);
@@ -132,41 +149,56 @@ void PowStepRPUDevice<T>::doSparseUpdate(
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *gamma_down = w_gamma_down_[i];
   T *gamma_up = w_gamma_up_[i];
   T *w = par.usesPersistentWeight() ? this->w_persistent_[i] : weights[i];
   T *w_apparent = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
 
   T write_noise_std = par.getScaledWriteNoise();
-  PULSED_UPDATE_W_LOOP(update_once(
-                           w[j], w_apparent[j], sign, scale_down[j], scale_up[j], gamma_down[j],
-                           gamma_up[j], min_bound[j], max_bound[j], par.dw_min_std, write_noise_std,
-                           rng););
+  if (pow_table_.isActive()) {
+    auto pow_fun = [this](const T &u, const T &gamma) { return pow_table_(u, gamma); };
+    PULSED_UPDATE_W_LOOP(update_once(
+                             w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                             gamma_down[j], gamma_up[j], pack[j].min_bound, pack[j].max_bound,
+                             par.dw_min_std, write_noise_std, pow_fun, rng););
+  } else {
+    auto pow_fun = [](const T &u, const T &gamma) { return (T)powf(u, gamma); };
+    PULSED_UPDATE_W_LOOP(update_once(
+                             w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                             gamma_down[j], gamma_up[j], pack[j].min_bound, pack[j].max_bound,
+                             par.dw_min_std, write_noise_std, pow_fun, rng););
+  }
 }
 
 template <typename T>
-void PowStepRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+void PowStepRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  auto *pack = this->getPackedUpdateParameters();
   T *gamma_down = w_gamma_down_[0];
   T *gamma_up = w_gamma_up_[0];
   T *w = par.usesPersistentWeight() ? this->w_persistent_[0] : weights[0];
   T *w_apparent = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
   T write_noise_std = par.getScaledWriteNoise();
 
-  PULSED_UPDATE_W_LOOP_DENSE(update_once(
-                                 w[j], w_apparent[j], sign, scale_down[j], scale_up[j],
-                                 gamma_down[j], gamma_up[j], min_bound[j], max_bound[j],
-                                 par.dw_min_std, write_noise_std, rng););
+  if (pow_table_.isActive()) {
+    auto pow_fun = [this](const T &u, const T &gamma) { return pow_table_(u, gamma); };
+    PULSED_UPDATE_W_LOOP_DENSE(update_once(
+                                   w[j], w_apparent[j], sign, pack[j].scale_down,
+                                   pack[j].scale_up, gamma_down[j], gamma_up[j], pack[j].min_bound,
+                                   pack[j].max_bound, par.dw_min_std, write_noise_std, pow_fun,
+                                   rng););
+  } else {
+    auto pow_fun = [](const T &u, const T &gamma) { return (T)powf(u, gamma); };
+    PULSED_UPDATE_W_LOOP_DENSE(update_once(
+                                   w[j], w_apparent[j], sign, pack[j].scale_down,
+                                   pack[j].scale_up, gamma_down[j], gamma_up[j], pack[j].min_bound,
+                                   pack[j].max_bound, par.dw_min_std, write_noise_std, pow_fun,
+                                   rng););
+  }
 }
 
 template class PowStepRPUDevice<float>;
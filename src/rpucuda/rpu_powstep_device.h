@@ -29,11 +29,15 @@ BUILD_PULSED_DEVICE_META_PARAMETER(
     T ps_gamma_dtod = (T)0.1;
     T ps_gamma_up_down = (T)0.00;
     T ps_gamma_up_down_dtod = (T)0.00;
+    int ps_lut_size = 0; // tabulated step response if > 0 (CPU only)
     ,
     /*print body*/
     ss << "\t ps_gamma:\t\t" << ps_gamma << "\t(dtod=" << ps_gamma_dtod << ")" << std::endl;
     ss << "\t ps_gamma_up_down:\t" << ps_gamma_up_down << "\t(dtod=" << ps_gamma_up_down_dtod << ")"
        << std::endl;
+    if (ps_lut_size > 0) {
+      ss << "\t ps_lut_size:\t\t" << ps_lut_size << std::endl;
+    }
     ,
     /* calc weight granularity body */
     return this->dw_min * (T)powf((T)0.5, ps_gamma);
@@ -68,17 +72,21 @@ template <typename T> class PowStepRPUDevice : public PulsedRPUDevice<T> {
           w_gamma_down_[i][j] = other.w_gamma_down_[i][j];
           w_gamma_up_[i][j] = other.w_gamma_up_[i][j];
         }
-      },
+      }
+      pow_table_ = other.pow_table_;
+      ,
       /* move assignment */
       w_gamma_down_ = other.w_gamma_down_;
       w_gamma_up_ = other.w_gamma_up_;
 
       other.w_gamma_down_ = nullptr;
       other.w_gamma_up_ = nullptr;
+      pow_table_ = std::move(other.pow_table_);
       ,
       /* swap*/
       swap(a.w_gamma_up_, b.w_gamma_up_);
       swap(a.w_gamma_down_, b.w_gamma_down_);
+      swap(a.pow_table_, b.pow_table_);
       ,
       /* dp names*/
       names.push_back(std::string("gamma_up"));
@@ -99,7 +107,9 @@ template <typename T> class PowStepRPUDevice : public PulsedRPUDevice<T> {
       for (int i = 0; i < size; ++i) {
         w_gamma_up_[0][i] = data_ptrs[n_prev][i];
         w_gamma_down_[0][i] = data_ptrs[n_prev + 1][i];
-      },
+      }
+      buildStepTable();
+      ,
       /*invert copy DP */
       T **gamma_down = rpu->getGammaDown();
       T **gamma_up = rpu->getGammaUp();
@@ -109,6 +119,7 @@ template <typename T> class PowStepRPUDevice : public PulsedRPUDevice<T> {
           w_gamma_up_[i][j] = gamma_down[i][j];
         }
       }
+      buildStepTable();
 
   );
 
@@ -120,10 +131,14 @@ template <typename T> class PowStepRPUDevice : public PulsedRPUDevice<T> {
   void doSparseUpdate(
       T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng)
       override;
-  void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) override;
+  void doDenseUpdateRows(
+      T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) override;
 
 private:
+  void buildStepTable();
+
   T **w_gamma_up_ = nullptr;
   T **w_gamma_down_ = nullptr;
+  StepResponseTable<T> pow_table_; // tabulated powf(u, gamma), see ps_lut_size
 };
 } // namespace RPU
@@ -0,0 +1,67 @@
+/**
+ * (C) Copyright 2020, 2021, 2022, 2023, 2024 IBM. All Rights Reserved.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#include "rng.h"
+#include "rpu_powstep_device.h"
+#include "utility_functions.h"
+#include "gtest/gtest.h"
+#include <memory>
+
+namespace {
+
+using namespace RPU;
+
+TEST(RPUPowStepDeviceTest, TabulatedStepResponse) {
+
+  // no cycle-to-cycle noise: the tabulated step response needs to
+  // closely follow the exact one (same device-to-device draws)
+  int x_size = 10;
+  int d_size = 11;
+  PowStepRPUDeviceMetaParameter<num_t> dp;
+  dp.ps_gamma = 1.5;
+  dp.ps_gamma_dtod = 0.3;
+  dp.dw_min = 0.02;
+  dp.dw_min_std = 0.0;
+  RealWorldRNG<num_t> rw_rng(42);
+  std::unique_ptr<PulsedRPUDevice<num_t>> device(dp.createDevice(x_size, d_size, &rw_rng));
+  dp.ps_lut_size = 128;
+  RealWorldRNG<num_t> rw_rng2(42);
+  std::unique_ptr<PulsedRPUDevice<num_t>> device2(dp.createDevice(x_size, d_size, &rw_rng2));
+  RNG<num_t> rng(0);
+
+  num_t **weights = Array_2D_Get<num_t>(d_size, x_size);
+  num_t **weights2 = Array_2D_Get<num_t>(d_size, x_size);
+  std::vector<int> coincidences(d_size * x_size);
+  for (int j = 0; j < d_size * x_size; j++) {
+    weights[0][j] = weights2[0][j] = (num_t)0.4 * rw_rng.sampleUniform() - (num_t)0.2;
+  }
+  for (int k = 0; k < 20; k++) {
+    for (int j = 0; j < d_size * x_size; j++) {
+      coincidences[j] = (j * 7 + k * 3) % 11 - 5;
+    }
+    device->doDenseUpdate(weights, coincidences.data(), &rng);
+    device2->doDenseUpdate(weights2, coincidences.data(), &rng);
+  }
+
+  for (int j = 0; j < d_size * x_size; j++) {
+    ASSERT_NEAR(weights[0][j], weights2[0][j], 1e-4);
+  }
+  Array_2D_Free<num_t>(weights);
+  Array_2D_Free<num_t>(weights2);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
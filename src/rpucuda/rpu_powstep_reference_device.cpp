@@ -81,6 +81,22 @@ void PowStepReferenceRPUDevice<T>::populate(
       }
     }
   }
+  buildStepTable();
+}
+
+template <typename T> void PowStepReferenceRPUDevice<T>::buildStepTable() {
+
+  // one table over the range of all (up and down) gammas of the tile
+  int size = this->x_size_ * this->d_size_;
+  T gamma_min = std::numeric_limits<T>::max();
+  T gamma_max = std::numeric_limits<T>::lowest();
+  for (int i = 0; i < size; ++i) {
+    gamma_min = MIN(gamma_min, MIN(w_gamma_up_[0][i], w_gamma_down_[0][i]));
+    gamma_max = MAX(gamma_max, MAX(w_gamma_up_[0][i], w_gamma_down_[0][i]));
+  }
+  pow_table_.build(
+      size > 0 ? getPar().ps_lut_size : 0, (T)0.0, (T)1.0, gamma_min, gamma_max,
+      [](const T &u, const T &gamma) { return (T)powf(u, gamma); });
 }
 
 template <typename T> void PowStepReferenceRPUDevice<T>::printDP(int x_count, int d_count) const {
@@ -120,7 +136,7 @@ template <typename T> void PowStepReferenceRPUDevice<T>::printDP(int x_count, in
 }
 
 namespace {
-template <typename T>
+template <typename T, typename PowFun>
 inline void update_once_reference(
     T &w,
     int &sign,
@@ -132,6 +148,7 @@ inline void update_once_reference(
     T &min_bound,
     T &max_bound,
     const T &dw_min_std,
+    const PowFun &pow_fun,
     RNG<T> *rng) {
   T range = max_bound - min_bound;
   if (range == (T)0.0) {
@@ -140,10 +157,10 @@ inline void update_once_reference(
   w += ref; // first add
 
   if (sign > 0) {
-    w -= scale_down * (T)powf((w - min_bound) / range, gamma_down) *
+    w -= scale_down * pow_fun((w - min_bound) / range, gamma_down) *
          ((T)1.0 + dw_min_std * rng->sampleGauss());
   } else {
-    w += scale_up * (T)powf((max_bound - w) / range, gamma_up) *
+    w += scale_up * pow_fun((max_bound - w) / range, gamma_up) *
          ((T)1.0 + dw_min_std * rng->sampleGauss());
   }
   w = MAX(w, min_bound);
@@ -160,37 +177,52 @@ void PowStepReferenceRPUDevice<T>::doSparseUpdate(
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *gamma_down = w_gamma_down_[i];
   T *gamma_up = w_gamma_up_[i];
   T *ref = w_reference_[i];
   T *w = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
 
-  PULSED_UPDATE_W_LOOP(update_once_reference(
-                           w[j], sign, scale_down[j], scale_up[j], gamma_down[j], gamma_up[j],
-                           ref[j], min_bound[j], max_bound[j], par.dw_min_std, rng););
+  if (pow_table_.isActive()) {
+    auto pow_fun = [this](const T &u, const T &gamma) { return pow_table_(u, gamma); };
+    PULSED_UPDATE_W_LOOP(update_once_reference(
+                             w[j], sign, pack[j].scale_down, pack[j].scale_up, gamma_down[j],
+                             gamma_up[j], ref[j], pack[j].min_bound, pack[j].max_bound,
+                             par.dw_min_std, pow_fun, rng););
+  } else {
+    auto pow_fun = [](const T &u, const T &gamma) { return (T)powf(u, gamma); };
+    PULSED_UPDATE_W_LOOP(update_once_reference(
+                             w[j], sign, pack[j].scale_down, pack[j].scale_up, gamma_down[j],
+                             gamma_up[j], ref[j], pack[j].min_bound, pack[j].max_bound,
+                             par.dw_min_std, pow_fun, rng););
+  }
 }
 
 template <typename T>
-void PowStepReferenceRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+void PowStepReferenceRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  auto *pack = this->getPackedUpdateParameters();
   T *gamma_down = w_gamma_down_[0];
   T *gamma_up = w_gamma_up_[0];
   T *ref = w_reference_[0];
   T *w = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
 
-  PULSED_UPDATE_W_LOOP_DENSE(update_once_reference(
-                                 w[j], sign, scale_down[j], scale_up[j], gamma_down[j], gamma_up[j],
-                                 ref[j], min_bound[j], max_bound[j], par.dw_min_std, rng););
+  if (pow_table_.isActive()) {
+    auto pow_fun = [this](const T &u, const T &gamma) { return pow_table_(u, gamma); };
+    PULSED_UPDATE_W_LOOP_DENSE(update_once_reference(
+                                   w[j], sign, pack[j].scale_down, pack[j].scale_up,
+                                   gamma_down[j], gamma_up[j], ref[j], pack[j].min_bound,
+                                   pack[j].max_bound, par.dw_min_std, pow_fun, rng););
+  } else {
+    auto pow_fun = [](const T &u, const T &gamma) { return (T)powf(u, gamma); };
+    PULSED_UPDATE_W_LOOP_DENSE(update_once_reference(
+                                   w[j], sign, pack[j].scale_down, pack[j].scale_up,
+                                   gamma_down[j], gamma_up[j], ref[j], pack[j].min_bound,
+                                   pack[j].max_bound, par.dw_min_std, pow_fun, rng););
+  }
 }
 
 template class PowStepReferenceRPUDevice<float>;
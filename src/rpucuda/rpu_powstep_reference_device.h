@@ -29,6 +29,7 @@ BUILD_PULSED_DEVICE_META_PARAMETER(
     T ps_gamma_dtod = (T)0.1;
     T ps_gamma_up_down = (T)0.00;
     T ps_gamma_up_down_dtod = (T)0.00;
+    int ps_lut_size = 0; // tabulated step response if > 0 (CPU only)
     T reference_mean = (T)0.0;
     T reference_std = (T)0.0;
     bool subtract_symmetry_point = false;
@@ -38,6 +39,9 @@ BUILD_PULSED_DEVICE_META_PARAMETER(
     ss << "\t ps_gamma:\t\t" << ps_gamma << "\t(dtod=" << ps_gamma_dtod << ")" << std::endl;
     ss << "\t ps_gamma_up_down:\t" << ps_gamma_up_down << "\t(dtod=" << ps_gamma_up_down_dtod << ")"
        << std::endl;
+    if (ps_lut_size > 0) {
+      ss << "\t ps_lut_size:\t\t" << ps_lut_size << std::endl;
+    }
     ss << "\t reference_mean:\t" << reference_mean << std::endl;
     ss << "\t reference_std:\t" << reference_std << std::endl;
     ss << "\t subtract_symmetry_point:\t" << std::boolalpha << subtract_symmetry_point;
@@ -88,7 +92,9 @@ template <typename T> class PowStepReferenceRPUDevice : public PulsedRPUDevice<T
           w_gamma_up_[i][j] = other.w_gamma_up_[i][j];
           w_reference_[i][j] = other.w_reference_[i][j];
         }
-      },
+      }
+      pow_table_ = other.pow_table_;
+      ,
       /* move assignment */
       w_gamma_down_ = other.w_gamma_down_;
       w_gamma_up_ = other.w_gamma_up_;
@@ -97,11 +103,13 @@ template <typename T> class PowStepReferenceRPUDevice : public PulsedRPUDevice<T
       other.w_gamma_down_ = nullptr;
       other.w_gamma_up_ = nullptr;
       other.w_reference_ = nullptr;
+      pow_table_ = std::move(other.pow_table_);
       ,
       /* swap*/
       swap(a.w_gamma_up_, b.w_gamma_up_);
       swap(a.w_gamma_down_, b.w_gamma_down_);
       swap(a.w_reference_, b.w_reference_);
+      swap(a.pow_table_, b.pow_table_);
       ,
       /* dp names*/
       names.push_back(std::string("gamma_up"));
@@ -125,7 +133,9 @@ template <typename T> class PowStepReferenceRPUDevice : public PulsedRPUDevice<T
         w_gamma_up_[0][i] = data_ptrs[n_prev][i];
         w_gamma_down_[0][i] = data_ptrs[n_prev + 1][i];
         w_reference_[0][i] = data_ptrs[n_prev + 2][i];
-      },
+      }
+      buildStepTable();
+      ,
       /*invert copy DP */
       T **gamma_down = rpu->getGammaDown();
       T **gamma_up = rpu->getGammaUp();
@@ -136,6 +146,7 @@ template <typename T> class PowStepReferenceRPUDevice : public PulsedRPUDevice<T
           w_reference_[i][j] = -w_reference_[i][j];
         }
       }
+      buildStepTable();
 
   );
 
@@ -148,11 +159,15 @@ template <typename T> class PowStepReferenceRPUDevice : public PulsedRPUDevice<T
   void doSparseUpdate(
       T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng)
       override;
-  void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) override;
+  void doDenseUpdateRows(
+      T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) override;
 
 private:
+  void buildStepTable();
+
   T **w_gamma_up_ = nullptr;
   T **w_gamma_down_ = nullptr;
   T **w_reference_ = nullptr;
+  StepResponseTable<T> pow_table_; // tabulated powf(u, gamma), see ps_lut_size
 };
 } // namespace RPU
@@ -36,6 +36,9 @@ extern "C" {
     RPU_FATAL("First populate rpu device (call populateParameter())!");                            \
   }
 
+// one-hot columns per forward pass of the weight read-out
+#define RPU_WEIGHTS_READ_BLOCK_SIZE 128
+
 namespace RPU {
 
 /********************************************************************************
@@ -193,16 +196,19 @@ template <typename T> void RPUPulsed<T>::setLearningRate(T lr) {
 }
 
 template <typename T> void RPUPulsed<T>::decayWeights(bool bias_no_decay) {
+  this->bumpWeightGeneration();
   CHECK_RPU_DEVICE_INIT;
   rpu_device_->decayWeights(this->getWeightsPtr(), bias_no_decay);
 }
 
 template <typename T> void RPUPulsed<T>::decayWeights(T alpha, bool bias_no_decay) {
+  this->bumpWeightGeneration();
   CHECK_RPU_DEVICE_INIT;
   rpu_device_->decayWeights(this->getWeightsPtr(), alpha, bias_no_decay);
 }
 
 template <typename T> void RPUPulsed<T>::diffuseWeights() {
+  this->bumpWeightGeneration();
   CHECK_RPU_DEVICE_INIT;
   rpu_device_->diffuseWeights(this->getWeightsPtr(), *this->rng_);
 }
@@ -223,6 +229,7 @@ template <typename T> void RPUPulsed<T>::diffuseWeightsPink() {
 }
 
 template <typename T> void RPUPulsed<T>::resetCols(int start_col, int n_cols, T reset_prob) {
+  this->bumpWeightGeneration();
   if (reset_prob) {
     CHECK_RPU_DEVICE_INIT;
     rpu_device_->resetCols(this->getWeightsPtr(), start_col, n_cols, reset_prob, *this->rw_rng_);
@@ -230,6 +237,7 @@ template <typename T> void RPUPulsed<T>::resetCols(int start_col, int n_cols, T
 }
 
 template <typename T> void RPUPulsed<T>::driftWeights(T time_since_last_call) {
+  this->bumpWeightGeneration();
   CHECK_RPU_DEVICE_INIT;
   rpu_device_->driftWeights(this->getWeightsPtr(), time_since_last_call, *this->rng_);
 }
@@ -268,6 +276,7 @@ bool RPUPulsed<T>::swaWeights(
 
 template <typename T> void RPUPulsed<T>::clipWeights(T clip) {
 
+  this->bumpWeightGeneration();
   CHECK_RPU_DEVICE_INIT;
   rpu_device_->clipWeights(this->getWeightsPtr(), clip);
 }
@@ -298,6 +307,7 @@ template <typename T> void RPUPulsed<T>::setWeights(const T *weightsptr) {
 }
 
 template <typename T> void RPUPulsed<T>::applyWeightUpdate(T *dw_and_current_weight_out) {
+  this->bumpWeightGeneration();
   T *w = this->getWeightsPtr()[0];
   int size = this->d_size_ * this->x_size_;
   PRAGMA_SIMD
@@ -311,26 +321,65 @@ template <typename T> void RPUPulsed<T>::applyWeightUpdate(T *dw_and_current_wei
 }
 
 template <typename T> void RPUPulsed<T>::getWeightsReal(T *weightsptr) {
+  this->getWeightsReal(weightsptr, 1);
+}
+
+template <typename T> void RPUPulsed<T>::getWeightsReal(T *weightsptr, int n_reads) {
 
   CHECK_RPU_DEVICE_INIT;
 
   int x_sz = this->getXSize();
-  T **eye = Array_2D_Get_Eye<T>(x_sz);
-
-  T alpha = this->getFwdAlpha();
-  this->setFwdAlpha(1.0, false);
-  this->forwardMatrix(eye[0], weightsptr, x_sz, false, true, false);
-  this->setFwdAlpha(alpha, false);
+  int d_sz = this->getDSize();
+  n_reads = MAX(n_reads, 1);
+
+  // the identity is streamed in blocks of columns
+  int block_size = MIN(x_sz, RPU_WEIGHTS_READ_BLOCK_SIZE);
+  read_buffer_values_.resize((size_t)block_size * d_sz);
+  T *w_block = read_buffer_values_.data();
+
+  setFBPassWeightsVersion();
+  T **weights = this->getFBWeights(false);
+
+  for (int k = 0; k < n_reads; ++k) {
+    for (int col_start = 0; col_start < x_sz; col_start += block_size) {
+      int n_cols = MIN(block_size, x_sz - col_start);
+
+      // output is [d_sz x n_cols]
+      fb_pass_->forwardOneHotMatrix(weights, col_start, w_block, n_cols, (T)1.0, false);
+
+      for (int i = 0; i < d_sz; ++i) {
+        T *w_row = weightsptr + (size_t)i * x_sz + col_start;
+        const T *w_block_row = w_block + (size_t)i * n_cols;
+        if (k == 0) {
+          memcpy(w_row, w_block_row, sizeof(T) * n_cols);
+        } else {
+          PRAGMA_SIMD
+          for (int j = 0; j < n_cols; ++j) {
+            w_row[j] += w_block_row[j];
+          }
+        }
+      }
+    }
+  }
 
-  Array_2D_Free<T>(eye);
+  if (n_reads > 1) {
+    RPU::math::scal<T>(x_sz * d_sz, (T)1.0 / (T)n_reads, weightsptr, 1);
+  }
 }
 
 template <typename T> void RPUPulsed<T>::setWeightsReal(const T *weightsptr, int n_loops) {
+  this->setWeightsReal(weightsptr, n_loops, (T)-1.0);
+}
+
+template <typename T>
+void RPUPulsed<T>::setWeightsReal(
+    const T *weightsptr, int n_loops, T tolerance, std::vector<WeightsProgramStat<T>> *stats) {
 
   CHECK_RPU_DEVICE_INIT;
 
   int x_sz = this->getXSize();
   int d_sz = this->getDSize();
+  int size = x_sz * d_sz;
 
   T *w_current = this->getWeightsPtr()[0];
 
@@ -358,41 +407,120 @@ template <typename T> void RPUPulsed<T>::setWeightsReal(const T *weightsptr, int
 
   /*====*/
 
-  DEBUG_OUT("RPUPulsed: Set weights real [iter=" << iter << "]");
-
-  T **delta = Array_2D_Get<T>(d_sz, x_sz);
-  T **eye = Array_2D_Get_Eye<T>(x_sz);
+  // without a tolerance, all elements are written in all iterations
+  bool verify = tolerance >= (T)0.0;
+  if (tolerance == (T)0.0) {
+    tolerance = weight_granularity;
+  }
+  DEBUG_OUT(
+      "RPUPulsed: Set weights real [max iter=" << iter << ", tolerance=" << tolerance << "]");
+
+  // columns are verified and written in blocks of one-hot inputs
+  int block_size = MIN(x_sz, RPU_WEIGHTS_READ_BLOCK_SIZE);
+  read_buffer_values_.resize((size_t)block_size * d_sz);
+  T *w_block = read_buffer_values_.data();
+  std::vector<T> x_block((size_t)block_size * x_sz, (T)0.0);
+  std::vector<T> d_block((size_t)block_size * d_sz);
+
+  // converged elements are not written anymore, like in a write-verify scheme. To not
+  // stop on a single lucky (noisy) read, an element only counts as converged once it is
+  // read within tolerance on n_verify consecutive verify reads (without being written)
+  const uint8_t n_verify = 2;
+  std::vector<uint8_t> n_within(size, 0);
+  std::vector<uint8_t> col_active(x_sz, 1);
+  std::vector<T> abs_error(size, (T)0.0);
+  int n_converged = 0;
 
-  T fwd_alpha = this->getFwdAlpha();
   T bwd_alpha = this->getBwdAlpha();
-
-  this->setFwdAlpha(1.0, false);
   this->setBwdAlpha(1.0, false);
 
-  for (int k = 0; k < iter; ++k) {
-
-    this->forwardMatrix(eye[0], delta[0], x_sz, false, true, false);
+  for (int k = 0; k < iter && n_converged < size; ++k) {
+
+    WeightsProgramStat<T> stat;
+
+    for (int col_start = 0; col_start < x_sz; col_start += block_size) {
+      int n_cols = MIN(block_size, x_sz - col_start);
+      bool any_active = false;
+      for (int j = col_start; j < col_start + n_cols; ++j) {
+        any_active = any_active || col_active[j];
+      }
+      if (!any_active) {
+        continue;
+      }
+
+      // verify: read [d_sz x n_cols]
+      setFBPassWeightsVersion();
+      fb_pass_->forwardOneHotMatrix(
+          this->getFBWeights(false), col_start, w_block, n_cols, (T)1.0, false);
+
+      // collect the deltas of the not yet converged elements of the active columns
+      int m_batch = 0;
+      for (int jj = 0; jj < n_cols; ++jj) {
+        int j = col_start + jj;
+        if (!col_active[j]) {
+          continue;
+        }
+        T *d = d_block.data() + (size_t)m_batch * d_sz;
+        bool active = false;
+        bool write = false;
+        for (int i = 0; i < d_sz; ++i) {
+          int idx = i * x_sz + j;
+          d[i] = (T)0.0;
+          if (n_within[idx] >= n_verify) {
+            continue;
+          }
+          T delta = w_block[i * n_cols + jj] - weightsptr[idx];
+          abs_error[idx] = (T)fabsf(delta);
+          if (verify && abs_error[idx] <= tolerance) {
+            if (++n_within[idx] >= n_verify) {
+              n_converged++;
+              continue;
+            }
+          } else {
+            n_within[idx] = 0;
+            d[i] = delta;
+            write = true;
+          }
+          active = true;
+        }
+        col_active[j] = active;
+        if (write) {
+          x_block[(size_t)m_batch * x_sz + j] = (T)1.0;
+          m_batch++;
+        }
+      }
+
+      // write only the active columns
+      if (m_batch > 0) {
+        this->updateMatrix(x_block.data(), d_block.data(), m_batch, false, false);
+        std::fill(x_block.begin(), x_block.begin() + (size_t)m_batch * x_sz, (T)0.0);
+      }
+      stat.n_active_cols += m_batch;
+    }
 
-    // calc delta
-    for (int i = 0; i < x_sz * d_sz; ++i) {
-      (delta[0])[i] -= weightsptr[i];
+    for (int i = 0; i < size; ++i) {
+      stat.avg_error += abs_error[i];
+      stat.max_error = MAX(stat.max_error, abs_error[i]);
+    }
+    stat.avg_error /= (T)size;
+    stat.n_converged = n_converged;
+    if (stats != nullptr) {
+      stats->push_back(stat);
     }
-    this->updateMatrix(eye[0], delta[0], x_sz, false, true);
+    DEBUG_OUT(
+        "Iter " << k << ": [avg error=" << stat.avg_error << ", max error=" << stat.max_error
+                << ", converged=" << n_converged << "/" << size << "]");
   }
-  this->setFwdAlpha(fwd_alpha, false);
   this->setBwdAlpha(bwd_alpha, false);
 
   T avg_dev = 0.0;
-  for (int i = 0; i < x_sz * d_sz; ++i) {
+  for (int i = 0; i < size; ++i) {
     avg_dev += (T)fabsf(weightsptr[i] - w_current[i]);
   }
-  avg_dev /= x_sz * d_sz;
+  avg_dev /= size;
   DEBUG_OUT("Finished setting weights real [avg deviation=" << avg_dev << "]");
 
   this->copyWeightsToBuffer();
-
-  Array_2D_Free<T>(eye);
-  Array_2D_Free<T>(delta);
 }
 
 template <typename T>
@@ -408,6 +536,7 @@ template <typename T> void RPUPulsed<T>::getDeviceParameter(std::vector<T *> &da
 };
 
 template <typename T> void RPUPulsed<T>::setDeviceParameter(const std::vector<T *> &data_ptrs) {
+  this->bumpWeightGeneration();
   // note that memory (x_sz*d_sz per ptr) assumed to be initialized from outside !!
   CHECK_RPU_DEVICE_INIT;
   rpu_device_->setDeviceParameter(this->getWeightsPtr(), data_ptrs);
@@ -503,22 +632,52 @@ void RPUPulsed<T>::populateParameter(
 /*********************************************************************************/
 /* Vector forward/backward/update */
 
+template <typename T> void RPUPulsed<T>::setFBPassWeightsVersion() {
+  // shared weights might be changed from outside without notice
+  if (this->getSharedWeightsIf()) {
+    fb_pass_->resetWeightsVersion();
+  } else {
+    fb_pass_->setWeightsVersion(this->getFBWeightsVersion());
+  }
+}
+
 template <typename T>
 void RPUPulsed<T>::forwardVector(
     const T *x_input, T *d_output, int x_inc, int d_inc, bool is_test) {
+  setFBPassWeightsVersion();
   fb_pass_->forwardVector(
       this->getFBWeights(is_test), x_input, x_inc, d_output, d_inc, this->getFwdAlpha(), is_test);
 };
 
 template <typename T>
 void RPUPulsed<T>::backwardVector(const T *d_input, T *x_output, int d_inc, int x_inc) {
+  setFBPassWeightsVersion();
   fb_pass_->backwardVector(
       this->getFBWeights(false), d_input, d_inc, x_output, x_inc, this->getBwdAlpha());
 };
 
+template <typename T>
+void RPUPulsed<T>::forwardMatrix(
+    const T *X_input, T *D_output, int m_batch, bool x_trans, bool d_trans, bool is_test) {
+  setFBPassWeightsVersion();
+  fb_pass_->forwardMatrix(
+      this->getFBWeights(is_test), X_input, D_output, m_batch, x_trans, d_trans,
+      this->getFwdAlpha(), is_test);
+};
+
+template <typename T>
+void RPUPulsed<T>::backwardMatrix(
+    const T *D_input, T *X_output, int m_batch, bool d_trans, bool x_trans) {
+  setFBPassWeightsVersion();
+  fb_pass_->backwardMatrix(
+      this->getFBWeights(false), D_input, X_output, m_batch, d_trans, x_trans,
+      this->getBwdAlpha());
+};
+
 template <typename T>
 void RPUPulsed<T>::updateVector(const T *x_input, const T *d_input, int x_inc, int d_inc) {
 
+  this->bumpWeightGeneration();
   if (this->getDeltaWeights()) {
     if ((x_inc != 1) || (d_inc != 1)) {
       RPU_FATAL("Update_Vector for delta weights and xd_inc>1 is not implemented.");
@@ -542,6 +701,7 @@ void RPUPulsed<T>::updateVectorWithCounts(
     int d_inc,
     uint32_t *x_counts32,
     uint32_t *d_counts32) {
+  this->bumpWeightGeneration();
   auto *rpu_device = dynamic_cast<PulsedRPUDeviceBase<T> *>(&*rpu_device_);
 
   if (rpu_device == nullptr) {
@@ -565,6 +725,7 @@ template <typename T>
 void RPUPulsed<T>::updateMatrix(
     const T *X_input, const T *D_input, int m_batch, bool x_trans, bool d_trans) {
 
+  this->bumpWeightGeneration();
   if (pwu_->checkForFPUpdate(&*rpu_device_)) {
     // we use the fast simple GEMM is this case. This also has the
     // correct behavior for delta weights
@@ -26,6 +26,15 @@ namespace RPU {
 
 template <typename T> struct PulsedMetaParameter;
 
+/* statistics of one iteration of the closed-loop weight programming
+   (errors of the verify read before the write of the iteration) */
+template <typename T> struct WeightsProgramStat {
+  T avg_error = (T)0.0;  // mean absolute deviation from the target
+  T max_error = (T)0.0;  // max absolute deviation from the target
+  int n_converged = 0;   // elements within the tolerance (not written anymore)
+  int n_active_cols = 0; // columns written in this iteration
+};
+
 template <typename T> class RPUPulsed : public RPUSimple<T> {
 
 public:
@@ -77,7 +86,25 @@ public:
       uint32_t *d_counts32);
 
   void getWeightsReal(T *weightsptr) override;
+  /* reads the weights with forward passes of one-hot column blocks
+     through the analog forward. The n_reads reads are averaged */
+  void getWeightsReal(T *weightsptr, int n_reads);
+  /* Note that this always runs all iterations and writes all
+     elements (as on GPU), see below for early stopping */
   void setWeightsReal(const T *weightsptr, int n_loops = 25) override;
+  /* programs the weights with read (verify) and write cycles using
+     the analog forward and update. Elements are not written anymore
+     once read within tolerance on two consecutive verify reads (in
+     case of tolerance == 0 the weight granularity of the device is
+     used). Stops after the n_loops based maximal number of
+     iterations or once all elements converged. A negative tolerance
+     disables the verify, i.e. all elements are written in all
+     iterations. Statistics per iteration are appended to stats */
+  void setWeightsReal(
+      const T *weightsptr,
+      int n_loops,
+      T tolerance,
+      std::vector<WeightsProgramStat<T>> *stats = nullptr);
   void setWeightsUniformRandom(T min_value, T max_value) override;
   void setWeights(const T *weightsptr) override;
 
@@ -106,12 +133,22 @@ public:
   void setFBParameter(FBParameter<T> &fb_pars);
 
 protected:
+  // noise and bound management might depend on the whole batch
+  bool hasSampleLocalForward() const override { return false; };
+
   void forwardVector(const T *x_input, T *d_output, int x_inc, int d_inc, bool is_test) override;
   void backwardVector(const T *d_input, T *x_output, int d_inc = 1, int x_inc = 1) override;
   void updateVector(const T *x_input, const T *d_input, int x_inc = 1, int d_inc = 1) override;
 
-  USE_LOOPED_MATRIX_FORWARD(T);
-  USE_LOOPED_MATRIX_BACKWARD(T);
+  void forwardMatrix(
+      const T *X_input, T *D_output, int m_batch, bool x_trans, bool d_trans, bool is_test)
+      override;
+  void backwardMatrix(
+      const T *D_input,
+      T *X_output,
+      int m_batch,
+      bool d_trans = false,
+      bool x_trans = false) override;
   void updateMatrix(
       const T *X_input,
       const T *D_input,
@@ -125,6 +162,8 @@ private:
   // helpers
   std::unique_ptr<PulsedRPUWeightUpdater<T>> pwu_ = nullptr;
   std::unique_ptr<ForwardBackwardPassIOManaged<T>> fb_pass_ = nullptr;
+  void setFBPassWeightsVersion();
+  std::vector<T> read_buffer_values_;
 
   PulsedMetaParameter<T> par_;
   // void initialize(PulsedMetaParameter<T> *p, int x_sz, int d_sz);
@@ -51,6 +51,11 @@ void PulsedRPUDeviceMetaParameter<T>::printToStream(std::stringstream &ss) const
       ss << "\t write noise std:\t" << write_noise_std << std::endl;
     }
 
+    if (dense_update_noise_approx) {
+      ss << "\t dense_update_noise_approx:\t" << std::boolalpha << dense_update_noise_approx
+         << std::endl;
+    }
+
     if (this->lifetime > (T)0.0) {
       ss << "\t lifetime [decay]:\t" << this->lifetime << "\t(dtod=" << lifetime_dtod << ")"
          << std::endl;
@@ -123,9 +128,29 @@ template <typename T> void PulsedRPUDevice<T>::allocateContainers() {
       w_persistent_[i][j] = (T)0.0;
     }
   }
+  invalidatePackedUpdateParameters();
   containers_allocated_ = true;
 }
 
+template <typename T> void PulsedRPUDevice<T>::packUpdateParameters() {
+
+  w_packed_.resize(this->size_);
+  T *scale_down = w_scale_down_[0];
+  T *scale_up = w_scale_up_[0];
+  T *min_bound = w_min_bound_[0];
+  T *max_bound = w_max_bound_[0];
+
+  PRAGMA_SIMD
+  for (int i = 0; i < this->size_; ++i) {
+    auto &pack = w_packed_[i];
+    pack.scale_down = scale_down[i];
+    pack.scale_up = scale_up[i];
+    pack.min_bound = min_bound[i];
+    pack.max_bound = max_bound[i];
+  }
+  packed_valid_ = true;
+}
+
 template <typename T> void PulsedRPUDevice<T>::freeContainers() {
 
   if (containers_allocated_) {
@@ -222,6 +247,10 @@ PulsedRPUDevice<T> &PulsedRPUDevice<T>::operator=(PulsedRPUDevice<T> &&other) {
   w_reset_bias_ = other.w_reset_bias_;
   w_persistent_ = other.w_persistent_;
 
+  w_packed_ = std::move(other.w_packed_);
+  packed_valid_ = other.packed_valid_;
+  other.packed_valid_ = false;
+
   // set pointers to null
   other.w_scale_up_ = nullptr;
   other.w_scale_down_ = nullptr;
@@ -323,6 +352,7 @@ void PulsedRPUDevice<T>::setDeviceParameter(T **out_weights, const std::vector<T
 
     dw_min += ((T)fabsf(w_scale_up_[0][i]) + (T)fabsf(w_scale_down_[0][i])) / (T)2.0;
   }
+  invalidatePackedUpdateParameters();
 
   if (!getPar().legacy_params && this->hasWDrifter()) {
     this->wdrifter_->setNu(data_ptrs[n_drift]);
@@ -544,6 +574,7 @@ void PulsedRPUDevice<T>::copyInvertDeviceParameter(const PulsedRPUDeviceBase<T>
       w_min_bound_[i][j] = -b;
     }
   }
+  invalidatePackedUpdateParameters();
 }
 
 template <typename T> bool PulsedRPUDevice<T>::onSetWeights(T **weights) {
@@ -598,6 +629,7 @@ template <typename T>
 void PulsedRPUDevice<T>::populate(const PulsedRPUDeviceMetaParameter<T> &p, RealWorldRNG<T> *rng) {
 
   PulsedRPUDeviceBase<T>::populate(p, rng); // will clone and init parametrs
+  invalidatePackedUpdateParameters();
 
   auto &par = getPar();
 
@@ -18,6 +18,7 @@
 #include "rpu_pulsed_meta_parameter.h"
 #include "rpu_simple_device.h"
 #include "utility_functions.h"
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -95,6 +96,7 @@ template <typename T> struct PulsedRPUDeviceMetaParameter : PulsedRPUDeviceMetaP
   T write_noise_std = (T)0.0;
   bool apply_write_noise_on_set = true;
   bool count_pulses = false; // whether to count the pulses. Some runtime penalty
+  bool dense_update_noise_approx = false; // N noisy pulses of dense update by one Gaussian
 
   void printToStream(std::stringstream &ss) const override;
   using SimpleMetaParameter<T>::print;
@@ -158,6 +160,20 @@ public:
   virtual void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
     RPU_FATAL("Dense update not available for this device!");
   };
+  /* dense update of the rows i_start <= i < i_end only. Here the
+     coincidences are given for the row block only (row-major) */
+  virtual void
+  doDenseUpdateRows(T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
+    RPU_FATAL("Dense update of rows not available for this device!");
+  };
+  /* whether doSparseUpdate on row i (and doDenseUpdateRows) only
+     touches the given rows (of weights and internal states), so that
+     different rows can be updated concurrently */
+  virtual bool hasRowLocalUpdate() const { return false; };
+  /* whether initUpdateCycle / finishUpdateCycle keep a state across
+     updates (e.g. meta-devices selecting or counting updates), so
+     that several updates cannot share one update cycle */
+  virtual bool hasUpdateCycleState() const { return true; };
   // for Meta-devices [like vector/transfer]: called once before each update starts
   virtual void initUpdateCycle(
       T **weights,
@@ -223,6 +239,14 @@ private:
   T num_states_ = 0.0;
 };
 
+/* hot parameters of the update of one weight element (interleaved) */
+template <typename T> struct alignas(4 * sizeof(T)) PulsedUpdateParameterPack {
+  T scale_down;
+  T scale_up;
+  T min_bound;
+  T max_bound;
+};
+
 template <typename T> class PulsedRPUDevice : public PulsedRPUDeviceBase<T> {
 
 public:
@@ -252,11 +276,33 @@ public:
     swap(a.w_diffusion_rate_, b.w_diffusion_rate_);
     swap(a.w_persistent_, b.w_persistent_);
     swap(a.w_reset_bias_, b.w_reset_bias_);
+    swap(a.w_packed_, b.w_packed_);
+    swap(a.packed_valid_, b.packed_valid_);
 
     swap(a.containers_allocated_, b.containers_allocated_);
   }
 
   PulsedRPUDevice<T> *clone() const override { RPU_FATAL("Needs implementation"); };
+  bool hasRowLocalUpdate() const override { return true; };
+  bool hasUpdateCycleState() const override { return false; };
+  void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) override {
+    this->doDenseUpdateRows(weights, coincidences, 0, this->d_size_, rng);
+  };
+  void initUpdateCycle(
+      T **weights,
+      const PulsedUpdateMetaParameter<T> &up,
+      T current_lr,
+      int m_batch_info,
+      const T *x_input = nullptr,
+      const int x_inc = 1,
+      const T *d_input = nullptr,
+      const int d_inc = 1) override {
+    PulsedRPUDeviceBase<T>::initUpdateCycle(
+        weights, up, current_lr, m_batch_info, x_input, x_inc, d_input, d_inc);
+    // pack here (outside of any parallel row-block update), as the
+    // lazy packing in doSparseUpdate would otherwise race
+    getPackedUpdateParameters();
+  };
 
   void getDPNames(std::vector<std::string> &names) const override;
   void getDeviceParameter(T **weights, std::vector<T *> &data_ptrs) override;
@@ -266,13 +312,14 @@ public:
   void setHiddenWeights(const std::vector<T> &data) override;
 
   inline T **getPersistentWeights() const { return w_persistent_; };
-  inline T **getMaxBound() const { return w_max_bound_; };
-  inline T **getMinBound() const { return w_min_bound_; };
+  // read-only, since these are also packed for the update
+  inline const T *const *getMaxBound() const { return w_max_bound_; };
+  inline const T *const *getMinBound() const { return w_min_bound_; };
   inline T **getDecayScale() const { return w_decay_scale_; };
   inline T **getDiffusionRate() const { return w_diffusion_rate_; };
   inline T **getResetBias() const { return w_reset_bias_; };
-  inline T **getScaleUp() const { return w_scale_up_; };
-  inline T **getScaleDown() const { return w_scale_down_; };
+  inline const T *const *getScaleUp() const { return w_scale_up_; };
+  inline const T *const *getScaleDown() const { return w_scale_down_; };
   PulsedRPUDeviceMetaParameter<T> &getPar() const override {
     return static_cast<PulsedRPUDeviceMetaParameter<T> &>(SimpleRPUDevice<T>::getPar());
   };
@@ -311,9 +358,25 @@ protected:
   RealWorldRNG<T> write_noise_rng_{0};
   virtual void applyUpdateWriteNoise(T **weights);
 
+  /* Scale up/down and bounds interleaved per element (x-major as the
+     weights) for the update loops. These are packed lazily from the
+     arrays above, thus any change of the arrays above needs a call of
+     invalidatePackedUpdateParameters */
+  inline PulsedUpdateParameterPack<T> *getPackedUpdateParameters() {
+    if (!packed_valid_) {
+      packUpdateParameters();
+    }
+    return w_packed_.data();
+  };
+  inline void invalidatePackedUpdateParameters() { packed_valid_ = false; };
+
 private:
   void freeContainers();
   void allocateContainers();
+  void packUpdateParameters();
+
+  aligned_vector<PulsedUpdateParameterPack<T>> w_packed_;
+  bool packed_valid_ = false;
   void initialize();
   bool containers_allocated_ = false;
 };
@@ -463,10 +526,12 @@ public:
     { BODY; }                                                                                      \
   }
 
+// coincidences are given for the row block i_start to i_end only
 #define PULSED_UPDATE_W_LOOP_DENSE(BODY)                                                           \
-  int _total_size = this->x_size_ * this->d_size_;                                                 \
-  for (int j = 0; j < _total_size; j++) {                                                          \
-    int c_signed = coincidences[j];                                                                \
+  int _j_start = i_start * this->x_size_;                                                          \
+  int _j_end = i_end * this->x_size_;                                                              \
+  for (int j = _j_start; j < _j_end; j++) {                                                        \
+    int c_signed = coincidences[j - _j_start];                                                     \
     if (c_signed == 0) {                                                                           \
       continue;                                                                                    \
     }                                                                                              \
@@ -478,4 +543,97 @@ public:
     }                                                                                              \
   }
 
+/* same as above, but the ac > 1 coincident pulses of an element are
+   applied at once by BODY_N if N_PULSES_IF is true (e.g. a closed form
+   of the device response to ac pulses) */
+#define PULSED_UPDATE_W_LOOP_DENSE_N(N_PULSES_IF, BODY_N, BODY)                                    \
+  int _j_start = i_start * this->x_size_;                                                          \
+  int _j_end = i_end * this->x_size_;                                                              \
+  for (int j = _j_start; j < _j_end; j++) {                                                        \
+    int c_signed = coincidences[j - _j_start];                                                     \
+    if (c_signed == 0) {                                                                           \
+      continue;                                                                                    \
+    }                                                                                              \
+    int ac = abs(c_signed);                                                                        \
+    int sign = c_signed > 0 ? 1 : -1;                                                              \
+    if ((N_PULSES_IF) && ac > 1) {                                                                 \
+      BODY_N;                                                                                      \
+      continue;                                                                                    \
+    }                                                                                              \
+    PRAGMA_SIMD                                                                                    \
+    for (int i_c = 0; i_c < ac; i_c++) {                                                           \
+      BODY;                                                                                        \
+    }                                                                                              \
+  }
+
+/* linear interpolation of a step response table given at n_sections + 1
+   equally spaced weight positions over [min_bound, max_bound] */
+template <typename T>
+inline T interpolateStepResponse(
+    const T *table, const size_t n_sections, const T &w, const T &min_bound, const T &max_bound) {
+  T w_scaled = MAX((w - min_bound) / (max_bound - min_bound) * (T)n_sections, (T)0.0);
+  size_t w_index = MIN((size_t)floorf(w_scaled), n_sections - 1);
+  T t = MIN(w_scaled - (T)w_index, (T)1.0); // convex fraction
+  return ((T)1.0 - t) * table[w_index] + t * table[w_index + 1];
+}
+
+/* Tabulated step response f(u, p) on the weight position u in
+   [u_min, u_max] for a device parameter p in [p_min, p_max] (e.g. a
+   device-to-device varying exponent). Looked up by (bi-)linear
+   interpolation instead of evaluating transcendental functions for
+   each pulse. */
+template <typename T> class StepResponseTable {
+
+public:
+  template <typename F>
+  void build(int n_sections, const T u_min, const T u_max, const T p_min, const T p_max, F f) {
+    n_sections_ = u_max > u_min ? MAX(n_sections, 0) : 0;
+    n_p_sections_ = p_max > p_min ? n_sections_ : 0;
+    u_min_ = u_min;
+    u_max_ = u_max;
+    u_scale_ = n_sections_ > 0 ? (T)n_sections_ / (u_max - u_min) : (T)0.0;
+    p_min_ = p_min;
+    p_scale_ = n_p_sections_ > 0 ? (T)n_p_sections_ / (p_max - p_min) : (T)0.0;
+
+    table_.resize(n_sections_ > 0 ? (n_sections_ + 1) * (n_p_sections_ + 1) : 0);
+    for (int k = 0; k < (int)table_.size(); k++) {
+      int k_p = k / (n_sections_ + 1);
+      int k_u = k % (n_sections_ + 1);
+      T p = n_p_sections_ > 0 ? p_min + (p_max - p_min) * (T)k_p / (T)n_p_sections_ : p_min;
+      table_[k] = f(u_min + (u_max - u_min) * (T)k_u / (T)n_sections_, p);
+    }
+  };
+
+  inline bool isActive() const { return n_sections_ > 0; };
+  inline T operator()(const T &u, const T &p) const {
+    const T *row = table_.data();
+    if (n_p_sections_ == 0) {
+      return interpolateStepResponse(row, (size_t)n_sections_, u, u_min_, u_max_);
+    }
+    // same position index for both parameter rows
+    T u_scaled = MAX((u - u_min_) * u_scale_, (T)0.0);
+    int k_u = MIN((int)u_scaled, n_sections_ - 1);
+    T t_u = MIN(u_scaled - (T)k_u, (T)1.0);
+    T p_scaled = MAX((p - p_min_) * p_scale_, (T)0.0);
+    int k_p = MIN((int)p_scaled, n_p_sections_ - 1);
+    T t_p = MIN(p_scaled - (T)k_p, (T)1.0);
+
+    row += k_p * (n_sections_ + 1) + k_u;
+    const T *next_row = row + n_sections_ + 1;
+    T y0 = row[0] + t_u * (row[1] - row[0]);
+    T y1 = next_row[0] + t_u * (next_row[1] - next_row[0]);
+    return y0 + t_p * (y1 - y0);
+  };
+
+private:
+  std::vector<T> table_;
+  int n_sections_ = 0;
+  int n_p_sections_ = 0;
+  T u_min_ = (T)0.0;
+  T u_max_ = (T)1.0;
+  T u_scale_ = (T)0.0;
+  T p_min_ = (T)0.0;
+  T p_scale_ = (T)0.0;
+};
+
 } // namespace RPU
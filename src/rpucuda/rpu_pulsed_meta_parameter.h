@@ -104,6 +104,7 @@ template <typename T> struct IOMetaParameter {
   BoundManagementType bound_management = BoundManagementType::None;
   bool bm_test_negative_bound = true;
   int max_bm_factor = 1000; // absolute max of BM
+  bool bm_rescale_analog = false; // re-derive BM rounds from the kept pre-ADC result (CPU only)
   T max_bm_res =
       (T)0.25; // bounds BM to less than max_bm_res times the input number of states (1/inp_res)
 
@@ -243,6 +244,9 @@ template <typename T> struct IOMetaParameter {
         ss << "UNKNOWN.";
         break; // should never happen
       };
+      if (bound_management != BoundManagementType::None && bm_rescale_analog) {
+        ss << " [rescaled analog]";
+      }
     } else {
       ss << "\t using ideal floating point.";
     }
@@ -270,6 +274,9 @@ template <typename T> struct PulsedUpdateMetaParameter {
   T x_res_implicit = (T)0; // in case of implicit pulsing. Assumes range 0..1
   T d_res_implicit = (T)0;
 
+  bool parallel_update = false;     // CPU only: split update over row blocks (threads)
+  bool row_bucketed_update = false; // CPU only: apply the sparse pulses row by row
+
   bool _par_initialized = false;
   bool _currently_tuning = false;
   int _debug_kernel_index = -1; // for PWU debugging.
@@ -322,6 +329,12 @@ template <typename T> struct PulsedUpdateMetaParameter {
       ss << "\t update_management:\t" << std::boolalpha << update_management << std::endl;
       ss << "\t update_bl_management:\t" << std::boolalpha << update_bl_management << std::endl;
       ss << "\t up_DAC_stoc_round:\t" << sto_round << std::endl;
+      if (parallel_update) {
+        ss << "\t parallel_update:\t" << std::boolalpha << parallel_update << std::endl;
+      }
+      if (row_bucketed_update) {
+        ss << "\t row_bucketed_update:\t" << std::boolalpha << row_bucketed_update << std::endl;
+      }
       ss << "\t up_DAC:\t\t" << 1.0f / MAX((float)res, 0.0f) << std::endl;
       ss << "\t pulse_type:\t\t" << (int)pulse_type << std::endl;
     }
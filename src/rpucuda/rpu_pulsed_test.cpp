@@ -12,6 +12,7 @@
 
 #include "rng.h"
 #include "rpu_constantstep_device.h"
+#include "rpu_linearstep_device.h"
 #include "rpu_pulsed.h"
 #include "utility_functions.h"
 #include "gtest/gtest.h"
@@ -26,7 +27,7 @@ namespace {
 using namespace RPU;
 // using num_t=float;
 
-class RPUTestNoiseFreeFixture : public ::testing::TestWithParam<int> {
+class RPUTestNoiseFree : public ::testing::Test {
 public:
   void SetUp() {
 
@@ -128,8 +129,15 @@ public:
   std::vector<num_t> rx, rd, w, x, d, x2, d2, w2;
 };
 
+class RPUTestNoiseFreeFixture : public RPUTestNoiseFree,
+                                public ::testing::WithParamInterface<int> {};
+
+class RPUTestNoiseFreeBoolFixture : public RPUTestNoiseFree,
+                                    public ::testing::WithParamInterface<bool> {};
+
 // types
 INSTANTIATE_TEST_CASE_P(MVType, RPUTestNoiseFreeFixture, ::testing::Range(0, 2));
+INSTANTIATE_TEST_CASE_P(Bool, RPUTestNoiseFreeBoolFixture, ::testing::Bool());
 
 TEST_P(RPUTestNoiseFreeFixture, ConstructAndTestFP) {
 
@@ -198,6 +206,377 @@ TEST_P(RPUTestNoiseFreeFixture, ConstructAndCopy) {
   }
 }
 
+TEST_P(RPUTestNoiseFreeFixture, MatrixVersusLooped) {
+
+  p.f_io.mv_type = (RPU::AnalogMVType)GetParam();
+  p.b_io.mv_type = (RPU::AnalogMVType)GetParam();
+  p.f_io.noise_management = NoiseManagementType::AbsMax;
+  p.b_io.noise_management = NoiseManagementType::AbsMax;
+  p.f_io.bound_management = BoundManagementType::Iterative;
+  p.f_io.out_bound = 2.0;
+  constructRPU();
+
+  int m_batch = 2;
+  // batched (transposed in and out)
+  std::vector<num_t> rx_t(x_size * m_batch), rd_t(d_size * m_batch);
+  for (int i = 0; i < m_batch; i++) {
+    for (int j = 0; j < x_size; j++) {
+      rx_t[j * m_batch + i] = rx[i * x_size + j];
+    }
+    for (int j = 0; j < d_size; j++) {
+      rd_t[j * m_batch + i] = rd[i * d_size + j];
+    }
+  }
+  rpu->forward(rx.data(), d.data(), false, m_batch, false, false);
+  rpu->backward(rd.data(), x.data(), false, m_batch, false, false);
+  rpu->forward(rx_t.data(), d2.data(), false, m_batch, true, true);
+  rpu->backward(rd_t.data(), x2.data(), false, m_batch, true, true);
+
+  for (int i = 0; i < m_batch; i++) {
+    std::vector<num_t> d_looped(d_size), x_looped(x_size);
+    rpu->forward(rx.data() + i * x_size, d_looped.data());
+    rpu->backward(rd.data() + i * d_size, x_looped.data());
+
+    for (int j = 0; j < d_size; j++) {
+      ASSERT_NEAR(d[i * d_size + j], d_looped[j], TOLERANCE);
+      ASSERT_NEAR(d2[j * m_batch + i], d_looped[j], TOLERANCE);
+    }
+    for (int j = 0; j < x_size; j++) {
+      ASSERT_NEAR(x[i * x_size + j], x_looped[j], TOLERANCE);
+      ASSERT_NEAR(x2[j * m_batch + i], x_looped[j], TOLERANCE);
+    }
+  }
+}
+
+TEST_P(RPUTestNoiseFreeBoolFixture, BoundManagementRescaled) {
+
+  // without input quantization and IR drop the analog result scales
+  // with the input: rescaled and recomputed rounds need to agree
+  bool pos_neg_separate = GetParam();
+  p.f_io.mv_type = pos_neg_separate ? AnalogMVType::PosNegSeparate : AnalogMVType::OnePass;
+  p.f_io.noise_management = NoiseManagementType::AbsMax;
+  p.f_io.bound_management = BoundManagementType::Iterative;
+  p.f_io.out_bound = 0.5;
+  p.f_io.inp_res = -1;
+  p.f_io.ir_drop = 0.0;
+  // no systematic variations, as these are drawn for each tile
+  p.f_io.v_offset_std = 0.0;
+  p.f_io.w_read_asymmetry_dtod = 0.0;
+  p.f_io.out_nonlinearity_std = 0.0;
+  dp.construction_seed = 42;
+  constructRPU();
+  rpu->getWeights(w.data());
+
+  p.f_io.bm_rescale_analog = true;
+  RPUPulsed<num_t> rpu2(x_size, d_size);
+  rpu2.populateParameter(&p, &dp);
+  rpu2.setWeights(w.data());
+
+  int m_batch = 2;
+  rpu->forward(rx.data(), d.data(), false, m_batch);
+  rpu2.forward(rx.data(), d2.data(), false, m_batch);
+  for (int i = 0; i < m_batch * d_size; i++) {
+    ASSERT_NEAR(d[i], d2[i], TOLERANCE);
+  }
+
+  rpu->forward(rx.data(), d.data());
+  rpu2.forward(rx.data(), d2.data());
+  for (int i = 0; i < d_size; i++) {
+    ASSERT_NEAR(d[i], d2[i], TOLERANCE);
+  }
+}
+
+TEST_P(RPUTestNoiseFreeFixture, WeightsReadOut) {
+
+  // several one-hot blocks need to be streamed
+  x_size = 300;
+  p.f_io.mv_type = (RPU::AnalogMVType)GetParam();
+  p.f_io.noise_management = NoiseManagementType::AbsMax;
+  constructRPU();
+
+  std::vector<num_t> eye(x_size * x_size, (num_t)0.0);
+  for (int j = 0; j < x_size; j++) {
+    eye[j * x_size + j] = (num_t)1.0;
+  }
+  std::vector<num_t> w_eye(x_size * d_size), w_real(x_size * d_size);
+  rpu->forward(eye.data(), w_eye.data(), false, x_size, false, true);
+
+  rpu->getWeightsReal(w_real.data());
+  for (int i = 0; i < x_size * d_size; i++) {
+    ASSERT_NEAR(w_real[i], w_eye[i], TOLERANCE);
+  }
+  rpu->getWeightsReal(w_real.data(), 3);
+  for (int i = 0; i < x_size * d_size; i++) {
+    ASSERT_NEAR(w_real[i], w_eye[i], TOLERANCE);
+  }
+
+  // perfect forward reads the weights themselves
+  p.f_io.is_perfect = true;
+  constructRPU();
+  rpu->getWeights(w_eye.data());
+  rpu->getWeightsReal(w_real.data());
+  for (int i = 0; i < x_size * d_size; i++) {
+    ASSERT_NEAR(w_real[i], w_eye[i], TOLERANCE);
+  }
+}
+
+TEST_F(RPUTestNoiseFree, WeightsReadOutNoisy) {
+
+  x_size = 300;
+  p.f_io = IOMetaParameter<num_t>();
+  p.f_io.inp_res = -1.0;
+  p.f_io.out_res = -1.0;
+  p.f_io.out_bound = 0.0;
+  p.f_io.out_noise = 0.05;
+  p.f_io.noise_management = NoiseManagementType::None;
+  p.f_io.bound_management = BoundManagementType::None;
+  constructRPU();
+  int size = x_size * d_size;
+
+  std::vector<num_t> w_real(size);
+  w.resize(size);
+  rpu->getWeights(w.data());
+  auto readError = [&](int n_reads) -> num_t {
+    rpu->getWeightsReal(w_real.data(), n_reads);
+    num_t mse = 0.0;
+    for (int i = 0; i < size; i++) {
+      mse += (w_real[i] - w[i]) * (w_real[i] - w[i]);
+    }
+    return mse / (num_t)size;
+  };
+
+  // output noise of each read is averaged out with 1/n_reads
+  num_t mse1 = readError(1);
+  num_t mse4 = readError(4);
+  ASSERT_NEAR(mse1, p.f_io.out_noise * p.f_io.out_noise, 0.2 * mse1);
+  ASSERT_NEAR(mse1 / mse4, 4.0, 0.8);
+
+  // input noise also hits the zeros of the one-hot inputs (fallback
+  // to the full forward): the variance is the full row norm
+  p.f_io.out_noise = 0.0;
+  p.f_io.inp_noise = 0.05;
+  constructRPU();
+  rpu->getWeights(w.data());
+  num_t expected_mse = 0.0;
+  for (int i = 0; i < size; i++) {
+    expected_mse += w[i] * w[i] * p.f_io.inp_noise * p.f_io.inp_noise;
+  }
+  expected_mse /= (num_t)d_size;
+  mse1 = readError(1);
+  ASSERT_NEAR(mse1, expected_mse, 0.2 * expected_mse);
+  mse4 = readError(4);
+  ASSERT_NEAR(mse1 / mse4, 4.0, 0.8);
+}
+
+TEST_F(RPUTestNoiseFree, WeightsProgramVerify) {
+
+  x_size = 300;
+  p.f_io.is_perfect = true;
+  // all devices can reach the targets
+  dp.dw_min_dtod = 0.0;
+  dp.up_down_dtod = 0.0;
+  constructRPU();
+  rpu->setLearningRate(1.0);
+
+  std::vector<num_t> w_target(x_size * d_size), w_set(x_size * d_size);
+  RealWorldRNG<num_t> rw_rng(1);
+  for (int i = 0; i < x_size * d_size; i++) {
+    w_target[i] = (num_t)0.8 * ((num_t)2.0 * rw_rng.sampleUniform() - (num_t)1.0);
+  }
+
+  num_t tolerance = 0.02;
+  int n_loops = 5;
+  std::vector<WeightsProgramStat<num_t>> stats;
+  rpu->setWeightsReal(w_target.data(), n_loops, tolerance, &stats);
+
+  // all converged before the maximal number of iterations
+  ASSERT_GT(stats.size(), (size_t)1);
+  ASSERT_EQ(stats.back().n_converged, x_size * d_size);
+  ASSERT_LT(stats.back().n_active_cols, x_size);
+  ASSERT_LT(stats.back().max_error, tolerance + TOLERANCE);
+  ASSERT_LT(stats.back().avg_error, stats[0].avg_error);
+  for (size_t k = 1; k < stats.size(); k++) {
+    ASSERT_GE(stats[k].n_converged, stats[k - 1].n_converged);
+    ASSERT_LE(stats[k].n_active_cols, stats[k - 1].n_active_cols);
+  }
+
+  rpu->getWeights(w_set.data());
+  for (int i = 0; i < x_size * d_size; i++) {
+    ASSERT_NEAR(w_set[i], w_target[i], tolerance + TOLERANCE);
+  }
+
+  // without tolerance (as the default setWeightsReal) all iterations write all columns
+  size_t n_iter = stats.size();
+  stats.clear();
+  rpu->setWeightsReal(w_target.data(), n_loops, (num_t)-1.0, &stats);
+  ASSERT_GT(stats.size(), n_iter);
+  for (const auto &stat : stats) {
+    ASSERT_EQ(stat.n_converged, 0);
+    ASSERT_EQ(stat.n_active_cols, x_size);
+  }
+
+  // with read noise, a single verify read within tolerance is not enough
+  p.f_io = IOMetaParameter<num_t>();
+  p.f_io.inp_res = -1.0;
+  p.f_io.out_res = -1.0;
+  p.f_io.out_bound = 0.0;
+  p.f_io.out_noise = 0.01;
+  constructRPU();
+  rpu->setLearningRate(1.0);
+  stats.clear();
+  rpu->setWeightsReal(w_target.data(), n_loops, tolerance, &stats);
+
+  ASSERT_GT(stats.size(), (size_t)2);
+  ASSERT_EQ(stats[0].n_converged, 0);
+  rpu->getWeights(w_set.data());
+  num_t avg_error = 0.0;
+  for (int i = 0; i < x_size * d_size; i++) {
+    avg_error += (num_t)fabsf(w_set[i] - w_target[i]);
+  }
+  ASSERT_LT(avg_error / (num_t)(x_size * d_size), tolerance);
+}
+
+TEST_P(RPUTestNoiseFreeBoolFixture, ParallelUpdate) {
+
+  // same pulse trains and no cycle-to-cycle noise: parallel row
+  // blocks need to give identical results (sparse and dense)
+  bool dense = GetParam();
+  p.up.pulse_type = dense ? PulseType::DeterministicImplicit : PulseType::StochasticCompressed;
+  dp.construction_seed = 42;
+  constructRPU();
+  RPUPulsed<num_t> rpu2(x_size, d_size);
+  p.up.parallel_update = true;
+  rpu2.populateParameter(&p, &dp);
+  rpu2.setLearningRate(0.1);
+  rpu->getWeights(w.data());
+  rpu2.setWeights(w.data());
+  rpu->setRandomSeed(1);
+  rpu2.setRandomSeed(1);
+
+  // single sample only, as the substreams advance the main stream
+  rpu->update(rx.data(), rd.data());
+  rpu->getWeights(w.data());
+  rpu2.update(rx.data(), rd.data());
+  rpu2.getWeights(w2.data());
+
+  for (int i = 0; i < x_size * d_size; i++) {
+    ASSERT_NEAR(w[i], w2[i], TOLERANCE);
+  }
+}
+
+TEST_P(RPUTestNoiseFreeBoolFixture, RowBucketedUpdate) {
+
+  // no cycle-to-cycle noise: the row-wise pulse schedule needs to
+  // give identical results (with and without parallel row blocks)
+  bool parallel_update = GetParam();
+  p.up.pulse_type = PulseType::StochasticCompressed;
+  p.up.parallel_update = parallel_update;
+  dp.construction_seed = 42;
+  constructRPU();
+  RPUPulsed<num_t> rpu2(x_size, d_size);
+  p.up.row_bucketed_update = true;
+  rpu2.populateParameter(&p, &dp);
+  rpu2.setLearningRate(0.1);
+  rpu->getWeights(w.data());
+  rpu2.setWeights(w.data());
+  rpu->setRandomSeed(1);
+  rpu2.setRandomSeed(1);
+
+  int m_batch = 2;
+  rpu->update(rx.data(), rd.data(), false, m_batch);
+  rpu->getWeights(w.data());
+  rpu2.update(rx.data(), rd.data(), false, m_batch);
+  rpu2.getWeights(w2.data());
+
+  for (int i = 0; i < x_size * d_size; i++) {
+    ASSERT_NEAR(w[i], w2[i], TOLERANCE);
+  }
+}
+
+TEST_P(RPUTestNoiseFreeBoolFixture, DenseUpdateNPulses) {
+
+  // no cycle-to-cycle noise: N coincident pulses applied at once
+  // need to agree with N single pulses (incl. hitting the bounds)
+  SoftBoundsRPUDeviceMetaParameter<num_t> sp;
+  sp.dw_min = 0.05;
+  sp.dw_min_std = 0.0;
+  sp.w_min_dtod = 0.0;
+  sp.w_max_dtod = 0.0;
+  dp.dw_min = 0.05;
+  bool soft_bounds = GetParam();
+  PulsedRPUDeviceMetaParameter<num_t> &par =
+      soft_bounds ? (PulsedRPUDeviceMetaParameter<num_t> &)sp : dp;
+  RealWorldRNG<num_t> rw_rng(42);
+  RNG<num_t> rng(0);
+  std::unique_ptr<PulsedRPUDevice<num_t>> device(par.createDevice(x_size, d_size, &rw_rng));
+
+  num_t **weights = Array_2D_Get<num_t>(d_size, x_size);
+  num_t **weights2 = Array_2D_Get<num_t>(d_size, x_size);
+  std::vector<int> coincidences(d_size * x_size);
+  std::vector<int> single(d_size * x_size);
+  int max_ac = 0;
+  for (int j = 0; j < d_size * x_size; j++) {
+    weights[0][j] = weights2[0][j] = w[j] * (num_t)6.0;
+    coincidences[j] = (j * 7) % 61 - 30;
+    max_ac = MAX(max_ac, abs(coincidences[j]));
+  }
+
+  device->doDenseUpdate(weights, coincidences.data(), &rng);
+  for (int k = 0; k < max_ac; k++) {
+    for (int j = 0; j < d_size * x_size; j++) {
+      int c = coincidences[j];
+      single[j] = abs(c) > k ? (c > 0 ? 1 : -1) : 0;
+    }
+    device->doDenseUpdate(weights2, single.data(), &rng);
+  }
+
+  for (int j = 0; j < d_size * x_size; j++) {
+    ASSERT_NEAR(weights[0][j], weights2[0][j], TOLERANCE);
+  }
+  Array_2D_Free<num_t>(weights);
+  Array_2D_Free<num_t>(weights2);
+}
+
+TEST_P(RPUTestNoiseFreeBoolFixture, FlickerTrapFlipRates) {
+
+  // traps flip 0->1 with q / r^i and 1->0 with (1 - q) / r^i and
+  // stay at occupancy q, also across the parallel weight blocks
+  SimpleMetaParameter<num_t> sp;
+  sp.diffusion = 0.01;
+  sp.flicker.n = 6;
+  sp.flicker.r = 2.0;
+  sp.flicker.q = 0.3;
+  bool large = GetParam();
+  int n_x = large ? 200 : x_size;
+  int n_d = large ? 100 : d_size;
+  RPUSimple<num_t> rpu_simple(n_x, n_d);
+  rpu_simple.populateParameter(&sp);
+  rpu_simple.setRandomSeed(1);
+  uint64_t *states = rpu_simple.initFlickerStates();
+
+  int size = n_x * n_d;
+  int n_reps = 100000 / size + 20;
+  std::vector<uint64_t> last_states(states, states + size);
+  std::vector<double> flips(sp.flicker.n, 0.0);
+  std::vector<double> ones(sp.flicker.n, 0.0);
+  for (int k = 0; k < n_reps; k++) {
+    rpu_simple.diffuseWeightsPink();
+    for (int j = 0; j < size; j++) {
+      uint64_t flipped = states[j] ^ last_states[j];
+      ASSERT_EQ(flipped >> sp.flicker.n, (uint64_t)0);
+      for (int i = 0; i < sp.flicker.n; i++) {
+        flips[i] += (double)((flipped >> i) & 1);
+        ones[i] += (double)((states[j] >> i) & 1);
+      }
+      last_states[j] = states[j];
+    }
+  }
+  for (int i = 0; i < sp.flicker.n; i++) {
+    ASSERT_NEAR(flips[i] / (n_reps * size), 2.0 * 0.3 * 0.7 / (1 << i), 0.01);
+    ASSERT_NEAR(ones[i] / (n_reps * size), 0.3, 0.03);
+  }
+}
+
 TEST_P(RPUTestNoiseFreeFixture, ConstructAndMove) {
 
   p.f_io.mv_type = (RPU::AnalogMVType)GetParam();
@@ -235,6 +614,466 @@ TEST_P(RPUTestNoiseFreeFixture, ConstructAndMove) {
   }
 }
 
+TEST_F(RPUTestNoiseFree, CachedModifiedFBWeights) {
+
+  p.f_io.is_perfect = true;
+  constructRPU();
+
+  WeightModifierParameter<num_t> wmpar;
+  wmpar.type = WeightModifierType::AddNormal;
+  wmpar.std_dev = 0.1;
+  wmpar.cache_refresh_every = 3;
+
+  auto modifyAndForward = [&](std::vector<num_t> &out) {
+    rpu->modifyFBWeights(wmpar);
+    rpu->forward(rx.data(), out.data());
+  };
+  auto isSame = [&](const std::vector<num_t> &a, const std::vector<num_t> &b) {
+    for (int i = 0; i < d_size; i++) {
+      if (fabsf(a[i] - b[i]) > TOLERANCE) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // noise is re-drawn only every 3 calls
+  modifyAndForward(d);
+  modifyAndForward(d2);
+  ASSERT_TRUE(isSame(d, d2));
+  modifyAndForward(d2);
+  ASSERT_TRUE(isSame(d, d2));
+  modifyAndForward(d2);
+  ASSERT_FALSE(isSame(d, d2));
+
+  // weight change invalidates the cache
+  modifyAndForward(d);
+  ASSERT_TRUE(isSame(d, d2));
+  rpu->update(rx.data(), rd.data());
+  modifyAndForward(d);
+  ASSERT_FALSE(isSame(d, d2));
+
+  // deterministic types are re-used until the weights change
+  wmpar.type = WeightModifierType::Discretize;
+  wmpar.res = 0.1;
+  wmpar.cache_refresh_every = 1;
+  modifyAndForward(d);
+  rpu->getWeights(w.data());
+  for (int i = 0; i < x_size * d_size; i++) {
+    w[i] *= 0.5;
+  }
+  rpu->getWeightsPtr()[0][0] = w[0]; // not tracked
+  modifyAndForward(d2);
+  ASSERT_TRUE(isSame(d, d2));
+  rpu->setWeights(w.data());
+  modifyAndForward(d2);
+  ASSERT_FALSE(isSame(d, d2));
+
+  // no caching by default
+  wmpar.type = WeightModifierType::AddNormal;
+  wmpar.cache_refresh_every = 0;
+  modifyAndForward(d);
+  modifyAndForward(d2);
+  ASSERT_FALSE(isSame(d, d2));
+}
+
+TEST_F(RPUTestNoiseFree, PCMReadNoiseCachedAbsWeights) {
+
+  for (auto io : {&p.f_io, &p.b_io}) {
+    io->w_noise_type = OutputWeightNoiseType::PCMRead;
+    io->w_noise = 0.05;
+  }
+  constructRPU();
+
+  int m_batch = 2;
+  auto isZero = [](const std::vector<num_t> &v) {
+    for (auto value : v) {
+      if (value != (num_t)0.0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // populate the |W| caches
+  rpu->forward(rx.data(), d.data(), false, m_batch);
+  rpu->backward(rd.data(), x.data(), false, m_batch);
+  rpu->forward(rx.data(), d.data());
+  rpu->backward(rd.data(), x.data());
+  ASSERT_FALSE(isZero(d));
+  ASSERT_FALSE(isZero(x));
+
+  // zero weights: no read noise, thus caches need to be refreshed
+  std::fill(w.begin(), w.end(), (num_t)0.0);
+  rpu->setWeights(w.data());
+
+  rpu->forward(rx.data(), d.data(), false, m_batch);
+  rpu->backward(rd.data(), x.data(), false, m_batch);
+  ASSERT_TRUE(isZero(d));
+  ASSERT_TRUE(isZero(x));
+
+  std::fill(d2.begin(), d2.end(), (num_t)1.0);
+  std::fill(x2.begin(), x2.end(), (num_t)1.0);
+  rpu->forward(rx.data(), d2.data());
+  rpu->backward(rd.data(), x2.data());
+  for (int j = 0; j < d_size; j++) {
+    ASSERT_EQ(d2[j], (num_t)0.0);
+  }
+  for (int j = 0; j < x_size; j++) {
+    ASSERT_EQ(x2[j], (num_t)0.0);
+  }
+}
+
+TEST_F(RPUTestNoiseFree, PCMReadNoiseWeightSetters) {
+
+  // the |W| cache needs to be refreshed by any weight setter: the
+  // normalized read noise needs to follow the current weights
+  p.f_io = IOMetaParameter<num_t>();
+  p.f_io.inp_res = -1.0;
+  p.f_io.out_res = -1.0;
+  p.f_io.inp_bound = 10.0;
+  p.f_io.out_bound = 0.0;
+  p.f_io.out_noise = 0.0;
+  p.f_io.noise_management = NoiseManagementType::None;
+  p.f_io.bound_management = BoundManagementType::None;
+  p.f_io.w_noise_type = OutputWeightNoiseType::PCMRead;
+  p.f_io.w_noise = 0.1;
+  dp.lifetime = 2.0;
+  dp.drift.nu = 0.5;
+  constructRPU();
+
+  int n_reps = 500;
+  num_t last_var = 0.0;
+  auto checkNoise = [&]() {
+    // expected PCM read noise variance: |W| * x.^2
+    rpu->getWeights(w.data());
+    std::vector<num_t> mean(d_size, (num_t)0.0), var(d_size, (num_t)0.0);
+    num_t total_var = 0.0;
+    for (int i = 0; i < d_size; i++) {
+      for (int j = 0; j < x_size; j++) {
+        mean[i] += w[i * x_size + j] * rx[j];
+        var[i] += (num_t)fabsf(w[i * x_size + j]) * rx[j] * rx[j];
+      }
+      total_var += var[i];
+    }
+    num_t z2 = 0.0;
+    for (int k = 0; k < n_reps; k++) {
+      rpu->forward(rx.data(), d.data());
+      for (int i = 0; i < d_size; i++) {
+        num_t z = (d[i] - mean[i]) / (p.f_io.w_noise * (num_t)sqrtf(var[i]));
+        z2 += z * z;
+      }
+    }
+    // standard normal after normalization
+    ASSERT_NEAR(z2 / (num_t)(n_reps * d_size), 1.0, 0.2);
+    // the expected variance indeed changed
+    ASSERT_TRUE(total_var > (num_t)1.3 * last_var || last_var > (num_t)1.3 * total_var);
+    last_var = total_var;
+  };
+  checkNoise();
+
+  rpu->getWeights(w.data());
+  for (int i = 0; i < x_size * d_size; i++) {
+    w[i] *= 2.0;
+  }
+  rpu->setWeights(w.data());
+  checkNoise();
+
+  rpu->decayWeights(false);
+  checkNoise();
+
+  WeightClipParameter wclpar;
+  wclpar.type = WeightClipType::FixedValue;
+  wclpar.fixed_value = 0.2;
+  rpu->clipWeights(wclpar);
+  checkNoise();
+
+  std::vector<std::string> names;
+  rpu->getDeviceParameterNames(names);
+  std::vector<std::vector<num_t>> dev_pars(names.size(), std::vector<num_t>(x_size * d_size));
+  std::vector<num_t *> dev_ptrs;
+  for (auto &v : dev_pars) {
+    dev_ptrs.push_back(v.data());
+  }
+  rpu->getDeviceParameter(dev_ptrs);
+  std::fill(dev_pars[0].begin(), dev_pars[0].end(), (num_t)0.1);  // max bound
+  std::fill(dev_pars[1].begin(), dev_pars[1].end(), (num_t)-0.1); // min bound
+  rpu->setDeviceParameter(dev_ptrs);
+  checkNoise();
+
+  rpu->driftWeights(1000.0);
+  checkNoise();
+
+  // remapping needs the FP update
+  p.up.pulse_type = PulseType::None;
+  constructRPU();
+  last_var = 0.0;
+  checkNoise();
+
+  WeightRemapParameter wrmpar;
+  wrmpar.type = WeightRemapType::LayerwiseSymmetric;
+  std::vector<num_t> scales(d_size, (num_t)1.0);
+  rpu->remapWeights(wrmpar, scales.data());
+  checkNoise();
+}
+
+TEST_F(RPUTestNoiseFree, BinaryStateRoundTrip) {
+
+  constructRPU();
+  rpu->forward(rx.data(), d.data());
+  rpu->update(rx.data(), rd.data());
+
+  RPU::state_t state;
+  rpu->dumpExtra(state, "rpu");
+  std::vector<char> buffer = RPU::dumpStateBinary(state);
+  ASSERT_EQ(buffer.size(), RPU::getStateBinarySize(state));
+
+  // restore into a fresh RPU directly from the buffer
+  rpu->getWeights(w.data());
+  auto rpu2 = RPUPulsed<num_t>(x_size, d_size);
+  rpu2.populateParameter(&p, &dp);
+  rpu2.setWeights(w.data());
+  auto view = RPU::viewStateBinary(buffer.data(), buffer.size());
+  ASSERT_EQ(view.size(), state.size());
+  rpu2.loadExtra(view, "rpu", true);
+
+  RPU::state_t state2;
+  rpu2.dumpExtra(state2, "rpu");
+  ASSERT_EQ(state2.size(), state.size());
+  for (const auto &kv : state) {
+    const auto &value2 = state2.at(kv.first);
+    ASSERT_EQ(kv.second.dtype(), value2.dtype());
+    ASSERT_EQ(kv.second.nbytes(), value2.nbytes());
+    ASSERT_EQ(memcmp(kv.second.data(), value2.data(), value2.nbytes()), 0) << kv.first;
+  }
+
+  // legacy double values are converted
+  std::vector<num_t> values{1.5, -2.0};
+  RPU::state_t legacy;
+  legacy["x"] = std::vector<double>{1.5, -2.0};
+  std::vector<num_t> loaded;
+  RPU::load(legacy, "x", loaded, true);
+  ASSERT_EQ(loaded, values);
+
+  // truncated buffers are detected
+  EXPECT_THROW(RPU::viewStateBinary(buffer.data(), buffer.size() / 2), std::runtime_error);
+}
+
+TEST(RPUBinaryStateTest, CorruptedBuffers) {
+
+  RPU::state_t state;
+  state["a"] = RPU::StateValue::copyFrom(std::vector<float>{1.0, 2.0, 3.0}.data(), 3);
+  state["bb"] = std::vector<double>{-1.0};
+  std::vector<char> buffer = RPU::dumpStateBinary(state);
+  ASSERT_EQ(RPU::viewStateBinary(buffer.data(), buffer.size()).size(), 2);
+
+  // any truncation
+  for (size_t n = 0; n < buffer.size(); n++) {
+    EXPECT_THROW(RPU::viewStateBinary(buffer.data(), n), std::runtime_error) << n;
+  }
+
+  // garbage
+  std::vector<char> garbage(buffer.size());
+  for (size_t i = 0; i < garbage.size(); i++) {
+    garbage[i] = (char)(i * 37 + 11);
+  }
+  EXPECT_THROW(RPU::viewStateBinary(garbage.data(), garbage.size()), std::runtime_error);
+
+  // header: magic[8], version (uint32), n_entries (uint32), total_size (uint64)
+  // entry: offset (uint64), size (uint64), key_length (uint32), dtype (uint8), reserved[3]
+  const size_t header_size = 24;
+  auto corrupt = [&](size_t pos, auto value) {
+    std::vector<char> bad(buffer);
+    memcpy(bad.data() + pos, &value, sizeof(value));
+    return bad;
+  };
+  std::vector<std::vector<char>> bad_buffers{
+      corrupt(12, (uint32_t)0xFFFFFFFF),                      // n_entries
+      corrupt(16, (uint64_t)0xFFFFFFFFFFFFFFFF),              // total_size
+      corrupt(16, (uint64_t)8),                               // total_size
+      corrupt(header_size, (uint64_t)0xFFFFFFFFFFFFFF00),     // entry offset
+      corrupt(header_size + 8, (uint64_t)0x8000000000000000), // entry size (wraps)
+      corrupt(header_size + 8, (uint64_t)100),                // entry size
+      corrupt(header_size + 16, (uint32_t)0xFFFFFFFF),        // key length
+      corrupt(header_size + 20, (uint8_t)0xFF),               // dtype
+  };
+  for (const auto &bad : bad_buffers) {
+    EXPECT_THROW(RPU::viewStateBinary(bad.data(), bad.size()), std::runtime_error);
+  }
+}
+
+/* RPUSimple that gathers the full indexed tensor (as on GPU) */
+class RPUSimpleBatchedIndexed : public RPUSimple<num_t> {
+public:
+  RPUSimpleBatchedIndexed(int x_size, int d_size) : RPUSimple<num_t>(x_size, d_size){};
+
+protected:
+  bool hasSampleLocalForward() const override { return false; };
+};
+
+class RPUSimpleIndexedTestFixture : public ::testing::TestWithParam<bool> {
+public:
+  void SetUp() {
+    // large enough for the parallel copies
+    x_size = 33;
+    d_size = 7;
+    m_batch = 125;
+    dim3 = 9;
+    input_matrix_size = 50;
+    output_matrix_size = 40;
+
+    RealWorldRNG<num_t> rw_rng(12);
+    w.resize(d_size * x_size);
+    for (auto &v : w) {
+      v = (num_t)rw_rng.sampleUniform() - (num_t)0.5;
+    }
+    // 0 and 1 are padding and bias, others are shifted by 2
+    indices.resize(m_batch * x_size);
+    for (auto &j : indices) {
+      j = (int)floorf(rw_rng.sampleUniform() * (output_matrix_size + 2));
+    }
+    x_input.resize(input_matrix_size * dim3);
+    for (auto &v : x_input) {
+      v = (num_t)rw_rng.sampleUniform() - (num_t)0.5;
+    }
+    d_input.resize(d_size * m_batch * dim3);
+    for (auto &v : d_input) {
+      v = (num_t)rw_rng.sampleUniform() - (num_t)0.5;
+    }
+  };
+
+  /* original (element-wise) index formula of the gather/scatter */
+  int referenceIndex(int idx, bool trans) {
+    if (!trans) {
+      return idx;
+    }
+    int M = m_batch * x_size;
+    int L = m_batch * dim3;
+    return (idx % L) / m_batch * M + (idx % m_batch) + idx / L * m_batch;
+  };
+
+  /* original serial permute132 */
+  void referencePermute132(num_t *out, const num_t *in, int d1, int d2, int d3) {
+    int output_offset = 0;
+    for (int i = 0; i < d2; ++i) {
+      int input_offset = i * d1;
+      for (int j = 0; j < d3; ++j) {
+        for (int k = 0; k < d1; k++) {
+          out[output_offset + k] = in[input_offset + k];
+        }
+        output_offset += d1;
+        input_offset += d1 * d2;
+      }
+    }
+  };
+
+  std::vector<num_t> referenceForward(bool trans) {
+    int M = m_batch * x_size;
+    int L = m_batch * dim3;
+    std::vector<num_t> x_tensor(x_size * L);
+    for (int idx = 0; idx < x_size * L; idx++) {
+      int i = referenceIndex(idx, trans);
+      int j_shifted = indices[i % M];
+      x_tensor[idx] = (j_shifted <= 1) ? (num_t)j_shifted
+                                       : x_input[(j_shifted - 2) + i / M * input_matrix_size];
+    }
+    std::vector<num_t> d_tensor(d_size * L);
+    for (int k = 0; k < L; k++) {
+      for (int i = 0; i < d_size; i++) {
+        num_t value = 0.0;
+        for (int j = 0; j < x_size; j++) {
+          value += w[i * x_size + j] * (trans ? x_tensor[j * L + k] : x_tensor[k * x_size + j]);
+        }
+        (trans ? d_tensor[i * L + k] : d_tensor[k * d_size + i]) = value;
+      }
+    }
+    if (!trans) {
+      return d_tensor;
+    }
+    std::vector<num_t> d_output(d_size * L);
+    referencePermute132(d_output.data(), d_tensor.data(), m_batch, dim3, d_size);
+    return d_output;
+  };
+
+  std::vector<num_t> referenceBackward(bool trans) {
+    int M = m_batch * x_size;
+    int L = m_batch * dim3;
+    std::vector<num_t> d_tensor(d_input);
+    if (trans) {
+      referencePermute132(d_tensor.data(), d_input.data(), m_batch, d_size, dim3);
+    }
+    std::vector<num_t> x_tensor(x_size * L);
+    for (int k = 0; k < L; k++) {
+      for (int j = 0; j < x_size; j++) {
+        num_t value = 0.0;
+        for (int i = 0; i < d_size; i++) {
+          value += w[i * x_size + j] * (trans ? d_tensor[i * L + k] : d_tensor[k * d_size + i]);
+        }
+        (trans ? x_tensor[j * L + k] : x_tensor[k * x_size + j]) = value;
+      }
+    }
+    std::vector<num_t> x_output(output_matrix_size * dim3, (num_t)0.0);
+    for (int idx = 0; idx < x_size * L; idx++) {
+      int i = referenceIndex(idx, trans);
+      int j_shifted = indices[i % M];
+      if (j_shifted > 1) {
+        x_output[(j_shifted - 2) + i / M * output_matrix_size] += x_tensor[idx];
+      }
+    }
+    return x_output;
+  };
+
+  int x_size, d_size, m_batch, dim3, input_matrix_size, output_matrix_size;
+  std::vector<num_t> w, x_input, d_input;
+  std::vector<int> indices;
+};
+
+// whether the inputs and outputs are transposed
+INSTANTIATE_TEST_CASE_P(Trans, RPUSimpleIndexedTestFixture, ::testing::Bool());
+
+TEST_P(RPUSimpleIndexedTestFixture, ForwardIndexed) {
+
+  bool trans = GetParam();
+  std::vector<num_t> d_ref = referenceForward(trans);
+
+  // per image
+  RPUSimple<num_t> rpu(x_size, d_size);
+  rpu.setWeights(w.data());
+  rpu.setMatrixIndices(indices.data());
+  std::vector<num_t> d_output(d_ref.size());
+  rpu.forwardIndexed(
+      x_input.data(), d_output.data(), x_input.size(), m_batch, dim3, trans, true);
+
+  // full gathered tensor
+  RPUSimpleBatchedIndexed rpu_batched(x_size, d_size);
+  rpu_batched.setWeights(w.data());
+  rpu_batched.setMatrixIndices(indices.data());
+  std::vector<num_t> d_output_batched(d_ref.size());
+  rpu_batched.forwardIndexed(
+      x_input.data(), d_output_batched.data(), x_input.size(), m_batch, dim3, trans, true);
+
+  for (size_t i = 0; i < d_ref.size(); i++) {
+    ASSERT_NEAR(d_output[i], d_ref[i], TOLERANCE) << i;
+    ASSERT_NEAR(d_output_batched[i], d_ref[i], TOLERANCE) << i;
+  }
+}
+
+TEST_P(RPUSimpleIndexedTestFixture, BackwardIndexed) {
+
+  bool trans = GetParam();
+  std::vector<num_t> x_ref = referenceBackward(trans);
+
+  RPUSimple<num_t> rpu(x_size, d_size);
+  rpu.setWeights(w.data());
+  rpu.setMatrixIndices(indices.data());
+  std::vector<num_t> x_output(x_ref.size());
+  rpu.backwardIndexed(d_input.data(), x_output.data(), x_output.size(), m_batch, dim3, trans);
+
+  for (size_t i = 0; i < x_ref.size(); i++) {
+    ASSERT_NEAR(x_output[i], x_ref[i], TOLERANCE) << i;
+  }
+}
+
 } // namespace
 
 int main(int argc, char **argv) {
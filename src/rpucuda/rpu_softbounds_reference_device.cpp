@@ -186,49 +186,46 @@ void SoftBoundsReferenceRPUDevice<T>::doSparseUpdate(
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[i];
-  T *scale_up = this->w_scale_up_[i];
+  auto *pack = this->getPackedUpdateParameters() + i * this->x_size_;
   T *ref = w_reference_[i];
   T *w = par.usesPersistentWeight() ? this->w_persistent_[i] : weights[i];
   T *w_apparent = weights[i];
-  T *min_bound = this->w_min_bound_[i];
-  T *max_bound = this->w_max_bound_[i];
   T write_noise_std = par.getScaledWriteNoise();
   if (par.mult_noise) {
     PULSED_UPDATE_W_LOOP(update_once_mult(
-                             w[j], w_apparent[j], sign, scale_down[j], scale_up[j], ref[j],
-                             min_bound[j], max_bound[j], par.dw_min_std, write_noise_std, rng););
+                             w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                             ref[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std,
+                             write_noise_std, rng););
   } else {
     PULSED_UPDATE_W_LOOP(update_once_add(
-                             w[j], w_apparent[j], sign, scale_down[j], scale_up[j], ref[j],
-                             min_bound[j], max_bound[j], par.dw_min_std, write_noise_std, rng););
+                             w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                             ref[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std,
+                             write_noise_std, rng););
   }
 }
 
 template <typename T>
-void SoftBoundsReferenceRPUDevice<T>::doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) {
+void SoftBoundsReferenceRPUDevice<T>::doDenseUpdateRows(
+    T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) {
 
   const auto &par = getPar();
 
-  T *scale_down = this->w_scale_down_[0];
-  T *scale_up = this->w_scale_up_[0];
+  auto *pack = this->getPackedUpdateParameters();
   T *ref = w_reference_[0];
   T *w = par.usesPersistentWeight() ? this->w_persistent_[0] : weights[0];
   T *w_apparent = weights[0];
-  T *min_bound = this->w_min_bound_[0];
-  T *max_bound = this->w_max_bound_[0];
   T write_noise_std = par.getScaledWriteNoise();
 
   if (par.mult_noise) {
     PULSED_UPDATE_W_LOOP_DENSE(update_once_mult(
-                                   w[j], w_apparent[j], sign, scale_down[j], scale_up[j], ref[j],
-                                   min_bound[j], max_bound[j], par.dw_min_std, write_noise_std,
-                                   rng););
+                                   w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                                   ref[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std,
+                                   write_noise_std, rng););
   } else {
     PULSED_UPDATE_W_LOOP_DENSE(update_once_add(
-                                   w[j], w_apparent[j], sign, scale_down[j], scale_up[j], ref[j],
-                                   min_bound[j], max_bound[j], par.dw_min_std, write_noise_std,
-                                   rng););
+                                   w[j], w_apparent[j], sign, pack[j].scale_down, pack[j].scale_up,
+                                   ref[j], pack[j].min_bound, pack[j].max_bound, par.dw_min_std,
+                                   write_noise_std, rng););
   }
 }
 
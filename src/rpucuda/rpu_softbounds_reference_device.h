@@ -105,7 +105,8 @@ template <typename T> class SoftBoundsReferenceRPUDevice : public PulsedRPUDevic
   void doSparseUpdate(
       T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng)
       override;
-  void doDenseUpdate(T **weights, int *coincidences, RNG<T> *rng) override;
+  void doDenseUpdateRows(
+      T **weights, int *coincidences, int i_start, int i_end, RNG<T> *rng) override;
 
 private:
   T **w_reference_ = nullptr;
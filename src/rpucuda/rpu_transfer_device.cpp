@@ -101,6 +101,9 @@ void TransferRPUDeviceMetaParameter<T>::printToStream(std::stringstream &ss) con
   if (random_selection) {
     ss << "\t [random selection]";
   }
+  if (transfer_batched) {
+    ss << "\t [batched]";
+  }
   ss << std::endl;
 
   ss << "\t\bTransfer IO: \n";
@@ -431,6 +434,35 @@ void TransferRPUDevice<T>::writeVector(
   }
 }
 
+/* n_vec vectors (each of in_size) consecutive in memory */
+template <typename T>
+void TransferRPUDevice<T>::readMatrix(
+    int device_idx, const T *in_vecs, T *out_vecs, const int n_vec, T alpha) {
+  T **W = getDeviceWeights(device_idx);
+  if (getPar().transfer_columns) {
+    transfer_fb_pass_->forwardMatrix(W, in_vecs, out_vecs, n_vec, false, false, alpha, false);
+  } else {
+    transfer_fb_pass_->backwardMatrix(W, in_vecs, out_vecs, n_vec, false, false, alpha);
+  }
+}
+
+template <typename T>
+void TransferRPUDevice<T>::writeMatrix(
+    int device_idx,
+    const T *in_vecs,
+    const T *out_vecs,
+    const int n_vec,
+    const T lr,
+    const int m_batch_info) {
+  const auto &par = getPar();
+  int in_size = par.getInSize();
+  int out_size = par.getOutSize();
+
+  for (size_t i = 0; i < (size_t)n_vec; i++) {
+    writeVector(device_idx, in_vecs + i * in_size, out_vecs + i * out_size, lr, m_batch_info);
+  }
+}
+
 template <typename T>
 void TransferRPUDevice<T>::readAndUpdate(
     int to_device_idx,
@@ -455,6 +487,25 @@ void TransferRPUDevice<T>::readAndUpdate(
   int in_size = par.getInSize();
   int out_size = par.getOutSize();
 
+  if (par.transfer_batched && n_vec > 1) {
+    // read all vectors in one go (before any reset or write)
+    transfer_tmp_.resize((size_t)n_vec * out_size);
+    readMatrix(from_device_idx, vec, transfer_tmp_.data(), n_vec, -1.0); // scale -1 for pos update
+
+    if (par.transfer_columns) {
+      for (int i = 0; i < n_vec; i++) {
+        if (this->rw_rng_.sampleUniform() < reset_prob) {
+          T **W_from = getDeviceWeights(from_device_idx);
+          this->rpu_device_vec_[from_device_idx]->resetCols(
+              W_from, i_slice, n_vec, 1, this->rw_rng_);
+        }
+      }
+    }
+
+    writeMatrix(to_device_idx, vec, transfer_tmp_.data(), n_vec, lr, n_vec);
+    return;
+  }
+
   transfer_tmp_.resize(out_size);
 
   // forward or backward / update
@@ -66,6 +66,7 @@ template <typename T> struct TransferRPUDeviceMetaParameter : VectorRPUDeviceMet
   T with_reset_prob = (T)0.0;
   bool no_self_transfer = true;
   bool random_selection = false;
+  bool transfer_batched = false; // read all vectors of a transfer in one matrix forward
   T fast_lr = 0.0;
   T transfer_lr = (T)1.0;
   std::vector<T> transfer_lr_vec;
@@ -205,6 +206,14 @@ public:
   virtual void writeVector(
       int device_idx, const T *in_vec, const T *out_vec, const T lr, const int m_batch_info);
   virtual void readVector(int device_idx, const T *in_vec, T *out_vec, T alpha);
+  virtual void writeMatrix(
+      int device_idx,
+      const T *in_vecs,
+      const T *out_vecs,
+      const int n_vec,
+      const T lr,
+      const int m_batch_info);
+  virtual void readMatrix(int device_idx, const T *in_vecs, T *out_vecs, const int n_vec, T alpha);
 
   void doSparseUpdate(
       T **weights, int i, const int *x_signed_indices, int x_count, int d_sign, RNG<T> *rng)
@@ -18,6 +18,7 @@
 #include <chrono>
 #include <memory>
 #include <random>
+#include <tuple>
 // #include "test_helper.h"
 
 #define TOLERANCE 1e-5
@@ -26,9 +27,12 @@ namespace {
 
 using namespace RPU;
 
-class RPUDeviceTestFixture : public ::testing::TestWithParam<float> {
+class RPUDeviceTestFixture : public ::testing::TestWithParam<std::tuple<float, bool>> {
 public:
   void SetUp() {
+    gamma = std::get<0>(GetParam());
+    batched = std::get<1>(GetParam());
+
     x_size = 2;
     d_size = 3;
 
@@ -68,7 +72,8 @@ public:
 
     dp = new TransferRPUDeviceMetaParameter<num_t>(dp_cs, 2);
 
-    dp->gamma = GetParam(); // meaning fully hidden
+    dp->gamma = gamma; // meaning fully hidden
+    dp->transfer_batched = batched;
     dp->transfer_lr = 1;
 
     dp->transfer_io.inp_res = -1;
@@ -89,6 +94,8 @@ public:
     delete rng;
   };
 
+  num_t gamma;
+  bool batched;
   int *x_indices;
   int n_pos, n_neg, x_size, d_size, colidx;
   num_t lifetime;
@@ -103,7 +110,11 @@ public:
 };
 
 // define the tests
-INSTANTIATE_TEST_CASE_P(GammaWeightening, RPUDeviceTestFixture, ::testing::Values(0.0, 0.5));
+// gamma weightening and whether to read the transfer vectors batched
+INSTANTIATE_TEST_CASE_P(
+    GammaWeighteningBatched,
+    RPUDeviceTestFixture,
+    ::testing::Combine(::testing::Values(0.0, 0.5), ::testing::Bool()));
 
 TEST_P(RPUDeviceTestFixture, createDevice) {
   rpu_device = this->dp->createDevice(this->x_size, this->d_size, &this->rw_rng);
@@ -125,9 +136,9 @@ TEST_P(RPUDeviceTestFixture, onSetWeights) {
   num_t ***w_vec = rpu_device->getWeightVec();
   const num_t *reduce_weightening = rpu_device->getReduceWeightening();
   ASSERT_FLOAT_EQ(reduce_weightening[1], 1);
-  ASSERT_FLOAT_EQ(reduce_weightening[0], GetParam());
+  ASSERT_FLOAT_EQ(reduce_weightening[0], this->gamma);
 
-  if (GetParam()) { // for fully hidden internal weights are not used...
+  if (this->gamma) { // for fully hidden internal weights are not used...
     for (int i = 0; i < this->x_size * this->d_size; i++) {
       num_t w = this->weights[0][i];
       ASSERT_FLOAT_EQ(w, w_ref[0][i]);
@@ -171,7 +182,7 @@ TEST_P(RPUDeviceTestFixture, doSparseUpdate) {
   for (int j = 0; j < this->d_size; j++) {
     for (int i = 0; i < this->x_size; i++) {
       if (j == rowidx && i == this->colidx) {
-        ASSERT_FLOAT_EQ(this->weights[j][i], dx * GetParam());
+        ASSERT_FLOAT_EQ(this->weights[j][i], dx * this->gamma);
       } else {
         ASSERT_FLOAT_EQ(this->weights[j][i], 0);
       }
@@ -181,6 +192,12 @@ TEST_P(RPUDeviceTestFixture, doSparseUpdate) {
 }
 
 TEST_P(RPUDeviceTestFixture, doSparseUpdateWithTransfer) {
+  int n_cycles = this->x_size;
+  if (this->batched) {
+    // all vectors are read (and written) in the first transfer
+    this->dp->n_reads_per_transfer = this->x_size;
+    n_cycles = 0;
+  }
   rpu_device = this->dp->createDevice(this->x_size, this->d_size, &this->rw_rng);
   rpu_device->onSetWeights(this->weights); // all zero
   rpu_device->initUpdateCycle(this->weights, this->up, 1, 1);
@@ -192,7 +209,7 @@ TEST_P(RPUDeviceTestFixture, doSparseUpdateWithTransfer) {
       this->weights, rowidx, this->x_indices, this->n_neg + this->n_pos, (num_t)-1.0, this->rng);
   rpu_device->finishUpdateCycle(this->weights, this->up, 1, 1); // to signal the end of the update
 
-  for (int i = 0; i < this->x_size; i++) {
+  for (int i = 0; i < n_cycles; i++) {
     rpu_device->initUpdateCycle(this->weights, this->up, 1, 1);   // to signal the end of the update
     rpu_device->finishUpdateCycle(this->weights, this->up, 1, 1); // to signal the end of the update
   }
@@ -205,8 +222,8 @@ TEST_P(RPUDeviceTestFixture, doSparseUpdateWithTransfer) {
     for (int j = 0; j < this->d_size; j++) {
       for (int i = 0; i < this->x_size; i++) {
         if (j == rowidx && i == this->colidx) {
-          if (m == 1 && GetParam() == 0) {
-            // if fullyHidden (GetParam==0) then actual weight is updated directly
+          if (m == 1 && this->gamma == 0) {
+            // if fullyHidden (gamma==0) then actual weight is updated directly
             ASSERT_FLOAT_EQ(w_vec[m][j][i], 0);
           } else {
             // should be fully transferred, since transfer_lr = 1
@@ -236,6 +253,12 @@ TEST_P(RPUDeviceTestFixture, doSparseUpdateWithTransfer) {
 
 TEST_P(RPUDeviceTestFixture, doSparseUpdateWithTransferRows) {
   this->dp->transfer_columns = false;
+  int n_cycles = this->d_size;
+  if (this->batched) {
+    // all vectors are read (and written) in the first transfer
+    this->dp->n_reads_per_transfer = this->d_size;
+    n_cycles = 0;
+  }
   rpu_device = this->dp->createDevice(this->x_size, this->d_size, &this->rw_rng);
   rpu_device->onSetWeights(this->weights); // all zero
   rpu_device->initUpdateCycle(this->weights, this->up, 1, 1);
@@ -247,7 +270,7 @@ TEST_P(RPUDeviceTestFixture, doSparseUpdateWithTransferRows) {
       this->weights, rowidx, this->x_indices, this->n_neg + this->n_pos, (num_t)-1.0, this->rng);
   rpu_device->finishUpdateCycle(this->weights, this->up, 1, 1); // to signal the end of the update
 
-  for (int i = 0; i < this->d_size; i++) {
+  for (int i = 0; i < n_cycles; i++) {
     rpu_device->initUpdateCycle(this->weights, this->up, 1, 1);   // to signal the end of the update
     rpu_device->finishUpdateCycle(this->weights, this->up, 1, 1); // to signal the end of the update
   }
@@ -260,8 +283,8 @@ TEST_P(RPUDeviceTestFixture, doSparseUpdateWithTransferRows) {
     for (int j = 0; j < this->d_size; j++) {
       for (int i = 0; i < this->x_size; i++) {
         if (j == rowidx && i == this->colidx) {
-          if (m == 1 && GetParam() == 0) {
-            // if fullyHidden (GetParam==0) then actual weight is updated directly
+          if (m == 1 && this->gamma == 0) {
+            // if fullyHidden (gamma==0) then actual weight is updated directly
             ASSERT_FLOAT_EQ(w_vec[m][j][i], 0);
           } else {
             // should be fully transferred, since transfer_lr = 1
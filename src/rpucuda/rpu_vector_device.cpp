@@ -557,17 +557,25 @@ void VectorRPUDevice<T>::decayWeights(T **weights, T alpha, bool bias_no_decay)
 template <typename T>
 void VectorRPUDevice<T>::driftWeights(T **weights, T time_since_last_call, RNG<T> &rng) {
 
+  // one independent substream per device (race free and reproducible)
+  std::vector<RNG<T>> rngs;
+  rng.getSubstreams(rngs, (int)rpu_device_vec_.size());
+
 #pragma omp parallel for
   for (int k = 0; k < (int)rpu_device_vec_.size(); k++) {
-    rpu_device_vec_[k]->driftWeights(weights_vec_[k], time_since_last_call, rng);
+    rpu_device_vec_[k]->driftWeights(weights_vec_[k], time_since_last_call, rngs[k]);
   }
   reduceToWeights(weights);
 }
 
 template <typename T> void VectorRPUDevice<T>::diffuseWeights(T **weights, RNG<T> &rng) {
+
+  std::vector<RNG<T>> rngs;
+  rng.getSubstreams(rngs, (int)rpu_device_vec_.size());
+
 #pragma omp parallel for
   for (int k = 0; k < (int)rpu_device_vec_.size(); k++) {
-    rpu_device_vec_[k]->diffuseWeights(weights_vec_[k], rng);
+    rpu_device_vec_[k]->diffuseWeights(weights_vec_[k], rngs[k]);
   }
   reduceToWeights(weights);
 }
@@ -583,7 +591,7 @@ template <typename T> void VectorRPUDevice<T>::clipWeights(T **weights, T clip)
 template <typename T>
 void VectorRPUDevice<T>::resetCols(
     T **weights, int start_col, int n_cols, T reset_prob, RealWorldRNG<T> &rng) {
-#pragma omp parallel for
+  // not parallel: the real world RNG cannot be split into substreams
   for (int k = 0; k < (int)rpu_device_vec_.size(); k++) {
     rpu_device_vec_[k]->resetCols(weights_vec_[k], start_col, n_cols, reset_prob, rng);
   }
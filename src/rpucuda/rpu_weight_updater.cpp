@@ -13,6 +13,10 @@
 #include "rpu_weight_updater.h"
 #include "rpu_vector_device.h"
 #include "utility_functions.h"
+#include <algorithm>
+
+#define RPU_UPDATE_ROW_BLOCKS 64
+#define RPU_UPDATE_DENSE_BLOCK_SIZE 4096
 
 namespace RPU {
 
@@ -200,6 +204,150 @@ bool PulsedRPUWeightUpdater<T>::checkForFPUpdate(AbstractRPUDevice<T> *rpu_devic
   return false;
 }
 
+/* updates all rows i_start <= i < i_end from the current sparse
+   counts. Note that d_indices are sorted by row */
+template <typename T>
+void PulsedRPUWeightUpdater<T>::sparseUpdate(
+    T **weights,
+    const int BL,
+    const int lr_sign,
+    const int i_start,
+    const int i_end,
+    PulsedRPUDeviceBase<T> *rpu_device,
+    RNG<T> *rng) {
+
+  int *x_counts_p;
+  int *x_counts_n;
+  int *d_counts;
+  int **x_indices_p;
+  int **x_indices_n;
+  int **d_indices;
+
+  bool do_negative_separatly = sblm_->getCountsAndIndices(
+      x_counts_p, x_counts_n, d_counts, x_indices_p, x_indices_n, d_indices);
+
+  for (int k = 0; k < BL; k++) {
+    if (d_counts[k] > 0) {
+      const int *d_idx = d_indices[k];
+      int ii = 0;
+      if (i_start > 0) {
+        ii = (int)(std::lower_bound(
+                       d_idx, d_idx + d_counts[k], i_start,
+                       [](int i_signed, int i) { return abs(i_signed) - 1 < i; }) -
+                   d_idx);
+      }
+      for (; ii < d_counts[k]; ii++) {
+
+        int i_signed = d_idx[ii];
+        int d_sign = i_signed < 0 ? -lr_sign : lr_sign;
+        int i = i_signed < 0 ? -i_signed - 1 : i_signed - 1;
+        if (i >= i_end) {
+          break;
+        }
+
+        // let rpu_device decide how to update w
+        if (x_counts_p[k] > 0) {
+          rpu_device->doSparseUpdate(weights, i, x_indices_p[k], x_counts_p[k], d_sign, rng);
+        }
+        if (do_negative_separatly) {
+          if (x_counts_n[k] > 0) {
+            rpu_device->doSparseUpdate(weights, i, x_indices_n[k], x_counts_n[k], d_sign, rng);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void PulsedRPUWeightUpdater<T>::makeSparseRowSchedule(const int BL, const int lr_sign) {
+
+  int *x_counts_p;
+  int *x_counts_n;
+  int *d_counts;
+  int **x_indices_p;
+  int **x_indices_n;
+  int **d_indices;
+
+  row_pulses_negative_separately_ = sblm_->getCountsAndIndices(
+      x_counts_p, x_counts_n, d_counts, x_indices_p, x_indices_n, d_indices);
+
+  // count the pulses per row
+  row_pulse_offsets_.assign(this->d_size_ + 1, 0);
+  int n_pulses = 0;
+  for (int k = 0; k < BL; k++) {
+    for (int ii = 0; ii < d_counts[k]; ii++) {
+      row_pulse_offsets_[abs(d_indices[k][ii])]++;
+    }
+    n_pulses += d_counts[k];
+  }
+  for (int i = 0; i < this->d_size_; i++) {
+    row_pulse_offsets_[i + 1] += row_pulse_offsets_[i];
+  }
+
+  // fill in order of k, encoded as 2 * k + (negative sign)
+  row_pulses_.resize(MAX(n_pulses, 1));
+  for (int k = 0; k < BL; k++) {
+    const int *d_idx = d_indices[k];
+    for (int ii = 0; ii < d_counts[k]; ii++) {
+      int i_signed = d_idx[ii];
+      int d_sign = i_signed < 0 ? -lr_sign : lr_sign;
+      int i = i_signed < 0 ? -i_signed - 1 : i_signed - 1;
+      row_pulses_[row_pulse_offsets_[i]++] = 2 * k + (d_sign < 0 ? 1 : 0);
+    }
+  }
+  // offsets were shifted by one row while filling
+  for (int i = this->d_size_; i > 0; i--) {
+    row_pulse_offsets_[i] = row_pulse_offsets_[i - 1];
+  }
+  row_pulse_offsets_[0] = 0;
+}
+
+template <typename T>
+void PulsedRPUWeightUpdater<T>::sparseUpdateRows(
+    T **weights,
+    const int i_start,
+    const int i_end,
+    PulsedRPUDeviceBase<T> *rpu_device,
+    RNG<T> *rng) {
+
+  int *x_counts_p;
+  int *x_counts_n;
+  int *d_counts;
+  int **x_indices_p;
+  int **x_indices_n;
+  int **d_indices;
+
+  sblm_->getCountsAndIndices(x_counts_p, x_counts_n, d_counts, x_indices_p, x_indices_n, d_indices);
+
+  for (int i = i_start; i < i_end; i++) {
+    for (int l = row_pulse_offsets_[i]; l < row_pulse_offsets_[i + 1]; l++) {
+      int k = row_pulses_[l] >> 1;
+      int d_sign = (row_pulses_[l] & 1) ? -1 : 1;
+
+      if (x_counts_p[k] > 0) {
+        rpu_device->doSparseUpdate(weights, i, x_indices_p[k], x_counts_p[k], d_sign, rng);
+      }
+      if (row_pulses_negative_separately_) {
+        if (x_counts_n[k] > 0) {
+          rpu_device->doSparseUpdate(weights, i, x_indices_n[k], x_counts_n[k], d_sign, rng);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+std::vector<RNG<T>> &PulsedRPUWeightUpdater<T>::getBlockRNGs(int n_blocks) {
+  if ((int)rng_substreams_.size() != n_blocks || rng_substreams_src_ != &*rng_ ||
+      rng_substreams_version_ != rng_->getStateVersion()) {
+    rng_->getSubstreams(rng_substreams_, n_blocks);
+    rng_substreams_src_ = &*rng_;
+    rng_substreams_version_ = rng_->getStateVersion();
+  }
+  return rng_substreams_;
+}
+
 template <typename T>
 void PulsedRPUWeightUpdater<T>::updateVectorWithDevice(
     T **weights,
@@ -255,36 +403,68 @@ void PulsedRPUWeightUpdater<T>::updateVectorWithDevice(
     int lr_sign = pc_learning_rate < (T)0.0 ? -1 : 1;
 
     if (BL > 0) {
+      // rows are independent within a bit line: optionally apply
+      // all pulses of one row at once (in the order of the bit line)
+      bool row_bucketed = up_.row_bucketed_update && rpu_device->hasRowLocalUpdate();
+      if (row_bucketed) {
+        makeSparseRowSchedule(BL, lr_sign);
+      }
+      auto sparse_update = [&](int i_start, int i_end, RNG<T> *rng) -> void {
+        if (row_bucketed) {
+          sparseUpdateRows(weights, i_start, i_end, rpu_device, rng);
+        } else {
+          sparseUpdate(weights, BL, lr_sign, i_start, i_end, rpu_device, rng);
+        }
+      };
+
+      if (up_.parallel_update && rpu_device->hasRowLocalUpdate()) {
+        // update row blocks concurrently, each with its own random
+        // substream (fixed number of blocks for reproducibility). Any
+        // lazy device state is prepared in initUpdateCycle above
+        int n_blocks = MIN(this->d_size_, RPU_UPDATE_ROW_BLOCKS);
+        int block_size = (this->d_size_ + n_blocks - 1) / n_blocks;
+        std::vector<RNG<T>> &block_rngs = getBlockRNGs(n_blocks);
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i_block = 0; i_block < n_blocks; i_block++) {
+          int i_start = i_block * block_size;
+          sparse_update(i_start, MIN(i_start + block_size, this->d_size_), &block_rngs[i_block]);
+        }
+      } else {
+        sparse_update(0, this->d_size_, &*rng_);
+      }
+    }
+  } else if (rpu_device->hasRowLocalUpdate()) {
+    // use dense update in row blocks: coincidences are generated
+    // block-wise (and zero blocks skipped) right before they are
+    // applied, so that the block stays in cache
+    int BL = dblm_->makeCounts(
+        x_input, x_inc, x_noz_, d_input, d_inc, d_noz_, &*rng_, pc_learning_rate,
+        weight_granularity, up_);
 
-      int *x_counts_p;
-      int *x_counts_n;
-      int *d_counts;
-      int **x_indices_p;
-      int **x_indices_n;
-      int **d_indices;
-
-      bool do_negative_separatly = sblm_->getCountsAndIndices(
-          x_counts_p, x_counts_n, d_counts, x_indices_p, x_indices_n, d_indices);
-
-      for (int k = 0; k < BL; k++) {
-        if (d_counts[k] > 0) {
-          for (int ii = 0; ii < d_counts[k]; ii++) {
-
-            int i_signed = d_indices[k][ii];
-            int d_sign = i_signed < 0 ? -lr_sign : lr_sign;
-            int i = i_signed < 0 ? -i_signed - 1 : i_signed - 1;
-
-            // let rpu_device decide how to update w
-            if (x_counts_p[k] > 0) {
-              rpu_device->doSparseUpdate(weights, i, x_indices_p[k], x_counts_p[k], d_sign, &*rng_);
-            }
-            if (do_negative_separatly) {
-              if (x_counts_n[k] > 0) {
-                rpu_device->doSparseUpdate(
-                    weights, i, x_indices_n[k], x_counts_n[k], d_sign, &*rng_);
-              }
-            }
-          }
+    if (BL > 0) {
+      int block_rows = MAX(RPU_UPDATE_DENSE_BLOCK_SIZE / this->x_size_, 1);
+      int n_blocks = (this->d_size_ + block_rows - 1) / block_rows;
+
+      auto dense_update = [&](int i_block, RNG<T> *rng) -> void {
+        int i_start = i_block * block_rows;
+        int i_end = MIN(i_start + block_rows, this->d_size_);
+        int *c_block = dblm_->makeCoincidenceBlock(i_start, i_end);
+        if (c_block != nullptr) {
+          rpu_device->doDenseUpdateRows(weights, c_block, i_start, i_end, rng);
+        }
+      };
+
+      if (up_.parallel_update && n_blocks > 1) {
+        std::vector<RNG<T>> &block_rngs = getBlockRNGs(n_blocks);
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i_block = 0; i_block < n_blocks; i_block++) {
+          dense_update(i_block, &block_rngs[i_block]);
+        }
+      } else {
+        for (int i_block = 0; i_block < n_blocks; i_block++) {
+          dense_update(i_block, &*rng_);
         }
       }
     }
@@ -299,6 +479,84 @@ void PulsedRPUWeightUpdater<T>::updateVectorWithDevice(
   rpu_device->finishUpdateCycle(weights, up_, learning_rate, m_batch_info);
 }
 
+template <typename T>
+void PulsedRPUWeightUpdater<T>::updateRowsWithDevice(
+    T **weights,
+    const T *x_inputs,
+    const int d_row_start,
+    const int n_rows,
+    const T learning_rate,
+    const int m_batch_info,
+    AbstractRPUDevice<T> *rpu_device_in) {
+  if (!learning_rate || n_rows <= 0) {
+    return; // do nothing
+  }
+  if (d_row_start < 0 || d_row_start + n_rows > this->d_size_) {
+    RPU_FATAL("Row range out of bounds.");
+  }
+
+  // single one-hot d vector (zero except at the current row). It is
+  // handed to the device, which might use the update input.
+  if (d_one_hot_.size() != (size_t)this->d_size_) {
+    d_one_hot_.assign(this->d_size_, (T)0.0);
+  }
+
+  bool one_hot_pulses = rpu_device_in != nullptr && !rpu_device_in->hasDirectUpdate() &&
+                        up_.pulse_type != PulseType::NoneWithDevice &&
+                        !checkForFPUpdate(rpu_device_in) && sblm_->supports(up_.pulse_type);
+
+  if (!one_hot_pulses) {
+    for (int j = 0; j < n_rows; j++) {
+      int i_row = d_row_start + j;
+      d_one_hot_[i_row] = (T)1.0;
+      updateVectorWithDevice(
+          weights, x_inputs + (size_t)j * this->x_size_, 1, d_one_hot_.data(), 1, learning_rate,
+          m_batch_info, rpu_device_in);
+      d_one_hot_[i_row] = (T)0.0;
+    }
+    return;
+  }
+
+  auto *rpu_device = static_cast<PulsedRPUDeviceBase<T> *>(rpu_device_in);
+  T weight_granularity = rpu_device->getWeightGranularity();
+
+  // without any state in the update cycle (e.g. no meta-device), the
+  // whole block of rows can share a single update cycle
+  bool single_cycle = !rpu_device->hasUpdateCycleState();
+  T pc_learning_rate = (T)0.0;
+
+  for (int j = 0; j < n_rows; j++) {
+    int i_row = d_row_start + j;
+    const T *x_input = x_inputs + (size_t)j * this->x_size_;
+    d_one_hot_[i_row] = (T)1.0;
+
+    if (up_.d_sparsity) {
+      up_._d_sparsity = getCurrentDSparsity();
+    }
+    if (!single_cycle || j == 0) {
+      rpu_device->initUpdateCycle(
+          weights, up_, learning_rate, m_batch_info, x_input, 1, d_one_hot_.data(), 1);
+      pc_learning_rate = rpu_device->getPulseCountLearningRate(learning_rate, m_batch_info, up_);
+    }
+    d_noz_ = 0;
+    x_noz_ = 0;
+
+    // pulses are only generated for the single active d-line
+    int BL = sblm_->makeCountsOneHot(
+        x_input, 1, x_noz_, i_row, (T)1.0, d_noz_, &*rng_,
+        pc_learning_rate < (T)0.0 ? -pc_learning_rate : pc_learning_rate, weight_granularity, up_);
+    int lr_sign = pc_learning_rate < (T)0.0 ? -1 : 1;
+
+    if (BL > 0) {
+      sparseUpdate(weights, BL, lr_sign, i_row, i_row + 1, rpu_device, &*rng_);
+    }
+    if (!single_cycle || j == n_rows - 1) {
+      rpu_device->finishUpdateCycle(weights, up_, learning_rate, m_batch_info);
+    }
+    d_one_hot_[i_row] = (T)0.0;
+  }
+}
+
 namespace test_helper {
 void getSparseCountsFromCounts(
     int **&sparse_indices, int *&sparse_counts, uint32_t *&counts, int K, int size) {
@@ -91,6 +91,20 @@ public:
       const int last_m_batch_info,
       AbstractRPUDevice<T> *rpu_device);
 
+  /* Updates the rows d_row_start <= i < d_row_start + n_rows, each
+     with its own x input (x_inputs is n_rows x x_size), i.e. with
+     one-hot d vectors that are never materialized. For sparse pulse
+     types, pulses are only generated for the active d-line, and the
+     rows share one update cycle if the device has no cycle state. */
+  void updateRowsWithDevice(
+      T **weights,
+      const T *x_inputs,
+      const int d_row_start,
+      const int n_rows,
+      const T learning_rate,
+      const int last_m_batch_info,
+      AbstractRPUDevice<T> *rpu_device);
+
   void updateVectorWithDeviceAndCounts(
       T **weights,
       const T *x_input,
@@ -111,12 +125,42 @@ public:
 private:
   void freeContainers();
   void allocateContainers();
+  void sparseUpdate(
+      T **weights,
+      const int BL,
+      const int lr_sign,
+      const int i_start,
+      const int i_end,
+      PulsedRPUDeviceBase<T> *rpu_device,
+      RNG<T> *rng);
+  /* transposes the current sparse counts into per-row pulse lists
+     (ordered by bit line), see sparseUpdateRows */
+  void makeSparseRowSchedule(const int BL, const int lr_sign);
+  /* same as sparseUpdate, but from the per-row schedule, so that
+     each row is loaded once and gets all its pulses in order */
+  void sparseUpdateRows(
+      T **weights,
+      const int i_start,
+      const int i_end,
+      PulsedRPUDeviceBase<T> *rpu_device,
+      RNG<T> *rng);
+  /* substreams of rng_ for n_blocks parallel row blocks. They are
+     split off once and then advance on their own (split again only
+     if n_blocks or the state of rng_ changes, e.g. by a new seed) */
+  std::vector<RNG<T>> &getBlockRNGs(int n_blocks);
   bool containers_allocated_ = false;
   std::shared_ptr<RNG<T>> rng_ = nullptr;
   std::unique_ptr<SparseBitLineMaker<T>> sblm_ = nullptr;
   std::unique_ptr<DenseBitLineMaker<T>> dblm_ = nullptr;
 
   PulsedUpdateMetaParameter<T> up_;
+  std::vector<RNG<T>> rng_substreams_; // for parallel update, see getBlockRNGs
+  const RNG<T> *rng_substreams_src_ = nullptr;
+  uint64_t rng_substreams_version_ = 0;
+  std::vector<T> d_one_hot_;            // tmp for row-wise update
+  std::vector<int> row_pulse_offsets_;  // tmp for row-bucketed update
+  std::vector<int> row_pulses_;         // (BL index, sign) per pulse, grouped by row
+  bool row_pulses_negative_separately_ = false;
 
   int d_noz_ = 0;
   int x_noz_ = 0;
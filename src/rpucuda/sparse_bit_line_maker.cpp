@@ -358,6 +358,74 @@ int SparseBitLineMaker<T>::makeCounts(
   return BL; // this is the actual
 }
 
+// makeCountsOneHot
+template <typename T>
+int SparseBitLineMaker<T>::makeCountsOneHot(
+    const T *x_in,
+    const int x_inc,
+    int &x_noz,
+    const int d_index,
+    const T d_value,
+    int &d_noz,
+    RNG<T> *rng,
+    const T lr,
+    const T dw_min,
+    const PulsedUpdateMetaParameter<T> &up) {
+
+  T A = 0;
+  T B = 0;
+  int BL = 0;
+
+  if (up.update_bl_management || up.update_management) {
+
+    T x_abs_max = Find_Absolute_Max<T>(x_in, x_size_, x_inc);
+    T d_abs_max = (T)fabsf(d_value);
+
+    up.performUpdateManagement(BL, A, B, up.desired_BL, x_abs_max, d_abs_max, lr, dw_min);
+  } else {
+    up.calculateBlAB(BL, A, B, lr, dw_min);
+  }
+
+  if (BL == 0) {
+    return 0;
+  }
+  if (MAX(BL, up.desired_BL) > max_BL_) {
+    initialize(x_size_, d_size_, MAX(BL, up.desired_BL));
+  }
+
+  switch (up.pulse_type) {
+
+  case PulseType::Stochastic:
+    generateCountsPN<T>(
+        x_counts_p_, x_counts_n_, x_indices_p_, x_indices_n_, x_in, x_inc, x_size_, B, rng, BL,
+        up.res, up.sto_round, x_noz);
+    n_indices_used_ = true;
+    break;
+
+  case PulseType::StochasticCompressed:
+    generateCounts<T>(
+        x_counts_p_, x_indices_p_, x_in, x_inc, x_size_, B, rng, BL, up.res, up.sto_round, x_noz);
+    n_indices_used_ = false;
+    break;
+
+  default:
+    RPU_FATAL("PulseType not supported");
+  }
+
+  // d counts: all other d-lines are zero
+  d_noz += d_size_ - 1;
+  generateCounts<T>(d_counts_, d_indices_, &d_value, 1, 1, A, rng, BL, up.res, up.sto_round, d_noz);
+
+  int d_signed = d_value > (T)0.0 ? d_index + 1 : -(d_index + 1);
+  for (int k = 0; k < BL; k++) {
+    if (d_counts_[k] > 0) {
+      d_indices_[k][0] = d_signed;
+    }
+  }
+
+  return BL;
+}
+
 template <typename T> bool SparseBitLineMaker<T>::supports(RPU::PulseType pulse_type) const {
   return PulseType::StochasticCompressed == pulse_type || PulseType::Stochastic == pulse_type;
 }
@@ -58,6 +58,21 @@ public:
       const T dw_min,
       const PulsedUpdateMetaParameter<T> &up);
 
+  /* same as makeCounts but for a one-hot d vector that is only
+     non-zero (d_value) at d_index. Pulses are only generated for
+     the single active d-line. */
+  int makeCountsOneHot(
+      const T *x_in,
+      const int x_inc,
+      int &x_noz,
+      const int d_index,
+      const T d_value,
+      int &d_noz,
+      RNG<T> *rng,
+      const T lr,
+      const T dw_min,
+      const PulsedUpdateMetaParameter<T> &up);
+
   /* returns whether x_n indices/counts are used*/
   bool getCountsAndIndices(
       int *&x_counts_p,
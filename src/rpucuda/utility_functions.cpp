@@ -11,6 +11,7 @@
  */
 
 #include "utility_functions.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -28,19 +29,202 @@ std::ostream &operator<<(std::ostream &out, const half_t &value) {
 };
 #endif
 
+/*****************************************************/
+/* typed state values */
+
+size_t getStateDTypeSize(StateDType dtype) {
+  switch (dtype) {
+  case StateDType::Float64:
+  case StateDType::Int64:
+  case StateDType::UInt64:
+    return 8;
+  case StateDType::Float32:
+  case StateDType::Int32:
+  case StateDType::UInt32:
+    return 4;
+  case StateDType::Half:
+    return 2;
+  case StateDType::Int8:
+  case StateDType::Bool:
+    return 1;
+  default:
+    RPU_FATAL("Unknown state dtype.");
+  }
+}
+
+namespace detail {
+
+template <typename T> struct StateDTypeOf;
+#define RPU_STATE_DTYPE_OF(T, DTYPE)                                                               \
+  template <> struct StateDTypeOf<T> {                                                             \
+    static constexpr StateDType value = StateDType::DTYPE;                                         \
+  };
+
+RPU_STATE_DTYPE_OF(double, Float64);
+RPU_STATE_DTYPE_OF(float, Float32);
+RPU_STATE_DTYPE_OF(char, Int8);
+RPU_STATE_DTYPE_OF(int8_t, Int8);
+RPU_STATE_DTYPE_OF(int32_t, Int32);
+RPU_STATE_DTYPE_OF(uint32_t, UInt32);
+RPU_STATE_DTYPE_OF(int64_t, Int64);
+RPU_STATE_DTYPE_OF(uint64_t, UInt64);
+RPU_STATE_DTYPE_OF(bool, Bool);
+#ifdef RPU_DEFINE_CUDA_HALF_ARRAY
+RPU_STATE_DTYPE_OF(half_t, Half);
+#endif
+#undef RPU_STATE_DTYPE_OF
+
+template <typename T> inline double toDouble(T value) { return (double)value; }
+#ifdef RPU_DEFINE_CUDA_HALF_ARRAY
+template <> inline double toDouble(half_t value) { return (double)(float)value; }
+#endif
+
+template <typename T_OUT, typename T_IN>
+void convertStateData(T_OUT *out, const char *in, size_t n) {
+  if constexpr (std::is_same<T_OUT, T_IN>::value) {
+    memcpy(out, in, n * sizeof(T_IN));
+  } else {
+    // blobs might not be aligned for T_IN (e.g. in mapped buffers)
+    for (size_t i = 0; i < n; i++) {
+      T_IN v;
+      memcpy(&v, in + i * sizeof(T_IN), sizeof(T_IN));
+      if constexpr (std::is_integral<T_OUT>::value && std::is_integral<T_IN>::value) {
+        out[i] = (T_OUT)v; // exact for e.g. 64 bit states
+      } else {
+        out[i] = (T_OUT)toDouble(v);
+      }
+    }
+  }
+}
+
+template <typename T_OUT> void convertStateData(T_OUT *out, const StateValue &value, size_t n) {
+  const char *in = value.data();
+  switch (value.dtype()) {
+  case StateDType::Float64:
+    return convertStateData<T_OUT, double>(out, in, n);
+  case StateDType::Float32:
+    return convertStateData<T_OUT, float>(out, in, n);
+  case StateDType::Int8:
+    return convertStateData<T_OUT, int8_t>(out, in, n);
+  case StateDType::Int32:
+    return convertStateData<T_OUT, int32_t>(out, in, n);
+  case StateDType::UInt32:
+    return convertStateData<T_OUT, uint32_t>(out, in, n);
+  case StateDType::Int64:
+    return convertStateData<T_OUT, int64_t>(out, in, n);
+  case StateDType::UInt64:
+    return convertStateData<T_OUT, uint64_t>(out, in, n);
+  case StateDType::Bool:
+    return convertStateData<T_OUT, bool>(out, in, n);
+  case StateDType::Half:
+#ifdef RPU_DEFINE_CUDA_HALF_ARRAY
+    return convertStateData<T_OUT, half_t>(out, in, n);
+#else
+    RPU_FATAL("Half precision states are not supported in this build.");
+#endif
+  default:
+    RPU_FATAL("Unknown state dtype.");
+  }
+}
+
+} // namespace detail
+
+StateValue::StateValue(std::vector<double> values) {
+  auto vec = std::make_shared<std::vector<double>>(std::move(values));
+  dtype_ = StateDType::Float64;
+  size_ = vec->size();
+  data_ = (const char *)vec->data();
+  storage_ = std::shared_ptr<const char>(vec, data_); // aliasing: keeps vec alive
+}
+
+template <typename T> StateValue StateValue::copyFrom(const T *values, size_t n) {
+  StateValue out;
+  out.dtype_ = detail::StateDTypeOf<T>::value;
+  out.size_ = n;
+  if (n > 0) {
+    char *buffer = new char[n * sizeof(T)];
+    memcpy(buffer, values, n * sizeof(T));
+    out.storage_ = std::shared_ptr<const char>(buffer, std::default_delete<const char[]>());
+    out.data_ = buffer;
+  }
+  return out;
+}
+
+StateValue StateValue::view(StateDType dtype, const char *data, size_t n) {
+  StateValue out;
+  out.dtype_ = dtype;
+  out.size_ = n;
+  out.data_ = data;
+  return out;
+}
+
+template <typename T> void StateValue::copyTo(T *values, size_t n) const {
+  if (n > size_) {
+    RPU_FATAL("State value has only " << size_ << " elements (" << n << " requested).");
+  }
+  detail::convertStateData<T>(values, *this, n);
+}
+
+std::vector<double> StateValue::toDouble() const {
+  std::vector<double> out(size_);
+  copyTo(out.data(), size_);
+  return out;
+}
+
+#define RPU_STATE_VALUE(T)                                                                         \
+  template StateValue StateValue::copyFrom(const T *, size_t);                                     \
+  template void StateValue::copyTo(T *, size_t) const;
+
+RPU_STATE_VALUE(double);
+RPU_STATE_VALUE(float);
+RPU_STATE_VALUE(char);
+RPU_STATE_VALUE(int8_t);
+RPU_STATE_VALUE(int32_t);
+RPU_STATE_VALUE(uint32_t);
+RPU_STATE_VALUE(int64_t);
+RPU_STATE_VALUE(uint64_t);
+RPU_STATE_VALUE(bool);
+#ifdef RPU_DEFINE_CUDA_HALF_ARRAY
+RPU_STATE_VALUE(half_t);
+#endif
+#undef RPU_STATE_VALUE
+
+/*****************************************************/
+/* state helper functions */
+
+namespace detail {
+template <typename T> inline StateValue toStateValue(const std::vector<T> &value) {
+  return StateValue::copyFrom(value.data(), value.size());
+}
+
+template <> inline StateValue toStateValue(const std::vector<bool> &value) {
+  std::unique_ptr<bool[]> tmp(new bool[value.size()]);
+  std::copy(value.begin(), value.end(), tmp.get());
+  return StateValue::copyFrom(tmp.get(), value.size());
+}
+
+template <typename T> inline void fromStateValue(std::vector<T> &out, const StateValue &value) {
+  out.resize(value.size()); // re-uses the existing memory if possible
+  value.copyTo(out.data());
+}
+
+template <> inline void fromStateValue(std::vector<bool> &out, const StateValue &value) {
+  std::unique_ptr<bool[]> tmp(new bool[value.size()]);
+  value.copyTo(tmp.get());
+  out.assign(tmp.get(), tmp.get() + value.size());
+}
+} // namespace detail
+
 template <typename T_VEC>
 void load(RPU::state_t &state, std::string key, T_VEC &value, bool strict) {
-  std::vector<double> tmp;
-  try {
-    tmp = state.at(key);
-  } catch (const std::out_of_range &oor) {
+  auto it = state.find(key);
+  if (it == state.end()) {
     if (strict) {
       RPU_FATAL("Cannot find the vector key `" << key << "` in state.");
     }
     return; // do nothing
   }
-  T_VEC out(tmp.begin(), tmp.end());
-  value = out;
+  detail::fromStateValue(value, it->second);
 }
 
 #define RPU_LOAD_VECTOR(T) template void load(RPU::state_t &, std::string, std::vector<T> &, bool);
@@ -58,16 +242,14 @@ RPU_LOAD_VECTOR(half_t);
 
 #define RPU_LOAD_SINGLE(T)                                                                         \
   template <> void load(RPU::state_t &state, std::string key, T &value, bool strict) {             \
-    std::vector<double> tmp;                                                                       \
-    try {                                                                                          \
-      tmp = state.at(key);                                                                         \
-    } catch (const std::out_of_range &oor) {                                                       \
+    auto it = state.find(key);                                                                     \
+    if (it == state.end() || it->second.size() == 0) {                                             \
       if (strict) {                                                                                \
         RPU_FATAL("Cannot find the single key `" << key << "` in state.");                         \
       }                                                                                            \
       return;                                                                                      \
     }                                                                                              \
-    value = (T)tmp[0];                                                                             \
+    it->second.copyTo(&value, 1);                                                                  \
   }
 
 RPU_LOAD_SINGLE(float);
@@ -82,8 +264,7 @@ RPU_LOAD_SINGLE(half_t);
 #undef RPU_LOAD_SINGLE
 
 template <typename T_VEC> void insert(RPU::state_t &state, std::string key, const T_VEC &value) {
-  std::vector<double> tmp(value.begin(), value.end());
-  state[key] = tmp;
+  state[key] = detail::toStateValue(value);
 }
 
 #define RPU_INSERT_VECTOR(T)                                                                       \
@@ -102,8 +283,7 @@ RPU_INSERT_VECTOR(half_t);
 
 #define RPU_INSERT_SINGLE(T)                                                                       \
   template <> void insert(RPU::state_t &state, std::string key, const T &value) {                  \
-    std::vector<double> tmp{(double)value};                                                        \
-    state[key] = tmp;                                                                              \
+    state[key] = StateValue::copyFrom(&value, 1);                                                  \
   }
 
 RPU_INSERT_SINGLE(float);
@@ -141,4 +321,156 @@ RPU::state_t selectWithPrefix(const RPU::state_t &extra, std::string prefix) {
   }
   return state;
 }
+
+/*****************************************************/
+/* binary state format */
+
+namespace {
+const char STATE_BINARY_MAGIC[8] = {'R', 'P', 'U', 'S', 'T', 'A', 'T', 'E'};
+const uint32_t STATE_BINARY_VERSION = 1;
+const size_t STATE_BINARY_ALIGN = 64;
+
+struct StateBinaryHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t n_entries;
+  uint64_t total_size;
+};
+
+struct StateBinaryEntry {
+  uint64_t offset; // of the data blob from the buffer start
+  uint64_t size;   // in elements
+  uint32_t key_length;
+  uint8_t dtype;
+  uint8_t reserved[3];
+};
+
+inline size_t alignStateOffset(size_t offset) {
+  return (offset + STATE_BINARY_ALIGN - 1) / STATE_BINARY_ALIGN * STATE_BINARY_ALIGN;
+}
+
+/* sorted keys (for reproducible output), the data offsets and the total size*/
+size_t layoutStateBinary(
+    const RPU::state_t &state, std::vector<std::string> &keys, std::vector<size_t> &offsets) {
+  keys.clear();
+  keys.reserve(state.size());
+  size_t offset = sizeof(StateBinaryHeader) + state.size() * sizeof(StateBinaryEntry);
+  for (const auto &i : state) {
+    keys.push_back(i.first);
+    offset += i.first.size();
+  }
+  std::sort(keys.begin(), keys.end());
+
+  offsets.resize(keys.size());
+  for (size_t k = 0; k < keys.size(); k++) {
+    offset = alignStateOffset(offset);
+    offsets[k] = offset;
+    offset += state.at(keys[k]).nbytes();
+  }
+  return offset;
+}
+} // namespace
+
+size_t getStateBinarySize(const RPU::state_t &state) {
+  std::vector<std::string> keys;
+  std::vector<size_t> offsets;
+  return layoutStateBinary(state, keys, offsets);
+}
+
+void writeStateBinary(const RPU::state_t &state, char *buffer, size_t buffer_size) {
+  std::vector<std::string> keys;
+  std::vector<size_t> offsets;
+  size_t total_size = layoutStateBinary(state, keys, offsets);
+  if (buffer_size < total_size) {
+    RPU_FATAL("Buffer too small for the binary state (" << total_size << " bytes needed).");
+  }
+
+  StateBinaryHeader header;
+  memcpy(header.magic, STATE_BINARY_MAGIC, sizeof(header.magic));
+  header.version = STATE_BINARY_VERSION;
+  header.n_entries = (uint32_t)keys.size();
+  header.total_size = total_size;
+  memcpy(buffer, &header, sizeof(header));
+
+  char *entry_ptr = buffer + sizeof(header);
+  char *key_ptr = entry_ptr + keys.size() * sizeof(StateBinaryEntry);
+
+  for (size_t k = 0; k < keys.size(); k++) {
+    const StateValue &value = state.at(keys[k]);
+
+    StateBinaryEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.offset = offsets[k];
+    entry.size = value.size();
+    entry.key_length = (uint32_t)keys[k].size();
+    entry.dtype = (uint8_t)value.dtype();
+    memcpy(entry_ptr, &entry, sizeof(entry));
+    entry_ptr += sizeof(entry);
+
+    memcpy(key_ptr, keys[k].data(), keys[k].size());
+    key_ptr += keys[k].size();
+  }
+  size_t last = (size_t)(key_ptr - buffer);
+
+  for (size_t k = 0; k < keys.size(); k++) {
+    const StateValue &value = state.at(keys[k]);
+    memset(buffer + last, 0, offsets[k] - last); // padding
+    if (value.nbytes()) {
+      memcpy(buffer + offsets[k], value.data(), value.nbytes());
+    }
+    last = offsets[k] + value.nbytes();
+  }
+}
+
+std::vector<char> dumpStateBinary(const RPU::state_t &state) {
+  std::vector<char> buffer(getStateBinarySize(state));
+  writeStateBinary(state, buffer.data(), buffer.size());
+  return buffer;
+}
+
+RPU::state_t viewStateBinary(const char *buffer, size_t buffer_size) {
+
+  StateBinaryHeader header;
+  if (buffer_size < sizeof(header)) {
+    RPU_FATAL("Binary state buffer too small.");
+  }
+  memcpy(&header, buffer, sizeof(header));
+  if (memcmp(header.magic, STATE_BINARY_MAGIC, sizeof(header.magic)) != 0) {
+    RPU_FATAL("Not a binary RPU state.");
+  }
+  if (header.version != STATE_BINARY_VERSION) {
+    RPU_FATAL("Unsupported binary RPU state version " << header.version << ".");
+  }
+  // all size checks are done as integer comparisons that cannot overflow
+  if (header.total_size > buffer_size || header.total_size < sizeof(header) ||
+      header.n_entries > (header.total_size - sizeof(header)) / sizeof(StateBinaryEntry)) {
+    RPU_FATAL("Binary RPU state is truncated.");
+  }
+  size_t total_size = (size_t)header.total_size;
+
+  RPU::state_t state;
+  size_t entry_offset = sizeof(header);
+  size_t key_offset = entry_offset + (size_t)header.n_entries * sizeof(StateBinaryEntry);
+
+  for (uint32_t k = 0; k < header.n_entries; k++) {
+    StateBinaryEntry entry;
+    memcpy(&entry, buffer + entry_offset, sizeof(entry));
+    entry_offset += sizeof(entry);
+
+    if (entry.dtype > (uint8_t)StateDType::Bool || entry.key_length > total_size - key_offset ||
+        entry.offset > total_size) {
+      RPU_FATAL("Binary RPU state is corrupted.");
+    }
+    auto dtype = (StateDType)entry.dtype;
+    if (entry.size > (total_size - entry.offset) / getStateDTypeSize(dtype)) {
+      RPU_FATAL("Binary RPU state is corrupted.");
+    }
+    std::string key(buffer + key_offset, entry.key_length);
+    key_offset += entry.key_length;
+
+    state[key] = StateValue::view(dtype, buffer + entry.offset, entry.size);
+  }
+  return state;
+}
+
 } // namespace RPU
@@ -11,8 +11,10 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 #include <string.h>
@@ -147,7 +149,60 @@ using num_t = float;
 
 namespace RPU {
 
-using state_t = std::unordered_map<std::string, std::vector<double>>;
+/* Typed state values. Each value is a contiguous blob of a native
+   data type, which is shared (not copied) when the state maps are
+   copied or re-prefixed. Values might also only view an external
+   buffer (see viewStateBinary), in which case the buffer needs to
+   outlive the state. Legacy double vectors are implicitly converted. */
+enum class StateDType : uint8_t {
+  Float64,
+  Float32,
+  Half,
+  Int8,
+  Int32,
+  UInt32,
+  Int64,
+  UInt64,
+  Bool
+};
+
+size_t getStateDTypeSize(StateDType dtype);
+
+class StateValue {
+public:
+  StateValue() = default;
+  StateValue(std::vector<double> values);
+
+  template <typename T> static StateValue copyFrom(const T *values, size_t n);
+  static StateValue view(StateDType dtype, const char *data, size_t n);
+
+  inline StateDType dtype() const { return dtype_; };
+  inline size_t size() const { return size_; };
+  inline size_t nbytes() const { return size_ * getStateDTypeSize(dtype_); };
+  inline const char *data() const { return data_; };
+
+  /* converts (or copies if same dtype) the first n elements into the given memory*/
+  template <typename T> void copyTo(T *values, size_t n) const;
+  template <typename T> inline void copyTo(T *values) const { copyTo(values, size_); };
+  std::vector<double> toDouble() const;
+
+private:
+  StateDType dtype_ = StateDType::Float64;
+  size_t size_ = 0;
+  const char *data_ = nullptr;
+  std::shared_ptr<const char> storage_ = nullptr;
+};
+
+using state_t = std::unordered_map<std::string, StateValue>;
+
+/* Compact binary state format: native dtypes and 64-byte aligned
+   contiguous blobs (native byte order). The buffer can be restored
+   in place with viewStateBinary without copying (e.g. from a
+   memory-mapped file).*/
+size_t getStateBinarySize(const RPU::state_t &state);
+void writeStateBinary(const RPU::state_t &state, char *buffer, size_t buffer_size);
+std::vector<char> dumpStateBinary(const RPU::state_t &state);
+RPU::state_t viewStateBinary(const char *buffer, size_t buffer_size);
 
 #ifdef RPU_DEFINE_CUDA_HALF_ARRAY
 std::ostream &operator<<(std::ostream &out, const half_t &value);
@@ -263,6 +318,35 @@ template <typename T> void Array_3D_Free(T ***arr, size_t n) {
   }
 }
 
+/* Allocator for std::vector with aligned memory (default cache line) */
+template <typename T, size_t alignment = 64> struct AlignedAllocator {
+  using value_type = T;
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, alignment>;
+  };
+
+  AlignedAllocator() noexcept {};
+  template <typename U> AlignedAllocator(const AlignedAllocator<U, alignment> &) noexcept {};
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+  };
+  void deallocate(T *p, size_t n) noexcept {
+    UNUSED(n);
+    ::operator delete(p, std::align_val_t(alignment));
+  };
+
+  template <typename U> bool operator==(const AlignedAllocator<U, alignment> &) const noexcept {
+    return true;
+  };
+  template <typename U> bool operator!=(const AlignedAllocator<U, alignment> &) const noexcept {
+    return false;
+  };
+};
+
+template <typename T, size_t alignment = 64>
+using aligned_vector = std::vector<T, AlignedAllocator<T, alignment>>;
+
 template <typename T> T Find_Absolute_Max(const T *data, int data_length, int inc = 1) {
   T max_input_value = 0;
   for (int i = 0; i < data_length * inc; i += inc) {
@@ -108,6 +108,86 @@ void WeightDrifter<T>::saturate(T *weights, const T *min_bounds, const T *max_bo
   }
 }
 
+/* Applies the drift to the elements i_start <= i < i_end. First
+   detects the resets, then computes the drift scale. Within a block
+   the reset times are typically all identical, in which case the
+   log of the time difference is computed once (and the drift factor,
+   too, if nu is uniform), so that the main loop vectorizes. */
+template <typename T>
+void WeightDrifter<T>::applyBlock(
+    T *weights,
+    const int i_start,
+    const int i_end,
+    const T a,
+    const T *nu_noise,
+    const T *w_noise) {
+
+  const T reset_tol = par_.reset_tol;
+  const T current_t = current_t_;
+
+  PRAGMA_SIMD
+  for (int i = i_start; i < i_end; i++) {
+    // weight has changed and thus need a drift reset
+    bool reset = (T)fabsf(previous_weights_[i] - weights[i]) > reset_tol;
+    t_[i] = reset ? current_t : t_[i];
+    w0_[i] = reset ? weights[i] : w0_[i];
+  }
+
+  const T t_first = t_[i_start];
+  int n_diff = 0;
+  PRAGMA_SIMD
+  for (int i = i_start; i < i_end; i++) {
+    n_diff += t_[i] != t_first ? 1 : 0;
+  }
+
+  // at least t0. Within t0 the scale is exactly one (as for resets)
+  const bool uniform_t = n_diff == 0;
+  const T log_dt_first = (T)logf(MAX(current_t - t_first, (T)1.0));
+  const bool uniform_nu = par_.isSimpleDrift() && nu_noise == nullptr && !par_.nu_k;
+
+  if (uniform_t && uniform_nu) {
+    // drift factor is the same for all elements of the block
+    const T nu_scale = (T)expf(-par_.nu * log_dt_first);
+    const T a_scale = a * (nu_scale - (T)1.0);
+
+    PRAGMA_SIMD
+    for (int i = i_start; i < i_end; i++) {
+      T w = w0_[i] * nu_scale + a_scale;
+      w += w_noise == nullptr ? (T)0.0 : w_noise[i];
+      previous_weights_[i] = w;
+      weights[i] = w;
+    }
+    return;
+  }
+
+  const T nu0 = par_.nu;
+  const T nu_std = par_.nu_std;
+  const T nu_k = par_.nu_k;
+  const T nu_k_offset = par_.nu_k * par_.logG0;
+  const bool simple = par_.isSimpleDrift();
+
+  PRAGMA_SIMD
+  for (int i = i_start; i < i_end; i++) {
+    // this will overwrite the current weight ! make sure that no DECAY/WNOISE is present
+    T delta_t = current_t - t_[i];
+    bool fresh = delta_t <= (T)1.0;
+
+    T nu = simple ? nu0 : nu_[i];
+    nu = nu_noise == nullptr ? nu : nu + nu_std * nu * nu_noise[i];
+    if (nu_k) {
+      T g = (weights[i] - par_.w_offset) / par_.wg_ratio + par_.g_offset;
+      nu = fresh ? nu : nu - nu_k * (T)logf(g) + nu_k_offset;
+    }
+    T log_dt = uniform_t ? log_dt_first : (T)logf(MAX(delta_t, (T)1.0));
+    T nu_scale = fresh ? (T)1.0 : (T)expf(-nu * log_dt);
+
+    T w = w0_[i] * nu_scale + a * (nu_scale - (T)1.0);
+    w += w_noise == nullptr ? (T)0.0 : w_noise[i];
+    previous_weights_[i] = w;
+    weights[i] = w;
+  }
+}
+
 template <typename T>
 void WeightDrifter<T>::apply(T *weights, T time_since_last_call, RNG<T> &rng) {
 
@@ -119,42 +199,32 @@ void WeightDrifter<T>::apply(T *weights, T time_since_last_call, RNG<T> &rng) {
   }
 
   current_t_ += time_since_last_call / par_.t0;
-  T reset_tol = par_.reset_tol;
-  bool simple = par_.isSimpleDrift();
   T a = par_.g_offset * par_.wg_ratio + par_.w_offset;
-  if ((T)fabsf(a) < reset_tol) {
+  if ((T)fabsf(a) < par_.reset_tol) {
     a = (T)0.0;
   }
-  T w_noise_std = par_.w_read_std;
-  T nu_std = par_.nu_std;
-  T nu0 = par_.nu;
 
-  PRAGMA_SIMD
-  for (int i = 0; i < size_; i++) {
-    T w = weights[i];
-    if ((T)fabsf(previous_weights_[i] - w) > reset_tol) {
-      // weight has changed and thus need a drift reset
-      t_[i] = current_t_;
-      w0_[i] = w;
-
-    } else {
-      // this will overwrite the current weight ! make sure that no DECAY/WNOISE is present
-
-      T w0 = w0_[i];
-      T nu = simple ? nu0 : nu_[i];
-      nu = (nu_std <= (T)0.0) ? nu : nu + nu_std * nu * rng.sampleGauss();
-      nu = (!par_.nu_k)
-               ? nu
-               : nu - par_.nu_k * (T)logf((w - par_.w_offset) / par_.wg_ratio + par_.g_offset) +
-                     par_.nu_k * par_.logG0;
-      T delta_t = MAX(current_t_ - t_[i], (T)1.0); // at least t0
-      T nu_scale = (T)powf(delta_t, -nu);
-      w = w0 * nu_scale; // overwrites w
-      w = (!a) ? w : w + a * (nu_scale - (T)1.0);
-    }
-    w += w_noise_std > (T)0.0 ? w_noise_std * rng.sampleGauss() : (T)0.0;
-    previous_weights_[i] = w;
-    weights[i] = w;
+  // bulk Gaussian numbers for the nu c-to-c and the read noise
+  T *nu_noise = nullptr;
+  if (par_.nu_std > (T)0.0) {
+    nu_noise_.resize(size_);
+    rng.fillGauss(nu_noise_.data(), size_);
+    nu_noise = nu_noise_.data();
+  }
+  T *w_noise = nullptr;
+  if (par_.w_read_std > (T)0.0) {
+    w_noise_.resize(size_);
+    rng.fillGauss(w_noise_.data(), size_);
+    RPU::math::scal<T>(size_, par_.w_read_std, w_noise_.data(), 1);
+    w_noise = w_noise_.data();
+  }
+
+  int n_blocks = (size_ + RPU_DRIFT_BLOCK_SIZE - 1) / RPU_DRIFT_BLOCK_SIZE;
+
+#pragma omp parallel for schedule(static) if (n_blocks > 1)
+  for (int i_block = 0; i_block < n_blocks; i_block++) {
+    int i_start = i_block * RPU_DRIFT_BLOCK_SIZE;
+    applyBlock(weights, i_start, MIN(i_start + RPU_DRIFT_BLOCK_SIZE, size_), a, nu_noise, w_noise);
   }
 }
 
@@ -15,6 +15,8 @@
 #include "rng.h"
 #include <memory>
 
+#define RPU_DRIFT_BLOCK_SIZE 8192 // elements per (threaded) block of the drift
+
 namespace RPU {
 
 template <typename T> struct DriftParameter {
@@ -146,6 +148,17 @@ protected:
 
 private:
   void initialize(const T *weights);
+  void applyBlock(
+      T *weights,
+      const int i_start,
+      const int i_end,
+      const T a,
+      const T *nu_noise,
+      const T *w_noise);
+
+  // tmp buffers for the bulk Gaussian numbers
+  std::vector<T> nu_noise_;
+  std::vector<T> w_noise_;
 };
 
 } // namespace RPU
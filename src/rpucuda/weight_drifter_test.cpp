@@ -0,0 +1,143 @@
+/**
+ * (C) Copyright 2020, 2021, 2022, 2023, 2024 IBM. All Rights Reserved.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#include "rng.h"
+#include "utility_functions.h"
+#include "weight_drifter.h"
+#include "gtest/gtest.h"
+#include <memory>
+
+#define TOLERANCE 1e-5
+
+namespace {
+
+using namespace RPU;
+
+/* per-element reference of the drift (without any noise) */
+class ReferenceDrifter {
+public:
+  ReferenceDrifter(
+      const DriftParameter<num_t> &par, const num_t *nu, const num_t *weights, int size)
+      : par_(par), nu_(nu, nu + size), w0_(weights, weights + size),
+        previous_weights_(weights, weights + size), t_(size, (num_t)0.0){};
+
+  void apply(num_t *weights, num_t time_since_last_call) {
+    current_t_ += time_since_last_call / par_.t0;
+    num_t a = par_.g_offset * par_.wg_ratio + par_.w_offset;
+    if ((num_t)fabsf(a) < par_.reset_tol) {
+      a = (num_t)0.0;
+    }
+    for (size_t i = 0; i < nu_.size(); i++) {
+      num_t w = weights[i];
+      if ((num_t)fabsf(previous_weights_[i] - w) > par_.reset_tol) {
+        t_[i] = current_t_;
+        w0_[i] = w;
+      } else {
+        num_t nu = nu_[i];
+        if (par_.nu_k) {
+          nu = nu - par_.nu_k * (num_t)logf((w - par_.w_offset) / par_.wg_ratio + par_.g_offset) +
+               par_.nu_k * par_.logG0;
+        }
+        num_t nu_scale = (num_t)powf(MAX(current_t_ - t_[i], (num_t)1.0), -nu);
+        w = w0_[i] * nu_scale + a * (nu_scale - (num_t)1.0);
+      }
+      previous_weights_[i] = w;
+      weights[i] = w;
+    }
+  };
+
+private:
+  DriftParameter<num_t> par_;
+  std::vector<num_t> nu_, w0_, previous_weights_, t_;
+  num_t current_t_ = 0.0;
+};
+
+class WeightDrifterTestFixture : public ::testing::TestWithParam<bool> {
+public:
+  void SetUp() {
+    // not a multiple of the block size
+    size = 2 * RPU_DRIFT_BLOCK_SIZE + 37;
+    w.resize(size);
+    for (int i = 0; i < size; i++) {
+      w[i] = (num_t)0.8 * rw_rng.sampleUniform() - (num_t)0.4;
+    }
+    w_ref = w;
+    par.nu = 0.1;
+    par.t0 = 2.0;
+  };
+
+  void checkDrift(WeightDrifter<num_t> &wdrifter, const num_t *nu) {
+    ReferenceDrifter ref_drifter(par, nu, w_ref.data(), size);
+    RNG<num_t> rng(0);
+
+    for (int k = 0; k < 6; k++) {
+      if (k == 2) {
+        // some resets within a block (non-uniform reset times)
+        for (int i = 0; i < size; i += 7) {
+          w[i] = w_ref[i] = (num_t)0.1;
+        }
+      }
+      if (k == 4) {
+        // reset of the complete last (partial) block
+        for (int i = 2 * RPU_DRIFT_BLOCK_SIZE; i < size; i++) {
+          w[i] = w_ref[i] = (num_t)-0.2;
+        }
+      }
+      wdrifter.apply(w.data(), 3.0, rng);
+      ref_drifter.apply(w_ref.data(), 3.0);
+
+      for (int i = 0; i < size; i++) {
+        ASSERT_NEAR(w[i], w_ref[i], TOLERANCE) << "iter " << k << ", element " << i;
+      }
+    }
+  };
+
+  int size;
+  std::vector<num_t> w, w_ref;
+  DriftParameter<num_t> par;
+  RealWorldRNG<num_t> rw_rng{42};
+};
+
+// whether to use a non-zero g_offset (affine drift)
+INSTANTIATE_TEST_CASE_P(Offset, WeightDrifterTestFixture, ::testing::Bool());
+
+TEST_P(WeightDrifterTestFixture, BlockedUniformNu) {
+
+  if (GetParam()) {
+    par.g_offset = 0.5;
+  }
+  WeightDrifter<num_t> wdrifter(size, par); // simple drift
+  std::vector<num_t> nu(size, par.nu);
+  checkDrift(wdrifter, nu.data());
+}
+
+TEST_P(WeightDrifterTestFixture, BlockedPerElementNu) {
+
+  par.nu_dtod = 0.2;
+  if (GetParam()) {
+    // nu depends on the conductance
+    par.g_offset = 1.0;
+    par.nu_k = 0.05;
+  }
+  WeightDrifter<num_t> wdrifter(size, par, &rw_rng);
+  std::vector<num_t> nu(size);
+  wdrifter.getNu(nu.data());
+  ASSERT_NE(nu[0], nu[1]);
+  checkDrift(wdrifter, nu.data());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
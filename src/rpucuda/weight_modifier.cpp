@@ -215,6 +215,30 @@ void WeightModifier<T>::apply(
   }
 }
 
+template <typename T>
+bool WeightModifier<T>::isCached(
+    uint64_t weight_generation, const WeightModifierParameter<T> &wmpar) {
+
+  if (wmpar.cache_refresh_every <= 0) {
+    cache_valid_ = false;
+    return false;
+  }
+
+  if (cache_valid_ && weight_generation == cached_generation_ &&
+      wmpar.isSameModification(cached_par_) &&
+      (wmpar.isDeterministic() || cached_calls_ < wmpar.cache_refresh_every)) {
+    cached_calls_++;
+    return true;
+  }
+
+  // (re-)arm the cache. Caller is expected to apply the modification next
+  cache_valid_ = true;
+  cached_generation_ = weight_generation;
+  cached_par_ = wmpar;
+  cached_calls_ = 1;
+  return false;
+}
+
 template <typename T>
 void WeightModifier<T>::dumpExtra(RPU::state_t &extra, const std::string prefix) {
 
@@ -234,6 +258,7 @@ void WeightModifier<T>::loadExtra(
 
   RPU::load(state, "saved_bias", saved_bias_, strict);
   RPU::load(state, "enable_during_test", enable_during_test_, strict);
+  cache_valid_ = false;
 }
 
 template class WeightModifier<float>;
@@ -51,6 +51,11 @@ template <typename T> struct WeightModifierParameter {
 
   T pcm_t0 = 20.0;
 
+  // reuse the modified weights across calls as long as the weights
+  // are not changed (0: always re-modify). Noisy types are re-drawn
+  // at the latest after this many calls
+  int cache_refresh_every = 0;
+
   WeightModifierType type = WeightModifierType::Copy;
   std::vector<T> coeffs = {0.26348 / 25.0, 0.0768, -0.001877 * 25.0};
 
@@ -137,6 +142,9 @@ template <typename T> struct WeightModifierParameter {
     if (enable_during_test) {
       ss << "\t enabled during test." << std::endl;
     }
+    if (cache_refresh_every > 0) {
+      ss << "\t cache_refresh_every:\t" << cache_refresh_every << std::endl;
+    }
 
     ss << std::endl;
   }
@@ -149,6 +157,45 @@ template <typename T> struct WeightModifierParameter {
         type == WeightModifierType::ProgNoise || type == WeightModifierType::DiscretizeAddNormal ||
         (type == WeightModifierType::DoReFa && sto_round));
   };
+
+  /* whether the modification is a pure function of the weights
+     (e.g. no noise drawn), so that it can be cached indefinitely*/
+  inline bool isDeterministic() const {
+    if (pdrop > 0) {
+      return false;
+    }
+    switch (type) {
+    case WeightModifierType::Copy:
+      return true;
+    case WeightModifierType::Discretize:
+    case WeightModifierType::DoReFa:
+      return !sto_round;
+    case WeightModifierType::DiscretizeAddNormal:
+      return !sto_round && std_dev <= (T)0.0;
+    case WeightModifierType::MultNormal:
+    case WeightModifierType::AddNormal:
+    case WeightModifierType::Poly:
+    case WeightModifierType::ProgNoise:
+      return std_dev <= (T)0.0;
+    default:
+      return false;
+    }
+  };
+
+  inline bool isSameModification(const WeightModifierParameter<T> &other) const {
+    return type == other.type && std_dev == other.std_dev &&
+           per_batch_sample == other.per_batch_sample && res == other.res &&
+           sto_round == other.sto_round && dorefa_clip == other.dorefa_clip &&
+           pdrop == other.pdrop && enable_during_test == other.enable_during_test &&
+           copy_last_column == other.copy_last_column &&
+           rel_to_actual_wmax == other.rel_to_actual_wmax && assumed_wmax == other.assumed_wmax &&
+           g_max == other.g_max && pcm_zero_thres == other.pcm_zero_thres &&
+           pcm_t_inference == other.pcm_t_inference &&
+           pcm_prob_at_reset == other.pcm_prob_at_reset &&
+           pcm_prob_at_gmax == other.pcm_prob_at_gmax &&
+           pcm_prob_at_random == other.pcm_prob_at_random && pcm_t0 == other.pcm_t0 &&
+           cache_refresh_every == other.cache_refresh_every && coeffs == other.coeffs;
+  };
 };
 
 template <typename T> class WeightModifier {
@@ -162,6 +209,11 @@ public:
 
   inline bool enableDuringTest() { return enable_during_test_; };
 
+  /* returns true if the last modified weights can be reused for the
+     given weight generation and parameter (see cache_refresh_every).
+     Otherwise the cache is re-armed and apply needs to be called */
+  bool isCached(uint64_t weight_generation, const WeightModifierParameter<T> &wmpar);
+
   void dumpExtra(RPU::state_t &extra, const std::string prefix);
   void loadExtra(const RPU::state_t &extra, const std::string prefix, bool strict);
 
@@ -174,6 +226,11 @@ private:
   std::vector<T> saved_bias_;
   bool enable_during_test_ = false;
   RealWorldRNG<T> rw_rng_{0};
+
+  bool cache_valid_ = false;
+  uint64_t cached_generation_ = 0;
+  int cached_calls_ = 0;
+  WeightModifierParameter<T> cached_par_;
 };
 
 } // namespace RPU
@@ -18,7 +18,7 @@ from numpy import array, std, dot, reshape
 from numpy.random import uniform
 from numpy.testing import assert_array_equal, assert_array_almost_equal
 
-from torch import Tensor, from_numpy
+from torch import Tensor, from_numpy, cat
 from torch.cuda import init
 
 from aihwkit.simulator.rpu_base import tiles
@@ -295,6 +295,62 @@ class FloatingPointTileTest(ParametrizedTestCase):
         ref_weights = init_weights - lr * dot(d_t.T, x_t)
         assert_array_almost_equal(updated_weights, ref_weights)
 
+    def test_forward_tiles(self):
+        """Tests the concurrent forward of several tiles."""
+        if self.use_cuda:
+            raise SkipTest("forward of several tiles is CPU only")
+
+        in_size = 6
+        out_size = 5
+        m_batch = 4
+
+        python_tiles = [self.get_tile(out_size, in_size) for _ in range(3)]
+        x_inputs = [
+            from_numpy(uniform(-0.1, 0.1, size=[m_batch, in_size]).astype("float32"))
+            for _ in python_tiles
+        ]
+        y_list = tiles.forward_tiles([python_tile.tile for python_tile in python_tiles], x_inputs)
+
+        self.assertEqual(len(y_list), len(python_tiles))
+        for python_tile, x_t, y_t in zip(python_tiles, x_inputs, y_list):
+            assert_array_almost_equal(python_tile.tile.forward(x_t).numpy(), y_t.numpy())
+
+    def test_forward_tile_array(self):
+        """Tests the concurrent forward of a logical array of tiles."""
+        if self.use_cuda:
+            raise SkipTest("forward of a tile array is CPU only")
+
+        in_sizes = [6, 4]
+        out_sizes = [5, 3, 2]
+        m_batch = 4
+
+        python_tiles = [
+            [self.get_tile(out_size, in_size) for out_size in out_sizes] for in_size in in_sizes
+        ]
+        x_input = from_numpy(uniform(-0.1, 0.1, size=[m_batch, sum(in_sizes)]).astype("float32"))
+        out_scales = [
+            from_numpy(uniform(0.5, 1.5, size=[out_size]).astype("float32"))
+            for _ in in_sizes
+            for out_size in out_sizes
+        ]
+        y_t = tiles.forward_tile_array(
+            [[python_tile.tile for python_tile in row] for row in python_tiles],
+            x_input,
+            out_scales,
+        )
+
+        y_ref = None
+        for i, (x_t, row) in enumerate(zip(x_input.split(in_sizes, dim=1), python_tiles)):
+            y_row = cat(
+                [
+                    python_tile.tile.forward(x_t.contiguous()) * out_scales[i * len(out_sizes) + j]
+                    for j, python_tile in enumerate(row)
+                ],
+                1,
+            )
+            y_ref = y_row if y_ref is None else y_ref + y_row
+        assert_array_almost_equal(y_ref.numpy(), y_t.numpy())
+
 
 @parametrize_over_tiles([ConstantStep, ConstantStepCuda])
 class AnalogTileTest(ParametrizedTestCase):
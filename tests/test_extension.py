@@ -21,7 +21,10 @@ from aihwkit.simulator.tiles.analog_mvm_irdrop_t import AnalogMVMIRDropT
 from .helpers.testcases import AihwkitTestCase, SKIP_CUDA_TESTS
 
 if EXTENSION_COMPILED:
-    from aihwkit.extension.aihwkit_extension.ops import float_precision_cast
+    from aihwkit.extension.aihwkit_extension.ops import (
+        float_precision_cast,
+        float_precision_matmul,
+    )
 
 
 class FloatPrecisionCastTest(AihwkitTestCase):
@@ -47,6 +50,22 @@ class FloatPrecisionCastTest(AihwkitTestCase):
 
         self.assertTensorAlmostEqual(y.cpu(), y_ref)
 
+    @skipIf(not EXTENSION_COMPILED, "extension not compiled")
+    def test_float_prec_matmul(self) -> None:
+        """Test the fused float precision matmul."""
+        x = randn(300, 50, dtype=float32)
+        weight = randn(20, 50, dtype=float32)
+
+        y = float_precision_matmul(x, weight, 5, 2, False, True)
+        y_ref = float_precision_cast(
+            float_precision_cast(x, 5, 2, False) @ float_precision_cast(weight, 5, 2, False).T,
+            5,
+            2,
+            False,
+        )
+
+        self.assertTensorAlmostEqual(y, y_ref)
+
 
 class TheveninEquivTest(AihwkitTestCase):
     """Tests float precision cast."""
@@ -71,6 +90,24 @@ class TheveninEquivTest(AihwkitTestCase):
         self.assertTensorAlmostEqual(vth_3d, vth_3d_ext)
         self.assertTensorAlmostEqual(rth_3d, rth_3d_ext)
 
+    @skipIf(not EXTENSION_COMPILED, "extension not compiled")
+    def test_thevenin_equiv_current(self) -> None:
+        """Test the fused time-summed thevenin current."""
+
+        weight = randn(20, 10, dtype=float32)
+        x_input = randn(2, 20, dtype=float32)
+        size = 128
+
+        i_out = AnalogMVMIRDropT._thev_equiv_current(
+            x_input, weight, use_extension=False, segments=size, phys_input_size=size
+        )
+        i_out_ext = AnalogMVMIRDropT._thev_equiv_current(
+            x_input, weight, use_extension=True, segments=size, phys_input_size=size
+        )
+
+        self.assertEqual(i_out_ext.shape, (2, 10))
+        self.assertTensorAlmostEqual(i_out, i_out_ext)
+
     @skipIf(SKIP_CUDA_TESTS or not EXTENSION_COMPILED, "not compiled with CUDA support")
     def test_thevenin_equiv_cuda(self) -> None:
         """Test float precision."""
@@ -20,7 +20,7 @@ from tempfile import TemporaryFile
 from numpy import array
 
 # Imports from PyTorch.
-from torch import randn, load, save, manual_seed
+from torch import randn, load, save, manual_seed, no_grad
 from torch.nn.functional import mse_loss
 
 # Imports from aihwkit.
@@ -171,6 +171,42 @@ class MappedLayerLinearTest(ParametrizedTestCase):
         # Make sure that the train model produces the same forward pass
         self.assertTensorAlmostEqual(model(in_vectors), mapped_model(in_vectors), decimal=DECIMAL)
 
+    def test_forward_no_grad(self):
+        """Test the forward of a mapped layer without autograd"""
+        manual_seed(123)
+
+        in_features = 14
+        out_features = 9
+        batch_size = 10
+
+        rpu_config = self.get_rpu_config()
+
+        model = self.get_layer(in_features, out_features, rpu_config=rpu_config)
+        weight, bias = model.get_weights()
+
+        weight = randn(*weight.shape)
+        if self.bias:
+            bias = randn(*bias.shape)
+        model.set_weights(weight, bias)
+
+        rpu_config.mapping.max_input_size = 5
+        rpu_config.mapping.max_output_size = 4
+
+        mapped_model = self.get_mapped_model(model, rpu_config)
+        mapped_model.set_weights(weight, bias)
+
+        in_vectors = randn(*([batch_size, in_features] + self.get_image_size(model)))
+        if self.use_cuda:
+            in_vectors = in_vectors.cuda()
+            mapped_model = mapped_model.cuda()
+
+        model.eval()
+        mapped_model.eval()
+        with no_grad():
+            self.assertTensorAlmostEqual(
+                model(in_vectors), mapped_model(in_vectors), decimal=DECIMAL
+            )
+
     def test_training_after_save(self):
         """Test training after it was saved"""
         manual_seed(123)
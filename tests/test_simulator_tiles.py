@@ -15,6 +15,7 @@
 """Tests for the high level simulator devices functionality."""
 
 from unittest import SkipTest
+from pickle import dumps, loads
 
 from torch import Tensor, zeros, ones, manual_seed
 
@@ -29,6 +30,7 @@ from aihwkit.simulator.parameters.enums import (
 from aihwkit.simulator.configs.configs import PrePostProcessingRPU, FloatingPointRPUConfig
 from aihwkit.simulator.rpu_base import tiles
 from aihwkit.simulator.tiles.analog import AnalogTile
+from aihwkit.simulator.tiles.base import AnalogTileStateNames
 from aihwkit.simulator.tiles.transfer import TransferSimulatorTile
 
 from .helpers.decorators import parametrize_over_tiles
@@ -572,6 +574,55 @@ class TileTest(ParametrizedTestCase):
         with self.assertRaises(RuntimeError):
             analog_tile.tile.load_extra(state, True)
 
+    def test_dump_extra_binary(self) -> None:
+        """Tests whether the binary state matches the dictionary state"""
+
+        rpu_config = self.get_rpu_config()
+        analog_tile = self.get_tile(2, 3, rpu_config=rpu_config, bias=True)
+        if not hasattr(analog_tile.tile, "dump_extra_binary"):
+            raise SkipTest("No binary state")
+
+        state = analog_tile.tile.dump_extra()
+        binary_state = analog_tile.tile.dump_extra_binary()
+        self.assertIsInstance(binary_state, bytes)
+
+        # load from binary and compare the re-dumped state
+        analog_tile.tile.load_extra_binary(binary_state, True)
+        new_state = analog_tile.tile.dump_extra()
+        self.assertEqual(set(state.keys()), set(new_state.keys()))
+        for key, value in state.items():
+            self.assertEqual(len(value), len(new_state[key]))
+            for val, new_val in zip(value, new_state[key]):
+                self.assertAlmostEqual(val, new_val, places=5)
+
+        # also from any other buffer (e.g. memory-mapped)
+        analog_tile.tile.load_extra_binary(memoryview(bytearray(binary_state)), True)
+        with self.assertRaises(RuntimeError):
+            analog_tile.tile.load_extra_binary(binary_state[:10], True)
+
+    def test_pickle_extra_binary(self) -> None:
+        """Tests that the binary extra state is only pickled if requested"""
+
+        rpu_config = self.get_rpu_config()
+        analog_tile = self.get_tile(2, 3, rpu_config=rpu_config, bias=True)
+        if not hasattr(analog_tile.tile, "dump_extra_binary"):
+            raise SkipTest("No binary state")
+
+        # default layout is readable by older versions
+        state = analog_tile.__getstate__()
+        self.assertIn(AnalogTileStateNames.EXTRA, state)
+        self.assertNotIn(AnalogTileStateNames.EXTRA_BINARY, state)
+
+        analog_tile.get_runtime().binary_extra_state = True
+        state = analog_tile.__getstate__()
+        self.assertNotIn(AnalogTileStateNames.EXTRA, state)
+        self.assertIsInstance(state[AnalogTileStateNames.EXTRA_BINARY], bytes)
+
+        extra = analog_tile.tile.dump_extra()
+        new_tile = loads(dumps(analog_tile))
+        new_extra = new_tile.tile.dump_extra()
+        self.assertEqual(set(extra.keys()), set(new_extra.keys()))
+
     def test_replace_rpu_config(self) -> None:
         """Tests whether it is possible to replace the RPUConfig"""
         rpu_config = self.get_rpu_config()